@@ -24,7 +24,7 @@
 //                                            |                       |     |     |         data          |     |
 //                                            +-----------------------+     v     +-----------------------+     v
 
-#include "framework.h"
+#include "platform.h"
 #include "3dsfile.h"
 
 // contructor
@@ -46,15 +46,11 @@ C3dsFile::~C3dsFile()
 // This will open the file and store the whole content into a memmory.
 bool C3dsFile::Open(wchar_t* filename)
 {
-	HANDLE handle;
-	WIN32_FIND_DATA finddata;
 	FILE* pf;
 	errno_t err;
 	long long size;
 
-	handle = FindFirstFile(filename, &finddata);
-	size = (long long)finddata.nFileSizeHigh * ((long long)MAXDWORD + 1) + (long long)finddata.nFileSizeLow;
-	FindClose(handle);
+	if ((size = PlatformGetFileSize(filename)) < 0) return false;
 
 	if ((err = _wfopen_s(&pf, filename, L"rb")) != 0) return false;
 
@@ -74,596 +70,596 @@ bool C3dsFile::Open(wchar_t* filename)
 void C3dsFile::GetChunkName(unsigned short id, wchar_t* str, size_t count)
 {
 	switch(id) {
-	case NULL_CHUNK             : swprintf_s(str, count, L"%s [0x%04X]", L"NULL_CHUNK", id);             break;
-	case ChunkType              : swprintf_s(str, count, L"%s [0x%04X]", L"ChunkType", id);              break;
-	case ChunkUnique            : swprintf_s(str, count, L"%s [0x%04X]", L"ChunkUnique", id);            break;
-	case NotChunk               : swprintf_s(str, count, L"%s [0x%04X]", L"NotChunk", id);               break;
-	case Container              : swprintf_s(str, count, L"%s [0x%04X]", L"Container", id);              break;
-	case IsChunk                : swprintf_s(str, count, L"%s [0x%04X]", L"IsChunk", id);                break;
-	case DUMMY                  : swprintf_s(str, count, L"%s [0x%04X]", L"DUMMY", id);                  break;
-	case POINT_ARRAY_ENTRY      : swprintf_s(str, count, L"%s [0x%04X]", L"POINT_ARRAY_ENTRY", id);      break;
-	case POINT_FLAG_ARRAY_ENTRY : swprintf_s(str, count, L"%s [0x%04X]", L"POINT_FLAG_ARRAY_ENTRY", id); break;
-	case FACE_ARRAY_ENTRY       : swprintf_s(str, count, L"%s [0x%04X]", L"FACE_ARRAY_ENTRY", id);       break;
-	case MSH_MAT_GROUP_ENTRY    : swprintf_s(str, count, L"%s [0x%04X]", L"MSH_MAT_GROUP_ENTRY", id);    break;
-	case TEX_VERTS_ENTRY        : swprintf_s(str, count, L"%s [0x%04X]", L"TEX_VERTS_ENTRY", id);        break;
-	case SMOOTH_GROUP_ENTRY     : swprintf_s(str, count, L"%s [0x%04X]", L"SMOOTH_GROUP_ENTRY", id);     break;
-	case POS_TRACK_TAG_KEY      : swprintf_s(str, count, L"%s [0x%04X]", L"POS_TRACK_TAG_KEY", id);      break;
-	case ROT_TRACK_TAG_KEY      : swprintf_s(str, count, L"%s [0x%04X]", L"ROT_TRACK_TAG_KEY", id);      break;
-	case SCL_TRACK_TAG_KEY      : swprintf_s(str, count, L"%s [0x%04X]", L"SCL_TRACK_TAG_KEY", id);      break;
-	case FOV_TRACK_TAG_KEY      : swprintf_s(str, count, L"%s [0x%04X]", L"FOV_TRACK_TAG_KEY", id);      break;
-	case ROLL_TRACK_TAG_KEY     : swprintf_s(str, count, L"%s [0x%04X]", L"ROLL_TRACK_TAG_KEY", id);     break;
-	case COL_TRACK_TAG_KEY      : swprintf_s(str, count, L"%s [0x%04X]", L"COL_TRACK_TAG_KEY", id);      break;
-	case MORPH_TRACK_TAG_KEY    : swprintf_s(str, count, L"%s [0x%04X]", L"MORPH_TRACK_TAG_KEY", id);    break;
-	case HOT_TRACK_TAG_KEY      : swprintf_s(str, count, L"%s [0x%04X]", L"HOT_TRACK_TAG_KEY", id);      break;
-	case FALL_TRACK_TAG_KEY     : swprintf_s(str, count, L"%s [0x%04X]", L"FALL_TRACK_TAG_KEY", id);     break;
-	case M3DMAGIC               : swprintf_s(str, count, L"%s [0x%04X]", L"M3DMAGIC", id);               break;
-	case SMAGIC                 : swprintf_s(str, count, L"%s [0x%04X]", L"SMAGIC", id);                 break;
-	case LMAGIC                 : swprintf_s(str, count, L"%s [0x%04X]", L"LMAGIC", id);                 break;
-	case MLIBMAGIC              : swprintf_s(str, count, L"%s [0x%04X]", L"MLIBMAGIC", id);              break;
-	case MATMAGIC               : swprintf_s(str, count, L"%s [0x%04X]", L"MATMAGIC", id);               break;
-	case M3D_VERSION            : swprintf_s(str, count, L"%s [0x%04X]", L"M3D_VERSION", id);            break;
-	case M3D_KFVERSION          : swprintf_s(str, count, L"%s [0x%04X]", L"M3D_KFVERSION", id);          break;
-	case MDATA                  : swprintf_s(str, count, L"%s [0x%04X]", L"MDATA", id);                  break;
-	case MESH_VERSION           : swprintf_s(str, count, L"%s [0x%04X]", L"MESH_VERSION", id);           break;
-	case COLOR_F                : swprintf_s(str, count, L"%s [0x%04X]", L"COLOR_F", id);                break;
-	case COLOR_24               : swprintf_s(str, count, L"%s [0x%04X]", L"COLOR_24", id);               break;
-	case LIN_COLOR_24           : swprintf_s(str, count, L"%s [0x%04X]", L"LIN_COLOR_24", id);           break;
-	case LIN_COLOR_F            : swprintf_s(str, count, L"%s [0x%04X]", L"LIN_COLOR_F", id);            break;
-	case INT_PERCENTAGE         : swprintf_s(str, count, L"%s [0x%04X]", L"INT_PERCENTAGE", id);         break;
-	case FLOAT_PERCENTAGE       : swprintf_s(str, count, L"%s [0x%04X]", L"FLOAT_PERCENTAGE", id);       break;
-	case MASTER_SCALE           : swprintf_s(str, count, L"%s [0x%04X]", L"MASTER_SCALE", id);           break;
-	case BIT_MAP                : swprintf_s(str, count, L"%s [0x%04X]", L"BIT_MAP", id);                break;
-	case USE_BIT_MAP            : swprintf_s(str, count, L"%s [0x%04X]", L"USE_BIT_MAP", id);            break;
-	case SOLID_BGND             : swprintf_s(str, count, L"%s [0x%04X]", L"SOLID_BGND", id);             break;
-	case USE_SOLID_BGND         : swprintf_s(str, count, L"%s [0x%04X]", L"USE_SOLID_BGND", id);         break;
-	case V_GRADIENT             : swprintf_s(str, count, L"%s [0x%04X]", L"V_GRADIENT", id);             break;
-	case USE_V_GRADIENT         : swprintf_s(str, count, L"%s [0x%04X]", L"USE_V_GRADIENT", id);         break;
-	case LO_SHADOW_BIAS         : swprintf_s(str, count, L"%s [0x%04X]", L"LO_SHADOW_BIAS", id);         break;
-	case HI_SHADOW_BIAS         : swprintf_s(str, count, L"%s [0x%04X]", L"HI_SHADOW_BIAS", id);         break;
-	case SHADOW_MAP_SIZE        : swprintf_s(str, count, L"%s [0x%04X]", L"SHADOW_MAP_SIZE", id);        break;
-	case SHADOW_SAMPLES         : swprintf_s(str, count, L"%s [0x%04X]", L"SHADOW_SAMPLES", id);         break;
-	case SHADOW_RANGE           : swprintf_s(str, count, L"%s [0x%04X]", L"SHADOW_RANGE", id);           break;
-	case SHADOW_FILTER          : swprintf_s(str, count, L"%s [0x%04X]", L"SHADOW_FILTER", id);          break;
-	case RAY_BIAS               : swprintf_s(str, count, L"%s [0x%04X]", L"RAY_BIAS", id);               break;
-	case O_CONSTS               : swprintf_s(str, count, L"%s [0x%04X]", L"O_CONSTS", id);               break;
-	case AMBIENT_LIGHT          : swprintf_s(str, count, L"%s [0x%04X]", L"AMBIENT_LIGHT", id);          break;
-	case FOG                    : swprintf_s(str, count, L"%s [0x%04X]", L"FOG", id);                    break;
-	case USE_FOG                : swprintf_s(str, count, L"%s [0x%04X]", L"USE_FOG", id);                break;
-	case FOG_BGND               : swprintf_s(str, count, L"%s [0x%04X]", L"FOG_BGND", id);               break;
-	case DISTANCE_CUE           : swprintf_s(str, count, L"%s [0x%04X]", L"DISTANCE_CUE", id);           break;
-	case USE_DISTANCE_CUE       : swprintf_s(str, count, L"%s [0x%04X]", L"USE_DISTANCE_CUE", id);       break;
-	case LAYER_FOG              : swprintf_s(str, count, L"%s [0x%04X]", L"LAYER_FOG", id);              break;
-	case USE_LAYER_FOG          : swprintf_s(str, count, L"%s [0x%04X]", L"USE_LAYER_FOG", id);          break;
-	case DCUE_BGND              : swprintf_s(str, count, L"%s [0x%04X]", L"DCUE_BGND", id);              break;
-	case DEFAULT_VIEW           : swprintf_s(str, count, L"%s [0x%04X]", L"DEFAULT_VIEW", id);           break;
-	case VIEW_TOP               : swprintf_s(str, count, L"%s [0x%04X]", L"VIEW_TOP", id);               break;
-	case VIEW_BOTTOM            : swprintf_s(str, count, L"%s [0x%04X]", L"VIEW_BOTTOM", id);            break;
-	case VIEW_LEFT              : swprintf_s(str, count, L"%s [0x%04X]", L"VIEW_LEFT", id);              break;
-	case VIEW_RIGHT             : swprintf_s(str, count, L"%s [0x%04X]", L"VIEW_RIGHT", id);             break;
-	case VIEW_FRONT             : swprintf_s(str, count, L"%s [0x%04X]", L"VIEW_FRONT", id);             break;
-	case VIEW_BACK              : swprintf_s(str, count, L"%s [0x%04X]", L"VIEW_BACK", id);              break;
-	case VIEW_USER              : swprintf_s(str, count, L"%s [0x%04X]", L"VIEW_USER", id);              break;
-	case VIEW_CAMERA            : swprintf_s(str, count, L"%s [0x%04X]", L"VIEW_CAMERA", id);            break;
-	case VIEW_WINDOW            : swprintf_s(str, count, L"%s [0x%04X]", L"VIEW_WINDOW", id);            break;
-	case NAMED_OBJECT           : swprintf_s(str, count, L"%s [0x%04X]", L"NAMED_OBJECT", id);           break;
-	case OBJ_HIDDEN             : swprintf_s(str, count, L"%s [0x%04X]", L"OBJ_HIDDEN", id);             break;
-	case OBJ_VIS_LOFTER         : swprintf_s(str, count, L"%s [0x%04X]", L"OBJ_VIS_LOFTER", id);         break;
-	case OBJ_DOESNT_CAST        : swprintf_s(str, count, L"%s [0x%04X]", L"OBJ_DOESNT_CAST", id);        break;
-	case OBJ_MATTE              : swprintf_s(str, count, L"%s [0x%04X]", L"OBJ_MATTE", id);              break;
-	case OBJ_FAST               : swprintf_s(str, count, L"%s [0x%04X]", L"OBJ_FAST", id);               break;
-	case OBJ_PROCEDURAL         : swprintf_s(str, count, L"%s [0x%04X]", L"OBJ_PROCEDURAL", id);         break;
-	case OBJ_FROZEN             : swprintf_s(str, count, L"%s [0x%04X]", L"OBJ_FROZEN", id);             break;
-	case OBJ_DONT_RCVSHADOW     : swprintf_s(str, count, L"%s [0x%04X]", L"OBJ_DONT_RCVSHADOW", id);     break;
-	case N_TRI_OBJECT           : swprintf_s(str, count, L"%s [0x%04X]", L"N_TRI_OBJECT", id);           break;
-	case POINT_ARRAY            : swprintf_s(str, count, L"%s [0x%04X]", L"POINT_ARRAY", id);            break;
-	case POINT_FLAG_ARRAY       : swprintf_s(str, count, L"%s [0x%04X]", L"POINT_FLAG_ARRAY", id);       break;
-	case FACE_ARRAY             : swprintf_s(str, count, L"%s [0x%04X]", L"FACE_ARRAY", id);             break;
-	case MSH_MAT_GROUP          : swprintf_s(str, count, L"%s [0x%04X]", L"MSH_MAT_GROUP", id);          break;
-	case OLD_MAT_GROUP          : swprintf_s(str, count, L"%s [0x%04X]", L"OLD_MAT_GROUP", id);          break;
-	case TEX_VERTS              : swprintf_s(str, count, L"%s [0x%04X]", L"TEX_VERTS", id);              break;
-	case SMOOTH_GROUP           : swprintf_s(str, count, L"%s [0x%04X]", L"SMOOTH_GROUP", id);           break;
-	case MESH_MATRIX            : swprintf_s(str, count, L"%s [0x%04X]", L"MESH_MATRIX", id);            break;
-	case MESH_COLOR             : swprintf_s(str, count, L"%s [0x%04X]", L"MESH_COLOR", id);             break;
-	case MESH_TEXTURE_INFO      : swprintf_s(str, count, L"%s [0x%04X]", L"MESH_TEXTURE_INFO", id);      break;
-	case PROC_NAME              : swprintf_s(str, count, L"%s [0x%04X]", L"PROC_NAME", id);              break;
-	case PROC_DATA              : swprintf_s(str, count, L"%s [0x%04X]", L"PROC_DATA", id);              break;
-	case MSH_BOXMAP             : swprintf_s(str, count, L"%s [0x%04X]", L"MSH_BOXMAP", id);             break;
-	case N_D_L_OLD              : swprintf_s(str, count, L"%s [0x%04X]", L"N_D_L_OLD", id);              break;
-	case N_CAM_OLD              : swprintf_s(str, count, L"%s [0x%04X]", L"N_CAM_OLD", id);              break;
-	case N_DIRECT_LIGHT         : swprintf_s(str, count, L"%s [0x%04X]", L"N_DIRECT_LIGHT", id);         break;
-	case DL_SPOTLIGHT           : swprintf_s(str, count, L"%s [0x%04X]", L"DL_SPOTLIGHT", id);           break;
-	case DL_OFF                 : swprintf_s(str, count, L"%s [0x%04X]", L"DL_OFF", id);                 break;
-	case DL_ATTENUATE           : swprintf_s(str, count, L"%s [0x%04X]", L"DL_ATTENUATE", id);           break;
-	case DL_RAYSHAD             : swprintf_s(str, count, L"%s [0x%04X]", L"DL_RAYSHAD", id);             break;
-	case DL_SHADOWED            : swprintf_s(str, count, L"%s [0x%04X]", L"DL_SHADOWED", id);            break;
-	case DL_LOCAL_SHADOW        : swprintf_s(str, count, L"%s [0x%04X]", L"DL_LOCAL_SHADOW", id);        break;
-	case DL_LOCAL_SHADOW2       : swprintf_s(str, count, L"%s [0x%04X]", L"DL_LOCAL_SHADOW2", id);       break;
-	case DL_SEE_CONE            : swprintf_s(str, count, L"%s [0x%04X]", L"DL_SEE_CONE", id);            break;
-	case DL_SPOT_RECTANGULAR    : swprintf_s(str, count, L"%s [0x%04X]", L"DL_SPOT_RECTANGULAR", id);    break;
-	case DL_SPOT_OVERSHOOT      : swprintf_s(str, count, L"%s [0x%04X]", L"DL_SPOT_OVERSHOOT", id);      break;
-	case DL_SPOT_PROJECTOR      : swprintf_s(str, count, L"%s [0x%04X]", L"DL_SPOT_PROJECTOR", id);      break;
-	case DL_EXCLUDE             : swprintf_s(str, count, L"%s [0x%04X]", L"DL_EXCLUDE", id);             break;
-	case DL_RANGE               : swprintf_s(str, count, L"%s [0x%04X]", L"DL_RANGE", id);               break;
-	case DL_SPOT_ROLL           : swprintf_s(str, count, L"%s [0x%04X]", L"DL_SPOT_ROLL", id);           break;
-	case DL_SPOT_ASPECT         : swprintf_s(str, count, L"%s [0x%04X]", L"DL_SPOT_ASPECT", id);         break;
-	case DL_RAY_BIAS            : swprintf_s(str, count, L"%s [0x%04X]", L"DL_RAY_BIAS", id);            break;
-	case DL_INNER_RANGE         : swprintf_s(str, count, L"%s [0x%04X]", L"DL_INNER_RANGE", id);         break;
-	case DL_OUTER_RANGE         : swprintf_s(str, count, L"%s [0x%04X]", L"DL_OUTER_RANGE", id);         break;
-	case DL_MULTIPLIER          : swprintf_s(str, count, L"%s [0x%04X]", L"DL_MULTIPLIER", id);          break;
-	case N_AMBIENT_LIGHT        : swprintf_s(str, count, L"%s [0x%04X]", L"N_AMBIENT_LIGHT", id);        break;
-	case N_CAMERA               : swprintf_s(str, count, L"%s [0x%04X]", L"N_CAMERA", id);               break;
-	case CAM_SEE_CONE           : swprintf_s(str, count, L"%s [0x%04X]", L"CAM_SEE_CONE", id);           break;
-	case CAM_RANGES             : swprintf_s(str, count, L"%s [0x%04X]", L"CAM_RANGES", id);             break;
-	case HIERARCHY              : swprintf_s(str, count, L"%s [0x%04X]", L"HIERARCHY", id);              break;
-	case PARENT_OBJECT          : swprintf_s(str, count, L"%s [0x%04X]", L"PARENT_OBJECT", id);          break;
-	case PIVOT_OBJECT           : swprintf_s(str, count, L"%s [0x%04X]", L"PIVOT_OBJECT", id);           break;
-	case PIVOT_LIMITS           : swprintf_s(str, count, L"%s [0x%04X]", L"PIVOT_LIMITS", id);           break;
-	case PIVOT_ORDER            : swprintf_s(str, count, L"%s [0x%04X]", L"PIVOT_ORDER", id);            break;
-	case XLATE_RANGE            : swprintf_s(str, count, L"%s [0x%04X]", L"XLATE_RANGE", id);            break;
-	case POLY_2D                : swprintf_s(str, count, L"%s [0x%04X]", L"POLY_2D", id);                break;
-	case SHAPE_OK               : swprintf_s(str, count, L"%s [0x%04X]", L"SHAPE_OK", id);               break;
-	case SHAPE_NOT_OK           : swprintf_s(str, count, L"%s [0x%04X]", L"SHAPE_NOT_OK", id);           break;
-	case SHAPE_HOOK             : swprintf_s(str, count, L"%s [0x%04X]", L"SHAPE_HOOK", id);             break;
-	case PATH_3D                : swprintf_s(str, count, L"%s [0x%04X]", L"PATH_3D", id);                break;
-	case PATH_MATRIX            : swprintf_s(str, count, L"%s [0x%04X]", L"PATH_MATRIX", id);            break;
-	case SHAPE_2D               : swprintf_s(str, count, L"%s [0x%04X]", L"SHAPE_2D", id);               break;
-	case M_SCALE                : swprintf_s(str, count, L"%s [0x%04X]", L"M_SCALE", id);                break;
-	case M_TWIST                : swprintf_s(str, count, L"%s [0x%04X]", L"M_TWIST", id);                break;
-	case M_TEETER               : swprintf_s(str, count, L"%s [0x%04X]", L"M_TEETER", id);               break;
-	case M_FIT                  : swprintf_s(str, count, L"%s [0x%04X]", L"M_FIT", id);                  break;
-	case M_BEVEL                : swprintf_s(str, count, L"%s [0x%04X]", L"M_BEVEL", id);                break;
-	case XZ_CURVE               : swprintf_s(str, count, L"%s [0x%04X]", L"XZ_CURVE", id);               break;
-	case YZ_CURVE               : swprintf_s(str, count, L"%s [0x%04X]", L"YZ_CURVE", id);               break;
-	case INTERPCT               : swprintf_s(str, count, L"%s [0x%04X]", L"INTERPCT", id);               break;
-	case DEFORM_LIMIT           : swprintf_s(str, count, L"%s [0x%04X]", L"DEFORM_LIMIT", id);           break;
-	case USE_CONTOUR            : swprintf_s(str, count, L"%s [0x%04X]", L"USE_CONTOUR", id);            break;
-	case USE_TWEEN              : swprintf_s(str, count, L"%s [0x%04X]", L"USE_TWEEN", id);              break;
-	case USE_SCALE              : swprintf_s(str, count, L"%s [0x%04X]", L"USE_SCALE", id);              break;
-	case USE_TWIST              : swprintf_s(str, count, L"%s [0x%04X]", L"USE_TWIST", id);              break;
-	case USE_TEETER             : swprintf_s(str, count, L"%s [0x%04X]", L"USE_TEETER", id);             break;
-	case USE_FIT                : swprintf_s(str, count, L"%s [0x%04X]", L"USE_FIT", id);                break;
-	case USE_BEVEL              : swprintf_s(str, count, L"%s [0x%04X]", L"USE_BEVEL", id);              break;
-	case VIEWPORT_LAYOUT_OLD    : swprintf_s(str, count, L"%s [0x%04X]", L"VIEWPORT_LAYOUT_OLD", id);    break;
-	case VIEWPORT_DATA_OLD      : swprintf_s(str, count, L"%s [0x%04X]", L"VIEWPORT_DATA_OLD", id);      break;
-	case VIEWPORT_LAYOUT        : swprintf_s(str, count, L"%s [0x%04X]", L"VIEWPORT_LAYOUT", id);        break;
-	case VIEWPORT_DATA          : swprintf_s(str, count, L"%s [0x%04X]", L"VIEWPORT_DATA", id);          break;
-	case VIEWPORT_DATA_3        : swprintf_s(str, count, L"%s [0x%04X]", L"VIEWPORT_DATA_3", id);        break;
-	case VIEWPORT_SIZE          : swprintf_s(str, count, L"%s [0x%04X]", L"VIEWPORT_SIZE", id);          break;
-	case NETWORK_VIEW           : swprintf_s(str, count, L"%s [0x%04X]", L"NETWORK_VIEW", id);           break;
-	case XDATA_SECTION          : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_SECTION", id);          break;
-	case XDATA_ENTRY            : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_ENTRY", id);            break;
-	case XDATA_APPNAME          : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_APPNAME", id);          break;
-	case XDATA_STRING           : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_STRING", id);           break;
-	case XDATA_FLOAT            : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_FLOAT", id);            break;
-	case XDATA_DOUBLE           : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_DOUBLE", id);           break;
-	case XDATA_SHORT            : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_SHORT", id);            break;
-	case XDATA_LONG             : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_LONG", id);             break;
-	case XDATA_VOID             : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_VOID", id);             break;
-	case XDATA_GROUP            : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_GROUP", id);            break;
-	case XDATA_RFU6             : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_RFU6", id);             break;
-	case XDATA_RFU5             : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_RFU5", id);             break;
-	case XDATA_RFU4             : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_RFU4", id);             break;
-	case XDATA_RFU3             : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_RFU3", id);             break;
-	case XDATA_RFU2             : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_RFU2", id);             break;
-	case XDATA_RFU1             : swprintf_s(str, count, L"%s [0x%04X]", L"XDATA_RFU1", id);             break;
-	case PARENT_NAME            : swprintf_s(str, count, L"%s [0x%04X]", L"PARENT_NAME", id);            break;
-	case MAT_ENTRY              : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_ENTRY", id);              break;
-	case MAT_NAME               : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_NAME", id);               break;
-	case MAT_AMBIENT            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_AMBIENT", id);            break;
-	case MAT_DIFFUSE            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_DIFFUSE", id);            break;
-	case MAT_SPECULAR           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SPECULAR", id);           break;
-	case MAT_SHININESS          : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SHININESS", id);          break;
-	case MAT_SHIN2PCT           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SHIN2PCT", id);           break;
-	case MAT_SHIN3PCT           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SHIN3PCT", id);           break;
-	case MAT_TRANSPARENCY       : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_TRANSPARENCY", id);       break;
-	case MAT_XPFALL             : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_XPFALL", id);             break;
-	case MAT_REFBLUR            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_REFBLUR", id);            break;
-	case MAT_SELF_ILLUM         : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SELF_ILLUM", id);         break;
-	case MAT_TWO_SIDE           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_TWO_SIDE", id);           break;
-	case MAT_DECAL              : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_DECAL", id);              break;
-	case MAT_ADDITIVE           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_ADDITIVE", id);           break;
-	case MAT_SELF_ILPCT         : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SELF_ILPCT", id);         break;
-	case MAT_WIRE               : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_WIRE", id);               break;
-	case MAT_SUPERSMP           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SUPERSMP", id);           break;
-	case MAT_WIRESIZE           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_WIRESIZE", id);           break;
-	case MAT_FACEMAP            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_FACEMAP", id);            break;
-	case MAT_XPFALLIN           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_XPFALLIN", id);           break;
-	case MAT_PHONGSOFT          : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_PHONGSOFT", id);          break;
-	case MAT_WIREABS            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_WIREABS", id);            break;
-	case MAT_SHADING            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SHADING", id);            break;
-	case MAT_TEXMAP             : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_TEXMAP", id);             break;
-	case MAT_OPACMAP            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_OPACMAP", id);            break;
-	case MAT_REFLMAP            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_REFLMAP", id);            break;
-	case MAT_BUMPMAP            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_BUMPMAP", id);            break;
-	case MAT_SPECMAP            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SPECMAP", id);            break;
-	case MAT_USE_XPFALL         : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_USE_XPFALL", id);         break;
-	case MAT_USE_REFBLUR        : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_USE_REFBLUR", id);        break;
-	case MAT_BUMP_PERCENT       : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_BUMP_PERCENT", id);       break;
-	case MAT_MAPNAME            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAPNAME", id);            break;
-	case MAT_ACUBIC             : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_ACUBIC", id);             break;
-	case MAT_SXP_TEXT_DATA      : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_TEXT_DATA", id);      break;
-	case MAT_SXP_TEXT2_DATA     : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_TEXT2_DATA", id);     break;
-	case MAT_SXP_OPAC_DATA      : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_OPAC_DATA", id);      break;
-	case MAT_SXP_BUMP_DATA      : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_BUMP_DATA", id);      break;
-	case MAT_SXP_SPEC_DATA      : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_SPEC_DATA", id);      break;
-	case MAT_SXP_SHIN_DATA      : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_SHIN_DATA", id);      break;
-	case MAT_SXP_SELFI_DATA     : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_SELFI_DATA", id);     break;
-	case MAT_SXP_TEXT_MASKDATA  : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_TEXT_MASKDATA", id);  break;
-	case MAT_SXP_TEXT2_MASKDATA : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_TEXT2_MASKDATA", id); break;
-	case MAT_SXP_OPAC_MASKDATA  : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_OPAC_MASKDATA", id);  break;
-	case MAT_SXP_BUMP_MASKDATA  : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_BUMP_MASKDATA", id);  break;
-	case MAT_SXP_SPEC_MASKDATA  : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_SPEC_MASKDATA", id);  break;
-	case MAT_SXP_SHIN_MASKDATA  : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_SHIN_MASKDATA", id);  break;
-	case MAT_SXP_SELFI_MASKDATA : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_SELFI_MASKDATA", id); break;
-	case MAT_SXP_REFL_MASKDATA  : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SXP_REFL_MASKDATA", id);  break;
-	case MAT_TEX2MAP            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_TEX2MAP", id);            break;
-	case MAT_SHINMAP            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SHINMAP", id);            break;
-	case MAT_SELFIMAP           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SELFIMAP", id);           break;
-	case MAT_TEXMASK            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_TEXMASK", id);            break;
-	case MAT_TEX2MASK           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_TEX2MASK", id);           break;
-	case MAT_OPACMASK           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_OPACMASK", id);           break;
-	case MAT_BUMPMASK           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_BUMPMASK", id);           break;
-	case MAT_SHINMASK           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SHINMASK", id);           break;
-	case MAT_SPECMASK           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SPECMASK", id);           break;
-	case MAT_SELFIMASK          : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_SELFIMASK", id);          break;
-	case MAT_REFLMASK           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_REFLMASK", id);           break;
-	case MAT_MAP_TILINGOLD      : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_TILINGOLD", id);      break;
-	case MAT_MAP_TILING         : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_TILING", id);         break;
-	case MAT_MAP_TEXBLUR_OLD    : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_TEXBLUR_OLD", id);    break;
-	case MAT_MAP_TEXBLUR        : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_TEXBLUR", id);        break;
-	case MAT_MAP_USCALE         : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_USCALE", id);         break;
-	case MAT_MAP_VSCALE         : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_VSCALE", id);         break;
-	case MAT_MAP_UOFFSET        : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_UOFFSET", id);        break;
-	case MAT_MAP_VOFFSET        : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_VOFFSET", id);        break;
-	case MAT_MAP_ANG            : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_ANG", id);            break;
-	case MAT_MAP_COL1           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_COL1", id);           break;
-	case MAT_MAP_COL2           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_COL2", id);           break;
-	case MAT_MAP_RCOL           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_RCOL", id);           break;
-	case MAT_MAP_GCOL           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_GCOL", id);           break;
-	case MAT_MAP_BCOL           : swprintf_s(str, count, L"%s [0x%04X]", L"MAT_MAP_BCOL", id);           break;
-	case KFDATA                 : swprintf_s(str, count, L"%s [0x%04X]", L"KFDATA", id);                 break;
-	case KFHDR                  : swprintf_s(str, count, L"%s [0x%04X]", L"KFHDR", id);                  break;
-	case AMBIENT_NODE_TAG       : swprintf_s(str, count, L"%s [0x%04X]", L"AMBIENT_NODE_TAG", id);       break;
-	case OBJECT_NODE_TAG        : swprintf_s(str, count, L"%s [0x%04X]", L"OBJECT_NODE_TAG", id);        break;
-	case CAMERA_NODE_TAG        : swprintf_s(str, count, L"%s [0x%04X]", L"CAMERA_NODE_TAG", id);        break;
-	case TARGET_NODE_TAG        : swprintf_s(str, count, L"%s [0x%04X]", L"TARGET_NODE_TAG", id);        break;
-	case LIGHT_NODE_TAG         : swprintf_s(str, count, L"%s [0x%04X]", L"LIGHT_NODE_TAG", id);         break;
-	case L_TARGET_NODE_TAG      : swprintf_s(str, count, L"%s [0x%04X]", L"L_TARGET_NODE_TAG", id);      break;
-	case SPOTLIGHT_NODE_TAG     : swprintf_s(str, count, L"%s [0x%04X]", L"SPOTLIGHT_NODE_TAG", id);     break;
-	case KFSEG                  : swprintf_s(str, count, L"%s [0x%04X]", L"KFSEG", id);                  break;
-	case KFCURTIME              : swprintf_s(str, count, L"%s [0x%04X]", L"KFCURTIME", id);              break;
-	case NODE_HDR               : swprintf_s(str, count, L"%s [0x%04X]", L"NODE_HDR", id);               break;
-	case INSTANCE_NAME          : swprintf_s(str, count, L"%s [0x%04X]", L"INSTANCE_NAME", id);          break;
-	case PRESCALE               : swprintf_s(str, count, L"%s [0x%04X]", L"PRESCALE", id);               break;
-	case PIVOT                  : swprintf_s(str, count, L"%s [0x%04X]", L"PIVOT", id);                  break;
-	case BOUNDBOX               : swprintf_s(str, count, L"%s [0x%04X]", L"BOUNDBOX", id);               break;
-	case MORPH_SMOOTH           : swprintf_s(str, count, L"%s [0x%04X]", L"MORPH_SMOOTH", id);           break;
-	case POS_TRACK_TAG          : swprintf_s(str, count, L"%s [0x%04X]", L"POS_TRACK_TAG", id);          break;
-	case ROT_TRACK_TAG          : swprintf_s(str, count, L"%s [0x%04X]", L"ROT_TRACK_TAG", id);          break;
-	case SCL_TRACK_TAG          : swprintf_s(str, count, L"%s [0x%04X]", L"SCL_TRACK_TAG", id);          break;
-	case FOV_TRACK_TAG          : swprintf_s(str, count, L"%s [0x%04X]", L"FOV_TRACK_TAG", id);          break;
-	case ROLL_TRACK_TAG         : swprintf_s(str, count, L"%s [0x%04X]", L"ROLL_TRACK_TAG", id);         break;
-	case COL_TRACK_TAG          : swprintf_s(str, count, L"%s [0x%04X]", L"COL_TRACK_TAG", id);          break;
-	case MORPH_TRACK_TAG        : swprintf_s(str, count, L"%s [0x%04X]", L"MORPH_TRACK_TAG", id);        break;
-	case HOT_TRACK_TAG          : swprintf_s(str, count, L"%s [0x%04X]", L"HOT_TRACK_TAG", id);          break;
-	case FALL_TRACK_TAG         : swprintf_s(str, count, L"%s [0x%04X]", L"FALL_TRACK_TAG", id);         break;
-	case HIDE_TRACK_TAG         : swprintf_s(str, count, L"%s [0x%04X]", L"HIDE_TRACK_TAG", id);         break;
-	case NODE_ID                : swprintf_s(str, count, L"%s [0x%04X]", L"NODE_ID", id);                break;
-	case CMAGIC                 : swprintf_s(str, count, L"%s [0x%04X]", L"CMAGIC", id);                 break;
-	case C_MDRAWER              : swprintf_s(str, count, L"%s [0x%04X]", L"C_MDRAWER", id);              break;
-	case C_TDRAWER              : swprintf_s(str, count, L"%s [0x%04X]", L"C_TDRAWER", id);              break;
-	case C_SHPDRAWER            : swprintf_s(str, count, L"%s [0x%04X]", L"C_SHPDRAWER", id);            break;
-	case C_MODDRAWER            : swprintf_s(str, count, L"%s [0x%04X]", L"C_MODDRAWER", id);            break;
-	case C_RIPDRAWER            : swprintf_s(str, count, L"%s [0x%04X]", L"C_RIPDRAWER", id);            break;
-	case C_TXDRAWER             : swprintf_s(str, count, L"%s [0x%04X]", L"C_TXDRAWER", id);             break;
-	case C_PDRAWER              : swprintf_s(str, count, L"%s [0x%04X]", L"C_PDRAWER", id);              break;
-	case C_MTLDRAWER            : swprintf_s(str, count, L"%s [0x%04X]", L"C_MTLDRAWER", id);            break;
-	case C_FLIDRAWER            : swprintf_s(str, count, L"%s [0x%04X]", L"C_FLIDRAWER", id);            break;
-	case C_CUBDRAWER            : swprintf_s(str, count, L"%s [0x%04X]", L"C_CUBDRAWER", id);            break;
-	case C_MFILE                : swprintf_s(str, count, L"%s [0x%04X]", L"C_MFILE", id);                break;
-	case C_SHPFILE              : swprintf_s(str, count, L"%s [0x%04X]", L"C_SHPFILE", id);              break;
-	case C_MODFILE              : swprintf_s(str, count, L"%s [0x%04X]", L"C_MODFILE", id);              break;
-	case C_RIPFILE              : swprintf_s(str, count, L"%s [0x%04X]", L"C_RIPFILE", id);              break;
-	case C_TXFILE               : swprintf_s(str, count, L"%s [0x%04X]", L"C_TXFILE", id);               break;
-	case C_PFILE                : swprintf_s(str, count, L"%s [0x%04X]", L"C_PFILE", id);                break;
-	case C_MTLFILE              : swprintf_s(str, count, L"%s [0x%04X]", L"C_MTLFILE", id);              break;
-	case C_FLIFILE              : swprintf_s(str, count, L"%s [0x%04X]", L"C_FLIFILE", id);              break;
-	case C_PALFILE              : swprintf_s(str, count, L"%s [0x%04X]", L"C_PALFILE", id);              break;
-	case C_TX_STRING            : swprintf_s(str, count, L"%s [0x%04X]", L"C_TX_STRING", id);            break;
-	case C_CONSTS               : swprintf_s(str, count, L"%s [0x%04X]", L"C_CONSTS", id);               break;
-	case C_SNAPS                : swprintf_s(str, count, L"%s [0x%04X]", L"C_SNAPS", id);                break;
-	case C_GRIDS                : swprintf_s(str, count, L"%s [0x%04X]", L"C_GRIDS", id);                break;
-	case C_ASNAPS               : swprintf_s(str, count, L"%s [0x%04X]", L"C_ASNAPS", id);               break;
-	case C_GRID_RANGE           : swprintf_s(str, count, L"%s [0x%04X]", L"C_GRID_RANGE", id);           break;
-	case C_RENDTYPE             : swprintf_s(str, count, L"%s [0x%04X]", L"C_RENDTYPE", id);             break;
-	case C_PROGMODE             : swprintf_s(str, count, L"%s [0x%04X]", L"C_PROGMODE", id);             break;
-	case C_PREVMODE             : swprintf_s(str, count, L"%s [0x%04X]", L"C_PREVMODE", id);             break;
-	case C_MODWMODE             : swprintf_s(str, count, L"%s [0x%04X]", L"C_MODWMODE", id);             break;
-	case C_MODMODEL             : swprintf_s(str, count, L"%s [0x%04X]", L"C_MODMODEL", id);             break;
-	case C_ALL_LINES            : swprintf_s(str, count, L"%s [0x%04X]", L"C_ALL_LINES", id);            break;
-	case C_BACK_TYPE            : swprintf_s(str, count, L"%s [0x%04X]", L"C_BACK_TYPE", id);            break;
-	case C_MD_CS                : swprintf_s(str, count, L"%s [0x%04X]", L"C_MD_CS", id);                break;
-	case C_MD_CE                : swprintf_s(str, count, L"%s [0x%04X]", L"C_MD_CE", id);                break;
-	case C_MD_SML               : swprintf_s(str, count, L"%s [0x%04X]", L"C_MD_SML", id);               break;
-	case C_MD_SMW               : swprintf_s(str, count, L"%s [0x%04X]", L"C_MD_SMW", id);               break;
-	case C_LOFT_WITH_TEXTURE    : swprintf_s(str, count, L"%s [0x%04X]", L"C_LOFT_WITH_TEXTURE", id);    break;
-	case C_LOFT_L_REPEAT        : swprintf_s(str, count, L"%s [0x%04X]", L"C_LOFT_L_REPEAT", id);        break;
-	case C_LOFT_W_REPEAT        : swprintf_s(str, count, L"%s [0x%04X]", L"C_LOFT_W_REPEAT", id);        break;
-	case C_LOFT_UV_NORMALIZE    : swprintf_s(str, count, L"%s [0x%04X]", L"C_LOFT_UV_NORMALIZE", id);    break;
-	case C_WELD_LOFT            : swprintf_s(str, count, L"%s [0x%04X]", L"C_WELD_LOFT", id);            break;
-	case C_MD_PDET              : swprintf_s(str, count, L"%s [0x%04X]", L"C_MD_PDET", id);              break;
-	case C_MD_SDET              : swprintf_s(str, count, L"%s [0x%04X]", L"C_MD_SDET", id);              break;
-	case C_RGB_RMODE            : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_RMODE", id);            break;
-	case C_RGB_HIDE             : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_HIDE", id);             break;
-	case C_RGB_MAPSW            : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_MAPSW", id);            break;
-	case C_RGB_TWOSIDE          : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_TWOSIDE", id);          break;
-	case C_RGB_SHADOW           : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_SHADOW", id);           break;
-	case C_RGB_AA               : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_AA", id);               break;
-	case C_RGB_OVW              : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_OVW", id);              break;
-	case C_RGB_OVH              : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_OVH", id);              break;
-	case C_RGB_PICTYPE          : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_PICTYPE", id);          break;
-	case C_RGB_OUTPUT           : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_OUTPUT", id);           break;
-	case C_RGB_TODISK           : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_TODISK", id);           break;
-	case C_RGB_COMPRESS         : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_COMPRESS", id);         break;
-	case C_JPEG_COMPRESSION     : swprintf_s(str, count, L"%s [0x%04X]", L"C_JPEG_COMPRESSION", id);     break;
-	case C_RGB_DISPDEV          : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_DISPDEV", id);          break;
-	case C_RGB_HARDDEV          : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_HARDDEV", id);          break;
-	case C_RGB_PATH             : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_PATH", id);             break;
-	case C_BITMAP_DRAWER        : swprintf_s(str, count, L"%s [0x%04X]", L"C_BITMAP_DRAWER", id);        break;
-	case C_RGB_FILE             : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_FILE", id);             break;
-	case C_RGB_OVASPECT         : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_OVASPECT", id);         break;
-	case C_RGB_ANIMTYPE         : swprintf_s(str, count, L"%s [0x%04X]", L"C_RGB_ANIMTYPE", id);         break;
-	case C_RENDER_ALL           : swprintf_s(str, count, L"%s [0x%04X]", L"C_RENDER_ALL", id);           break;
-	case C_REND_FROM            : swprintf_s(str, count, L"%s [0x%04X]", L"C_REND_FROM", id);            break;
-	case C_REND_TO              : swprintf_s(str, count, L"%s [0x%04X]", L"C_REND_TO", id);              break;
-	case C_REND_NTH             : swprintf_s(str, count, L"%s [0x%04X]", L"C_REND_NTH", id);             break;
-	case C_PAL_TYPE             : swprintf_s(str, count, L"%s [0x%04X]", L"C_PAL_TYPE", id);             break;
-	case C_RND_TURBO            : swprintf_s(str, count, L"%s [0x%04X]", L"C_RND_TURBO", id);            break;
-	case C_RND_MIP              : swprintf_s(str, count, L"%s [0x%04X]", L"C_RND_MIP", id);              break;
-	case C_BGND_METHOD          : swprintf_s(str, count, L"%s [0x%04X]", L"C_BGND_METHOD", id);          break;
-	case C_AUTO_REFLECT         : swprintf_s(str, count, L"%s [0x%04X]", L"C_AUTO_REFLECT", id);         break;
-	case C_VP_FROM              : swprintf_s(str, count, L"%s [0x%04X]", L"C_VP_FROM", id);              break;
-	case C_VP_TO                : swprintf_s(str, count, L"%s [0x%04X]", L"C_VP_TO", id);                break;
-	case C_VP_NTH               : swprintf_s(str, count, L"%s [0x%04X]", L"C_VP_NTH", id);               break;
-	case C_REND_TSTEP           : swprintf_s(str, count, L"%s [0x%04X]", L"C_REND_TSTEP", id);           break;
-	case C_VP_TSTEP             : swprintf_s(str, count, L"%s [0x%04X]", L"C_VP_TSTEP", id);             break;
-	case C_SRDIAM               : swprintf_s(str, count, L"%s [0x%04X]", L"C_SRDIAM", id);               break;
-	case C_SRDEG                : swprintf_s(str, count, L"%s [0x%04X]", L"C_SRDEG", id);                break;
-	case C_SRSEG                : swprintf_s(str, count, L"%s [0x%04X]", L"C_SRSEG", id);                break;
-	case C_SRDIR                : swprintf_s(str, count, L"%s [0x%04X]", L"C_SRDIR", id);                break;
-	case C_HETOP                : swprintf_s(str, count, L"%s [0x%04X]", L"C_HETOP", id);                break;
-	case C_HEBOT                : swprintf_s(str, count, L"%s [0x%04X]", L"C_HEBOT", id);                break;
-	case C_HEHT                 : swprintf_s(str, count, L"%s [0x%04X]", L"C_HEHT", id);                 break;
-	case C_HETURNS              : swprintf_s(str, count, L"%s [0x%04X]", L"C_HETURNS", id);              break;
-	case C_HEDEG                : swprintf_s(str, count, L"%s [0x%04X]", L"C_HEDEG", id);                break;
-	case C_HESEG                : swprintf_s(str, count, L"%s [0x%04X]", L"C_HESEG", id);                break;
-	case C_HEDIR                : swprintf_s(str, count, L"%s [0x%04X]", L"C_HEDIR", id);                break;
-	case C_QUIKSTUFF            : swprintf_s(str, count, L"%s [0x%04X]", L"C_QUIKSTUFF", id);            break;
-	case C_SEE_LIGHTS           : swprintf_s(str, count, L"%s [0x%04X]", L"C_SEE_LIGHTS", id);           break;
-	case C_SEE_CAMERAS          : swprintf_s(str, count, L"%s [0x%04X]", L"C_SEE_CAMERAS", id);          break;
-	case C_SEE_3D               : swprintf_s(str, count, L"%s [0x%04X]", L"C_SEE_3D", id);               break;
-	case C_MESHSEL              : swprintf_s(str, count, L"%s [0x%04X]", L"C_MESHSEL", id);              break;
-	case C_MESHUNSEL            : swprintf_s(str, count, L"%s [0x%04X]", L"C_MESHUNSEL", id);            break;
-	case C_POLYSEL              : swprintf_s(str, count, L"%s [0x%04X]", L"C_POLYSEL", id);              break;
-	case C_POLYUNSEL            : swprintf_s(str, count, L"%s [0x%04X]", L"C_POLYUNSEL", id);            break;
-	case C_SHPLOCAL             : swprintf_s(str, count, L"%s [0x%04X]", L"C_SHPLOCAL", id);             break;
-	case C_MSHLOCAL             : swprintf_s(str, count, L"%s [0x%04X]", L"C_MSHLOCAL", id);             break;
-	case C_NUM_FORMAT           : swprintf_s(str, count, L"%s [0x%04X]", L"C_NUM_FORMAT", id);           break;
-	case C_ARCH_DENOM           : swprintf_s(str, count, L"%s [0x%04X]", L"C_ARCH_DENOM", id);           break;
-	case C_IN_DEVICE            : swprintf_s(str, count, L"%s [0x%04X]", L"C_IN_DEVICE", id);            break;
-	case C_MSCALE               : swprintf_s(str, count, L"%s [0x%04X]", L"C_MSCALE", id);               break;
-	case C_COMM_PORT            : swprintf_s(str, count, L"%s [0x%04X]", L"C_COMM_PORT", id);            break;
-	case C_TAB_BASES            : swprintf_s(str, count, L"%s [0x%04X]", L"C_TAB_BASES", id);            break;
-	case C_TAB_DIVS             : swprintf_s(str, count, L"%s [0x%04X]", L"C_TAB_DIVS", id);             break;
-	case C_MASTER_SCALES        : swprintf_s(str, count, L"%s [0x%04X]", L"C_MASTER_SCALES", id);        break;
-	case C_SHOW_1STVERT         : swprintf_s(str, count, L"%s [0x%04X]", L"C_SHOW_1STVERT", id);         break;
-	case C_SHAPER_OK            : swprintf_s(str, count, L"%s [0x%04X]", L"C_SHAPER_OK", id);            break;
-	case C_LOFTER_OK            : swprintf_s(str, count, L"%s [0x%04X]", L"C_LOFTER_OK", id);            break;
-	case C_EDITOR_OK            : swprintf_s(str, count, L"%s [0x%04X]", L"C_EDITOR_OK", id);            break;
-	case C_KEYFRAMER_OK         : swprintf_s(str, count, L"%s [0x%04X]", L"C_KEYFRAMER_OK", id);         break;
-	case C_PICKSIZE             : swprintf_s(str, count, L"%s [0x%04X]", L"C_PICKSIZE", id);             break;
-	case C_MAPTYPE              : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPTYPE", id);              break;
-	case C_MAP_DISPLAY          : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAP_DISPLAY", id);          break;
-	case C_TILE_XY              : swprintf_s(str, count, L"%s [0x%04X]", L"C_TILE_XY", id);              break;
-	case C_MAP_XYZ              : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAP_XYZ", id);              break;
-	case C_MAP_SCALE            : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAP_SCALE", id);            break;
-	case C_MAP_MATRIX_OLD       : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAP_MATRIX_OLD", id);       break;
-	case C_MAP_MATRIX           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAP_MATRIX", id);           break;
-	case C_MAP_WID_HT           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAP_WID_HT", id);           break;
-	case C_OBNAME               : swprintf_s(str, count, L"%s [0x%04X]", L"C_OBNAME", id);               break;
-	case C_CAMNAME              : swprintf_s(str, count, L"%s [0x%04X]", L"C_CAMNAME", id);              break;
-	case C_LTNAME               : swprintf_s(str, count, L"%s [0x%04X]", L"C_LTNAME", id);               break;
-	case C_CUR_MNAME            : swprintf_s(str, count, L"%s [0x%04X]", L"C_CUR_MNAME", id);            break;
-	case C_CURMTL_FROM_MESH     : swprintf_s(str, count, L"%s [0x%04X]", L"C_CURMTL_FROM_MESH", id);     break;
-	case C_GET_SHAPE_MAKE_FACES : swprintf_s(str, count, L"%s [0x%04X]", L"C_GET_SHAPE_MAKE_FACES", id); break;
-	case C_DETAIL               : swprintf_s(str, count, L"%s [0x%04X]", L"C_DETAIL", id);               break;
-	case C_VERTMARK             : swprintf_s(str, count, L"%s [0x%04X]", L"C_VERTMARK", id);             break;
-	case C_MSHAX                : swprintf_s(str, count, L"%s [0x%04X]", L"C_MSHAX", id);                break;
-	case C_MSHCP                : swprintf_s(str, count, L"%s [0x%04X]", L"C_MSHCP", id);                break;
-	case C_USERAX               : swprintf_s(str, count, L"%s [0x%04X]", L"C_USERAX", id);               break;
-	case C_SHOOK                : swprintf_s(str, count, L"%s [0x%04X]", L"C_SHOOK", id);                break;
-	case C_RAX                  : swprintf_s(str, count, L"%s [0x%04X]", L"C_RAX", id);                  break;
-	case C_STAPE                : swprintf_s(str, count, L"%s [0x%04X]", L"C_STAPE", id);                break;
-	case C_LTAPE                : swprintf_s(str, count, L"%s [0x%04X]", L"C_LTAPE", id);                break;
-	case C_ETAPE                : swprintf_s(str, count, L"%s [0x%04X]", L"C_ETAPE", id);                break;
-	case C_KTAPE                : swprintf_s(str, count, L"%s [0x%04X]", L"C_KTAPE", id);                break;
-	case C_SPHSEGS              : swprintf_s(str, count, L"%s [0x%04X]", L"C_SPHSEGS", id);              break;
-	case C_GEOSMOOTH            : swprintf_s(str, count, L"%s [0x%04X]", L"C_GEOSMOOTH", id);            break;
-	case C_HEMISEGS             : swprintf_s(str, count, L"%s [0x%04X]", L"C_HEMISEGS", id);             break;
-	case C_PRISMSEGS            : swprintf_s(str, count, L"%s [0x%04X]", L"C_PRISMSEGS", id);            break;
-	case C_PRISMSIDES           : swprintf_s(str, count, L"%s [0x%04X]", L"C_PRISMSIDES", id);           break;
-	case C_TUBESEGS             : swprintf_s(str, count, L"%s [0x%04X]", L"C_TUBESEGS", id);             break;
-	case C_TUBESIDES            : swprintf_s(str, count, L"%s [0x%04X]", L"C_TUBESIDES", id);            break;
-	case C_TORSEGS              : swprintf_s(str, count, L"%s [0x%04X]", L"C_TORSEGS", id);              break;
-	case C_TORSIDES             : swprintf_s(str, count, L"%s [0x%04X]", L"C_TORSIDES", id);             break;
-	case C_CONESIDES            : swprintf_s(str, count, L"%s [0x%04X]", L"C_CONESIDES", id);            break;
-	case C_CONESEGS             : swprintf_s(str, count, L"%s [0x%04X]", L"C_CONESEGS", id);             break;
-	case C_NGPARMS              : swprintf_s(str, count, L"%s [0x%04X]", L"C_NGPARMS", id);              break;
-	case C_PTHLEVEL             : swprintf_s(str, count, L"%s [0x%04X]", L"C_PTHLEVEL", id);             break;
-	case C_MSCSYM               : swprintf_s(str, count, L"%s [0x%04X]", L"C_MSCSYM", id);               break;
-	case C_MFTSYM               : swprintf_s(str, count, L"%s [0x%04X]", L"C_MFTSYM", id);               break;
-	case C_MTTSYM               : swprintf_s(str, count, L"%s [0x%04X]", L"C_MTTSYM", id);               break;
-	case C_SMOOTHING            : swprintf_s(str, count, L"%s [0x%04X]", L"C_SMOOTHING", id);            break;
-	case C_MODICOUNT            : swprintf_s(str, count, L"%s [0x%04X]", L"C_MODICOUNT", id);            break;
-	case C_FONTSEL              : swprintf_s(str, count, L"%s [0x%04X]", L"C_FONTSEL", id);              break;
-	case C_TESS_TYPE            : swprintf_s(str, count, L"%s [0x%04X]", L"C_TESS_TYPE", id);            break;
-	case C_TESS_TENSION         : swprintf_s(str, count, L"%s [0x%04X]", L"C_TESS_TENSION", id);         break;
-	case C_SEG_START            : swprintf_s(str, count, L"%s [0x%04X]", L"C_SEG_START", id);            break;
-	case C_SEG_END              : swprintf_s(str, count, L"%s [0x%04X]", L"C_SEG_END", id);              break;
-	case C_CURTIME              : swprintf_s(str, count, L"%s [0x%04X]", L"C_CURTIME", id);              break;
-	case C_ANIMLENGTH           : swprintf_s(str, count, L"%s [0x%04X]", L"C_ANIMLENGTH", id);           break;
-	case C_PV_FROM              : swprintf_s(str, count, L"%s [0x%04X]", L"C_PV_FROM", id);              break;
-	case C_PV_TO                : swprintf_s(str, count, L"%s [0x%04X]", L"C_PV_TO", id);                break;
-	case C_PV_DOFNUM            : swprintf_s(str, count, L"%s [0x%04X]", L"C_PV_DOFNUM", id);            break;
-	case C_PV_RNG               : swprintf_s(str, count, L"%s [0x%04X]", L"C_PV_RNG", id);               break;
-	case C_PV_NTH               : swprintf_s(str, count, L"%s [0x%04X]", L"C_PV_NTH", id);               break;
-	case C_PV_TYPE              : swprintf_s(str, count, L"%s [0x%04X]", L"C_PV_TYPE", id);              break;
-	case C_PV_METHOD            : swprintf_s(str, count, L"%s [0x%04X]", L"C_PV_METHOD", id);            break;
-	case C_PV_FPS               : swprintf_s(str, count, L"%s [0x%04X]", L"C_PV_FPS", id);               break;
-	case C_VTR_FRAMES           : swprintf_s(str, count, L"%s [0x%04X]", L"C_VTR_FRAMES", id);           break;
-	case C_VTR_HDTL             : swprintf_s(str, count, L"%s [0x%04X]", L"C_VTR_HDTL", id);             break;
-	case C_VTR_HD               : swprintf_s(str, count, L"%s [0x%04X]", L"C_VTR_HD", id);               break;
-	case C_VTR_TL               : swprintf_s(str, count, L"%s [0x%04X]", L"C_VTR_TL", id);               break;
-	case C_VTR_IN               : swprintf_s(str, count, L"%s [0x%04X]", L"C_VTR_IN", id);               break;
-	case C_VTR_PK               : swprintf_s(str, count, L"%s [0x%04X]", L"C_VTR_PK", id);               break;
-	case C_VTR_SH               : swprintf_s(str, count, L"%s [0x%04X]", L"C_VTR_SH", id);               break;
-	case C_WORK_MTLS            : swprintf_s(str, count, L"%s [0x%04X]", L"C_WORK_MTLS", id);            break;
-	case C_WORK_MTLS_2          : swprintf_s(str, count, L"%s [0x%04X]", L"C_WORK_MTLS_2", id);          break;
-	case C_WORK_MTLS_3          : swprintf_s(str, count, L"%s [0x%04X]", L"C_WORK_MTLS_3", id);          break;
-	case C_WORK_MTLS_4          : swprintf_s(str, count, L"%s [0x%04X]", L"C_WORK_MTLS_4", id);          break;
-	case C_WORK_MTLS_5          : swprintf_s(str, count, L"%s [0x%04X]", L"C_WORK_MTLS_5", id);          break;
-	case C_WORK_MTLS_6          : swprintf_s(str, count, L"%s [0x%04X]", L"C_WORK_MTLS_6", id);          break;
-	case C_WORK_MTLS_7          : swprintf_s(str, count, L"%s [0x%04X]", L"C_WORK_MTLS_7", id);          break;
-	case C_WORK_MTLS_8          : swprintf_s(str, count, L"%s [0x%04X]", L"C_WORK_MTLS_8", id);          break;
-	case C_WORKMTL              : swprintf_s(str, count, L"%s [0x%04X]", L"C_WORKMTL", id);              break;
-	case C_SXP_TEXT_DATA        : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_TEXT_DATA", id);        break;
-	case C_SXP_TEXT2_DATA       : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_TEXT2_DATA", id);       break;
-	case C_SXP_OPAC_DATA        : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_OPAC_DATA", id);        break;
-	case C_SXP_BUMP_DATA        : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_BUMP_DATA", id);        break;
-	case C_SXP_SPEC_DATA        : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_SPEC_DATA", id);        break;
-	case C_SXP_SHIN_DATA        : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_SHIN_DATA", id);        break;
-	case C_SXP_SELFI_DATA       : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_SELFI_DATA", id);       break;
-	case C_SXP_TEXT_MASKDATA    : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_TEXT_MASKDATA", id);    break;
-	case C_SXP_TEXT2_MASKDATA   : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_TEXT2_MASKDATA", id);   break;
-	case C_SXP_OPAC_MASKDATA    : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_OPAC_MASKDATA", id);    break;
-	case C_SXP_BUMP_MASKDATA    : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_BUMP_MASKDATA", id);    break;
-	case C_SXP_SPEC_MASKDATA    : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_SPEC_MASKDATA", id);    break;
-	case C_SXP_SHIN_MASKDATA    : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_SHIN_MASKDATA", id);    break;
-	case C_SXP_SELFI_MASKDATA   : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_SELFI_MASKDATA", id);   break;
-	case C_SXP_REFL_MASKDATA    : swprintf_s(str, count, L"%s [0x%04X]", L"C_SXP_REFL_MASKDATA", id);    break;
-	case C_BGTYPE               : swprintf_s(str, count, L"%s [0x%04X]", L"C_BGTYPE", id);               break;
-	case C_MEDTILE              : swprintf_s(str, count, L"%s [0x%04X]", L"C_MEDTILE", id);              break;
-	case C_LO_CONTRAST          : swprintf_s(str, count, L"%s [0x%04X]", L"C_LO_CONTRAST", id);          break;
-	case C_HI_CONTRAST          : swprintf_s(str, count, L"%s [0x%04X]", L"C_HI_CONTRAST", id);          break;
-	case C_FROZ_DISPLAY         : swprintf_s(str, count, L"%s [0x%04X]", L"C_FROZ_DISPLAY", id);         break;
-	case C_BOOLWELD             : swprintf_s(str, count, L"%s [0x%04X]", L"C_BOOLWELD", id);             break;
-	case C_BOOLTYPE             : swprintf_s(str, count, L"%s [0x%04X]", L"C_BOOLTYPE", id);             break;
-	case C_ANG_THRESH           : swprintf_s(str, count, L"%s [0x%04X]", L"C_ANG_THRESH", id);           break;
-	case C_SS_THRESH            : swprintf_s(str, count, L"%s [0x%04X]", L"C_SS_THRESH", id);            break;
-	case C_TEXTURE_BLUR_DEFAULT : swprintf_s(str, count, L"%s [0x%04X]", L"C_TEXTURE_BLUR_DEFAULT", id); break;
-	case C_MAPDRAWER            : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER", id);            break;
-	case C_MAPDRAWER1           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER1", id);           break;
-	case C_MAPDRAWER2           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER2", id);           break;
-	case C_MAPDRAWER3           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER3", id);           break;
-	case C_MAPDRAWER4           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER4", id);           break;
-	case C_MAPDRAWER5           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER5", id);           break;
-	case C_MAPDRAWER6           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER6", id);           break;
-	case C_MAPDRAWER7           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER7", id);           break;
-	case C_MAPDRAWER8           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER8", id);           break;
-	case C_MAPDRAWER9           : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER9", id);           break;
-	case C_MAPDRAWER_ENTRY      : swprintf_s(str, count, L"%s [0x%04X]", L"C_MAPDRAWER_ENTRY", id);      break;
-	case C_BACKUP_FILE          : swprintf_s(str, count, L"%s [0x%04X]", L"C_BACKUP_FILE", id);          break;
-	case C_DITHER_256           : swprintf_s(str, count, L"%s [0x%04X]", L"C_DITHER_256", id);           break;
-	case C_SAVE_LAST            : swprintf_s(str, count, L"%s [0x%04X]", L"C_SAVE_LAST", id);            break;
-	case C_USE_ALPHA            : swprintf_s(str, count, L"%s [0x%04X]", L"C_USE_ALPHA", id);            break;
-	case C_TGA_DEPTH            : swprintf_s(str, count, L"%s [0x%04X]", L"C_TGA_DEPTH", id);            break;
-	case C_REND_FIELDS          : swprintf_s(str, count, L"%s [0x%04X]", L"C_REND_FIELDS", id);          break;
-	case C_REFLIP               : swprintf_s(str, count, L"%s [0x%04X]", L"C_REFLIP", id);               break;
-	case C_SEL_ITEMTOG          : swprintf_s(str, count, L"%s [0x%04X]", L"C_SEL_ITEMTOG", id);          break;
-	case C_SEL_RESET            : swprintf_s(str, count, L"%s [0x%04X]", L"C_SEL_RESET", id);            break;
-	case C_STICKY_KEYINF        : swprintf_s(str, count, L"%s [0x%04X]", L"C_STICKY_KEYINF", id);        break;
-	case C_WELD_THRESHOLD       : swprintf_s(str, count, L"%s [0x%04X]", L"C_WELD_THRESHOLD", id);       break;
-	case C_ZCLIP_POINT          : swprintf_s(str, count, L"%s [0x%04X]", L"C_ZCLIP_POINT", id);          break;
-	case C_ALPHA_SPLIT          : swprintf_s(str, count, L"%s [0x%04X]", L"C_ALPHA_SPLIT", id);          break;
-	case C_KF_SHOW_BACKFACE     : swprintf_s(str, count, L"%s [0x%04X]", L"C_KF_SHOW_BACKFACE", id);     break;
-	case C_OPTIMIZE_LOFT        : swprintf_s(str, count, L"%s [0x%04X]", L"C_OPTIMIZE_LOFT", id);        break;
-	case C_TENS_DEFAULT         : swprintf_s(str, count, L"%s [0x%04X]", L"C_TENS_DEFAULT", id);         break;
-	case C_CONT_DEFAULT         : swprintf_s(str, count, L"%s [0x%04X]", L"C_CONT_DEFAULT", id);         break;
-	case C_BIAS_DEFAULT         : swprintf_s(str, count, L"%s [0x%04X]", L"C_BIAS_DEFAULT", id);         break;
-	case C_DXFNAME_SRC          : swprintf_s(str, count, L"%s [0x%04X]", L"C_DXFNAME_SRC", id);          break;
-	case C_AUTO_WELD            : swprintf_s(str, count, L"%s [0x%04X]", L"C_AUTO_WELD", id);            break;
-	case C_AUTO_UNIFY           : swprintf_s(str, count, L"%s [0x%04X]", L"C_AUTO_UNIFY", id);           break;
-	case C_AUTO_SMOOTH          : swprintf_s(str, count, L"%s [0x%04X]", L"C_AUTO_SMOOTH", id);          break;
-	case C_DXF_SMOOTH_ANG       : swprintf_s(str, count, L"%s [0x%04X]", L"C_DXF_SMOOTH_ANG", id);       break;
-	case C_SMOOTH_ANG           : swprintf_s(str, count, L"%s [0x%04X]", L"C_SMOOTH_ANG", id);           break;
-	case C_NET_USE_VPOST        : swprintf_s(str, count, L"%s [0x%04X]", L"C_NET_USE_VPOST", id);        break;
-	case C_NET_USE_GAMMA        : swprintf_s(str, count, L"%s [0x%04X]", L"C_NET_USE_GAMMA", id);        break;
-	case C_NET_FIELD_ORDER      : swprintf_s(str, count, L"%s [0x%04X]", L"C_NET_FIELD_ORDER", id);      break;
-	case C_BLUR_FRAMES          : swprintf_s(str, count, L"%s [0x%04X]", L"C_BLUR_FRAMES", id);          break;
-	case C_BLUR_SAMPLES         : swprintf_s(str, count, L"%s [0x%04X]", L"C_BLUR_SAMPLES", id);         break;
-	case C_BLUR_DUR             : swprintf_s(str, count, L"%s [0x%04X]", L"C_BLUR_DUR", id);             break;
-	case C_HOT_METHOD           : swprintf_s(str, count, L"%s [0x%04X]", L"C_HOT_METHOD", id);           break;
-	case C_HOT_CHECK            : swprintf_s(str, count, L"%s [0x%04X]", L"C_HOT_CHECK", id);            break;
-	case C_PIXEL_SIZE           : swprintf_s(str, count, L"%s [0x%04X]", L"C_PIXEL_SIZE", id);           break;
-	case C_DISP_GAMMA           : swprintf_s(str, count, L"%s [0x%04X]", L"C_DISP_GAMMA", id);           break;
-	case C_FBUF_GAMMA           : swprintf_s(str, count, L"%s [0x%04X]", L"C_FBUF_GAMMA", id);           break;
-	case C_FILE_OUT_GAMMA       : swprintf_s(str, count, L"%s [0x%04X]", L"C_FILE_OUT_GAMMA", id);       break;
-	case C_FILE_IN_GAMMA        : swprintf_s(str, count, L"%s [0x%04X]", L"C_FILE_IN_GAMMA", id);        break;
-	case C_GAMMA_CORRECT        : swprintf_s(str, count, L"%s [0x%04X]", L"C_GAMMA_CORRECT", id);        break;
-	case C_APPLY_DISP_GAMMA     : swprintf_s(str, count, L"%s [0x%04X]", L"C_APPLY_DISP_GAMMA", id);     break;
-	case C_APPLY_FBUF_GAMMA     : swprintf_s(str, count, L"%s [0x%04X]", L"C_APPLY_FBUF_GAMMA", id);     break;
-	case C_APPLY_FILE_GAMMA     : swprintf_s(str, count, L"%s [0x%04X]", L"C_APPLY_FILE_GAMMA", id);     break;
-	case C_FORCE_WIRE           : swprintf_s(str, count, L"%s [0x%04X]", L"C_FORCE_WIRE", id);           break;
-	case C_RAY_SHADOWS          : swprintf_s(str, count, L"%s [0x%04X]", L"C_RAY_SHADOWS", id);          break;
-	case C_MASTER_AMBIENT       : swprintf_s(str, count, L"%s [0x%04X]", L"C_MASTER_AMBIENT", id);       break;
-	case C_SUPER_SAMPLE         : swprintf_s(str, count, L"%s [0x%04X]", L"C_SUPER_SAMPLE", id);         break;
-	case C_OBJECT_MBLUR         : swprintf_s(str, count, L"%s [0x%04X]", L"C_OBJECT_MBLUR", id);         break;
-	case C_MBLUR_DITHER         : swprintf_s(str, count, L"%s [0x%04X]", L"C_MBLUR_DITHER", id);         break;
-	case C_DITHER_24            : swprintf_s(str, count, L"%s [0x%04X]", L"C_DITHER_24", id);            break;
-	case C_SUPER_BLACK          : swprintf_s(str, count, L"%s [0x%04X]", L"C_SUPER_BLACK", id);          break;
-	case C_SAFE_FRAME           : swprintf_s(str, count, L"%s [0x%04X]", L"C_SAFE_FRAME", id);           break;
-	case C_VIEW_PRES_RATIO      : swprintf_s(str, count, L"%s [0x%04X]", L"C_VIEW_PRES_RATIO", id);      break;
-	case C_BGND_PRES_RATIO      : swprintf_s(str, count, L"%s [0x%04X]", L"C_BGND_PRES_RATIO", id);      break;
-	case C_NTH_SERIAL_NUM       : swprintf_s(str, count, L"%s [0x%04X]", L"C_NTH_SERIAL_NUM", id);       break;
-	case VPDATA                 : swprintf_s(str, count, L"%s [0x%04X]", L"VPDATA", id);                 break;
-	case P_QUEUE_ENTRY          : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_ENTRY", id);          break;
-	case P_QUEUE_IMAGE          : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_IMAGE", id);          break;
-	case P_QUEUE_USEIGAMMA      : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_USEIGAMMA", id);      break;
-	case P_QUEUE_PROC           : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_PROC", id);           break;
-	case P_QUEUE_SOLID          : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_SOLID", id);          break;
-	case P_QUEUE_GRADIENT       : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_GRADIENT", id);       break;
-	case P_QUEUE_KF             : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_KF", id);             break;
-	case P_QUEUE_MOTBLUR        : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_MOTBLUR", id);        break;
-	case P_QUEUE_MB_REPEAT      : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_MB_REPEAT", id);      break;
-	case P_QUEUE_NONE           : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_NONE", id);           break;
-	case P_QUEUE_RESIZE         : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_RESIZE", id);         break;
-	case P_QUEUE_OFFSET         : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_OFFSET", id);         break;
-	case P_QUEUE_ALIGN          : swprintf_s(str, count, L"%s [0x%04X]", L"P_QUEUE_ALIGN", id);          break;
-	case P_CUSTOM_SIZE          : swprintf_s(str, count, L"%s [0x%04X]", L"P_CUSTOM_SIZE", id);          break;
-	case P_ALPH_NONE            : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_NONE", id);            break;
-	case P_ALPH_PSEUDO          : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_PSEUDO", id);          break;
-	case P_ALPH_OP_PSEUDO       : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_OP_PSEUDO", id);       break;
-	case P_ALPH_BLUR            : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_BLUR", id);            break;
-	case P_ALPH_PCOL            : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_PCOL", id);            break;
-	case P_ALPH_C0              : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_C0", id);              break;
-	case P_ALPH_OP_KEY          : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_OP_KEY", id);          break;
-	case P_ALPH_KCOL            : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_KCOL", id);            break;
-	case P_ALPH_OP_NOCONV       : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_OP_NOCONV", id);       break;
-	case P_ALPH_IMAGE           : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_IMAGE", id);           break;
-	case P_ALPH_ALPHA           : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_ALPHA", id);           break;
-	case P_ALPH_QUES            : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_QUES", id);            break;
-	case P_ALPH_QUEIMG          : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_QUEIMG", id);          break;
-	case P_ALPH_CUTOFF          : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPH_CUTOFF", id);          break;
-	case P_ALPHANEG             : swprintf_s(str, count, L"%s [0x%04X]", L"P_ALPHANEG", id);             break;
-	case P_TRAN_NONE            : swprintf_s(str, count, L"%s [0x%04X]", L"P_TRAN_NONE", id);            break;
-	case P_TRAN_IMAGE           : swprintf_s(str, count, L"%s [0x%04X]", L"P_TRAN_IMAGE", id);           break;
-	case P_TRAN_FRAMES          : swprintf_s(str, count, L"%s [0x%04X]", L"P_TRAN_FRAMES", id);          break;
-	case P_TRAN_FADEIN          : swprintf_s(str, count, L"%s [0x%04X]", L"P_TRAN_FADEIN", id);          break;
-	case P_TRAN_FADEOUT         : swprintf_s(str, count, L"%s [0x%04X]", L"P_TRAN_FADEOUT", id);         break;
-	case P_TRANNEG              : swprintf_s(str, count, L"%s [0x%04X]", L"P_TRANNEG", id);              break;
-	case P_RANGES               : swprintf_s(str, count, L"%s [0x%04X]", L"P_RANGES", id);               break;
-	case P_PROC_DATA            : swprintf_s(str, count, L"%s [0x%04X]", L"P_PROC_DATA", id);            break;
-	default: swprintf_s(str, count, L"%s[0x%04x]", L"DONT_KNOW_", id);
+	case NULL_CHUNK             : swprintf_s(str, count, L"%ls [0x%04X]", L"NULL_CHUNK", id);             break;
+	case ChunkType              : swprintf_s(str, count, L"%ls [0x%04X]", L"ChunkType", id);              break;
+	case ChunkUnique            : swprintf_s(str, count, L"%ls [0x%04X]", L"ChunkUnique", id);            break;
+	case NotChunk               : swprintf_s(str, count, L"%ls [0x%04X]", L"NotChunk", id);               break;
+	case Container              : swprintf_s(str, count, L"%ls [0x%04X]", L"Container", id);              break;
+	case IsChunk                : swprintf_s(str, count, L"%ls [0x%04X]", L"IsChunk", id);                break;
+	case DUMMY                  : swprintf_s(str, count, L"%ls [0x%04X]", L"DUMMY", id);                  break;
+	case POINT_ARRAY_ENTRY      : swprintf_s(str, count, L"%ls [0x%04X]", L"POINT_ARRAY_ENTRY", id);      break;
+	case POINT_FLAG_ARRAY_ENTRY : swprintf_s(str, count, L"%ls [0x%04X]", L"POINT_FLAG_ARRAY_ENTRY", id); break;
+	case FACE_ARRAY_ENTRY       : swprintf_s(str, count, L"%ls [0x%04X]", L"FACE_ARRAY_ENTRY", id);       break;
+	case MSH_MAT_GROUP_ENTRY    : swprintf_s(str, count, L"%ls [0x%04X]", L"MSH_MAT_GROUP_ENTRY", id);    break;
+	case TEX_VERTS_ENTRY        : swprintf_s(str, count, L"%ls [0x%04X]", L"TEX_VERTS_ENTRY", id);        break;
+	case SMOOTH_GROUP_ENTRY     : swprintf_s(str, count, L"%ls [0x%04X]", L"SMOOTH_GROUP_ENTRY", id);     break;
+	case POS_TRACK_TAG_KEY      : swprintf_s(str, count, L"%ls [0x%04X]", L"POS_TRACK_TAG_KEY", id);      break;
+	case ROT_TRACK_TAG_KEY      : swprintf_s(str, count, L"%ls [0x%04X]", L"ROT_TRACK_TAG_KEY", id);      break;
+	case SCL_TRACK_TAG_KEY      : swprintf_s(str, count, L"%ls [0x%04X]", L"SCL_TRACK_TAG_KEY", id);      break;
+	case FOV_TRACK_TAG_KEY      : swprintf_s(str, count, L"%ls [0x%04X]", L"FOV_TRACK_TAG_KEY", id);      break;
+	case ROLL_TRACK_TAG_KEY     : swprintf_s(str, count, L"%ls [0x%04X]", L"ROLL_TRACK_TAG_KEY", id);     break;
+	case COL_TRACK_TAG_KEY      : swprintf_s(str, count, L"%ls [0x%04X]", L"COL_TRACK_TAG_KEY", id);      break;
+	case MORPH_TRACK_TAG_KEY    : swprintf_s(str, count, L"%ls [0x%04X]", L"MORPH_TRACK_TAG_KEY", id);    break;
+	case HOT_TRACK_TAG_KEY      : swprintf_s(str, count, L"%ls [0x%04X]", L"HOT_TRACK_TAG_KEY", id);      break;
+	case FALL_TRACK_TAG_KEY     : swprintf_s(str, count, L"%ls [0x%04X]", L"FALL_TRACK_TAG_KEY", id);     break;
+	case M3DMAGIC               : swprintf_s(str, count, L"%ls [0x%04X]", L"M3DMAGIC", id);               break;
+	case SMAGIC                 : swprintf_s(str, count, L"%ls [0x%04X]", L"SMAGIC", id);                 break;
+	case LMAGIC                 : swprintf_s(str, count, L"%ls [0x%04X]", L"LMAGIC", id);                 break;
+	case MLIBMAGIC              : swprintf_s(str, count, L"%ls [0x%04X]", L"MLIBMAGIC", id);              break;
+	case MATMAGIC               : swprintf_s(str, count, L"%ls [0x%04X]", L"MATMAGIC", id);               break;
+	case M3D_VERSION            : swprintf_s(str, count, L"%ls [0x%04X]", L"M3D_VERSION", id);            break;
+	case M3D_KFVERSION          : swprintf_s(str, count, L"%ls [0x%04X]", L"M3D_KFVERSION", id);          break;
+	case MDATA                  : swprintf_s(str, count, L"%ls [0x%04X]", L"MDATA", id);                  break;
+	case MESH_VERSION           : swprintf_s(str, count, L"%ls [0x%04X]", L"MESH_VERSION", id);           break;
+	case COLOR_F                : swprintf_s(str, count, L"%ls [0x%04X]", L"COLOR_F", id);                break;
+	case COLOR_24               : swprintf_s(str, count, L"%ls [0x%04X]", L"COLOR_24", id);               break;
+	case LIN_COLOR_24           : swprintf_s(str, count, L"%ls [0x%04X]", L"LIN_COLOR_24", id);           break;
+	case LIN_COLOR_F            : swprintf_s(str, count, L"%ls [0x%04X]", L"LIN_COLOR_F", id);            break;
+	case INT_PERCENTAGE         : swprintf_s(str, count, L"%ls [0x%04X]", L"INT_PERCENTAGE", id);         break;
+	case FLOAT_PERCENTAGE       : swprintf_s(str, count, L"%ls [0x%04X]", L"FLOAT_PERCENTAGE", id);       break;
+	case MASTER_SCALE           : swprintf_s(str, count, L"%ls [0x%04X]", L"MASTER_SCALE", id);           break;
+	case BIT_MAP                : swprintf_s(str, count, L"%ls [0x%04X]", L"BIT_MAP", id);                break;
+	case USE_BIT_MAP            : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_BIT_MAP", id);            break;
+	case SOLID_BGND             : swprintf_s(str, count, L"%ls [0x%04X]", L"SOLID_BGND", id);             break;
+	case USE_SOLID_BGND         : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_SOLID_BGND", id);         break;
+	case V_GRADIENT             : swprintf_s(str, count, L"%ls [0x%04X]", L"V_GRADIENT", id);             break;
+	case USE_V_GRADIENT         : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_V_GRADIENT", id);         break;
+	case LO_SHADOW_BIAS         : swprintf_s(str, count, L"%ls [0x%04X]", L"LO_SHADOW_BIAS", id);         break;
+	case HI_SHADOW_BIAS         : swprintf_s(str, count, L"%ls [0x%04X]", L"HI_SHADOW_BIAS", id);         break;
+	case SHADOW_MAP_SIZE        : swprintf_s(str, count, L"%ls [0x%04X]", L"SHADOW_MAP_SIZE", id);        break;
+	case SHADOW_SAMPLES         : swprintf_s(str, count, L"%ls [0x%04X]", L"SHADOW_SAMPLES", id);         break;
+	case SHADOW_RANGE           : swprintf_s(str, count, L"%ls [0x%04X]", L"SHADOW_RANGE", id);           break;
+	case SHADOW_FILTER          : swprintf_s(str, count, L"%ls [0x%04X]", L"SHADOW_FILTER", id);          break;
+	case RAY_BIAS               : swprintf_s(str, count, L"%ls [0x%04X]", L"RAY_BIAS", id);               break;
+	case O_CONSTS               : swprintf_s(str, count, L"%ls [0x%04X]", L"O_CONSTS", id);               break;
+	case AMBIENT_LIGHT          : swprintf_s(str, count, L"%ls [0x%04X]", L"AMBIENT_LIGHT", id);          break;
+	case FOG                    : swprintf_s(str, count, L"%ls [0x%04X]", L"FOG", id);                    break;
+	case USE_FOG                : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_FOG", id);                break;
+	case FOG_BGND               : swprintf_s(str, count, L"%ls [0x%04X]", L"FOG_BGND", id);               break;
+	case DISTANCE_CUE           : swprintf_s(str, count, L"%ls [0x%04X]", L"DISTANCE_CUE", id);           break;
+	case USE_DISTANCE_CUE       : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_DISTANCE_CUE", id);       break;
+	case LAYER_FOG              : swprintf_s(str, count, L"%ls [0x%04X]", L"LAYER_FOG", id);              break;
+	case USE_LAYER_FOG          : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_LAYER_FOG", id);          break;
+	case DCUE_BGND              : swprintf_s(str, count, L"%ls [0x%04X]", L"DCUE_BGND", id);              break;
+	case DEFAULT_VIEW           : swprintf_s(str, count, L"%ls [0x%04X]", L"DEFAULT_VIEW", id);           break;
+	case VIEW_TOP               : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEW_TOP", id);               break;
+	case VIEW_BOTTOM            : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEW_BOTTOM", id);            break;
+	case VIEW_LEFT              : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEW_LEFT", id);              break;
+	case VIEW_RIGHT             : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEW_RIGHT", id);             break;
+	case VIEW_FRONT             : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEW_FRONT", id);             break;
+	case VIEW_BACK              : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEW_BACK", id);              break;
+	case VIEW_USER              : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEW_USER", id);              break;
+	case VIEW_CAMERA            : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEW_CAMERA", id);            break;
+	case VIEW_WINDOW            : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEW_WINDOW", id);            break;
+	case NAMED_OBJECT           : swprintf_s(str, count, L"%ls [0x%04X]", L"NAMED_OBJECT", id);           break;
+	case OBJ_HIDDEN             : swprintf_s(str, count, L"%ls [0x%04X]", L"OBJ_HIDDEN", id);             break;
+	case OBJ_VIS_LOFTER         : swprintf_s(str, count, L"%ls [0x%04X]", L"OBJ_VIS_LOFTER", id);         break;
+	case OBJ_DOESNT_CAST        : swprintf_s(str, count, L"%ls [0x%04X]", L"OBJ_DOESNT_CAST", id);        break;
+	case OBJ_MATTE              : swprintf_s(str, count, L"%ls [0x%04X]", L"OBJ_MATTE", id);              break;
+	case OBJ_FAST               : swprintf_s(str, count, L"%ls [0x%04X]", L"OBJ_FAST", id);               break;
+	case OBJ_PROCEDURAL         : swprintf_s(str, count, L"%ls [0x%04X]", L"OBJ_PROCEDURAL", id);         break;
+	case OBJ_FROZEN             : swprintf_s(str, count, L"%ls [0x%04X]", L"OBJ_FROZEN", id);             break;
+	case OBJ_DONT_RCVSHADOW     : swprintf_s(str, count, L"%ls [0x%04X]", L"OBJ_DONT_RCVSHADOW", id);     break;
+	case N_TRI_OBJECT           : swprintf_s(str, count, L"%ls [0x%04X]", L"N_TRI_OBJECT", id);           break;
+	case POINT_ARRAY            : swprintf_s(str, count, L"%ls [0x%04X]", L"POINT_ARRAY", id);            break;
+	case POINT_FLAG_ARRAY       : swprintf_s(str, count, L"%ls [0x%04X]", L"POINT_FLAG_ARRAY", id);       break;
+	case FACE_ARRAY             : swprintf_s(str, count, L"%ls [0x%04X]", L"FACE_ARRAY", id);             break;
+	case MSH_MAT_GROUP          : swprintf_s(str, count, L"%ls [0x%04X]", L"MSH_MAT_GROUP", id);          break;
+	case OLD_MAT_GROUP          : swprintf_s(str, count, L"%ls [0x%04X]", L"OLD_MAT_GROUP", id);          break;
+	case TEX_VERTS              : swprintf_s(str, count, L"%ls [0x%04X]", L"TEX_VERTS", id);              break;
+	case SMOOTH_GROUP           : swprintf_s(str, count, L"%ls [0x%04X]", L"SMOOTH_GROUP", id);           break;
+	case MESH_MATRIX            : swprintf_s(str, count, L"%ls [0x%04X]", L"MESH_MATRIX", id);            break;
+	case MESH_COLOR             : swprintf_s(str, count, L"%ls [0x%04X]", L"MESH_COLOR", id);             break;
+	case MESH_TEXTURE_INFO      : swprintf_s(str, count, L"%ls [0x%04X]", L"MESH_TEXTURE_INFO", id);      break;
+	case PROC_NAME              : swprintf_s(str, count, L"%ls [0x%04X]", L"PROC_NAME", id);              break;
+	case PROC_DATA              : swprintf_s(str, count, L"%ls [0x%04X]", L"PROC_DATA", id);              break;
+	case MSH_BOXMAP             : swprintf_s(str, count, L"%ls [0x%04X]", L"MSH_BOXMAP", id);             break;
+	case N_D_L_OLD              : swprintf_s(str, count, L"%ls [0x%04X]", L"N_D_L_OLD", id);              break;
+	case N_CAM_OLD              : swprintf_s(str, count, L"%ls [0x%04X]", L"N_CAM_OLD", id);              break;
+	case N_DIRECT_LIGHT         : swprintf_s(str, count, L"%ls [0x%04X]", L"N_DIRECT_LIGHT", id);         break;
+	case DL_SPOTLIGHT           : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_SPOTLIGHT", id);           break;
+	case DL_OFF                 : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_OFF", id);                 break;
+	case DL_ATTENUATE           : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_ATTENUATE", id);           break;
+	case DL_RAYSHAD             : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_RAYSHAD", id);             break;
+	case DL_SHADOWED            : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_SHADOWED", id);            break;
+	case DL_LOCAL_SHADOW        : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_LOCAL_SHADOW", id);        break;
+	case DL_LOCAL_SHADOW2       : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_LOCAL_SHADOW2", id);       break;
+	case DL_SEE_CONE            : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_SEE_CONE", id);            break;
+	case DL_SPOT_RECTANGULAR    : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_SPOT_RECTANGULAR", id);    break;
+	case DL_SPOT_OVERSHOOT      : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_SPOT_OVERSHOOT", id);      break;
+	case DL_SPOT_PROJECTOR      : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_SPOT_PROJECTOR", id);      break;
+	case DL_EXCLUDE             : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_EXCLUDE", id);             break;
+	case DL_RANGE               : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_RANGE", id);               break;
+	case DL_SPOT_ROLL           : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_SPOT_ROLL", id);           break;
+	case DL_SPOT_ASPECT         : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_SPOT_ASPECT", id);         break;
+	case DL_RAY_BIAS            : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_RAY_BIAS", id);            break;
+	case DL_INNER_RANGE         : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_INNER_RANGE", id);         break;
+	case DL_OUTER_RANGE         : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_OUTER_RANGE", id);         break;
+	case DL_MULTIPLIER          : swprintf_s(str, count, L"%ls [0x%04X]", L"DL_MULTIPLIER", id);          break;
+	case N_AMBIENT_LIGHT        : swprintf_s(str, count, L"%ls [0x%04X]", L"N_AMBIENT_LIGHT", id);        break;
+	case N_CAMERA               : swprintf_s(str, count, L"%ls [0x%04X]", L"N_CAMERA", id);               break;
+	case CAM_SEE_CONE           : swprintf_s(str, count, L"%ls [0x%04X]", L"CAM_SEE_CONE", id);           break;
+	case CAM_RANGES             : swprintf_s(str, count, L"%ls [0x%04X]", L"CAM_RANGES", id);             break;
+	case HIERARCHY              : swprintf_s(str, count, L"%ls [0x%04X]", L"HIERARCHY", id);              break;
+	case PARENT_OBJECT          : swprintf_s(str, count, L"%ls [0x%04X]", L"PARENT_OBJECT", id);          break;
+	case PIVOT_OBJECT           : swprintf_s(str, count, L"%ls [0x%04X]", L"PIVOT_OBJECT", id);           break;
+	case PIVOT_LIMITS           : swprintf_s(str, count, L"%ls [0x%04X]", L"PIVOT_LIMITS", id);           break;
+	case PIVOT_ORDER            : swprintf_s(str, count, L"%ls [0x%04X]", L"PIVOT_ORDER", id);            break;
+	case XLATE_RANGE            : swprintf_s(str, count, L"%ls [0x%04X]", L"XLATE_RANGE", id);            break;
+	case POLY_2D                : swprintf_s(str, count, L"%ls [0x%04X]", L"POLY_2D", id);                break;
+	case SHAPE_OK               : swprintf_s(str, count, L"%ls [0x%04X]", L"SHAPE_OK", id);               break;
+	case SHAPE_NOT_OK           : swprintf_s(str, count, L"%ls [0x%04X]", L"SHAPE_NOT_OK", id);           break;
+	case SHAPE_HOOK             : swprintf_s(str, count, L"%ls [0x%04X]", L"SHAPE_HOOK", id);             break;
+	case PATH_3D                : swprintf_s(str, count, L"%ls [0x%04X]", L"PATH_3D", id);                break;
+	case PATH_MATRIX            : swprintf_s(str, count, L"%ls [0x%04X]", L"PATH_MATRIX", id);            break;
+	case SHAPE_2D               : swprintf_s(str, count, L"%ls [0x%04X]", L"SHAPE_2D", id);               break;
+	case M_SCALE                : swprintf_s(str, count, L"%ls [0x%04X]", L"M_SCALE", id);                break;
+	case M_TWIST                : swprintf_s(str, count, L"%ls [0x%04X]", L"M_TWIST", id);                break;
+	case M_TEETER               : swprintf_s(str, count, L"%ls [0x%04X]", L"M_TEETER", id);               break;
+	case M_FIT                  : swprintf_s(str, count, L"%ls [0x%04X]", L"M_FIT", id);                  break;
+	case M_BEVEL                : swprintf_s(str, count, L"%ls [0x%04X]", L"M_BEVEL", id);                break;
+	case XZ_CURVE               : swprintf_s(str, count, L"%ls [0x%04X]", L"XZ_CURVE", id);               break;
+	case YZ_CURVE               : swprintf_s(str, count, L"%ls [0x%04X]", L"YZ_CURVE", id);               break;
+	case INTERPCT               : swprintf_s(str, count, L"%ls [0x%04X]", L"INTERPCT", id);               break;
+	case DEFORM_LIMIT           : swprintf_s(str, count, L"%ls [0x%04X]", L"DEFORM_LIMIT", id);           break;
+	case USE_CONTOUR            : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_CONTOUR", id);            break;
+	case USE_TWEEN              : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_TWEEN", id);              break;
+	case USE_SCALE              : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_SCALE", id);              break;
+	case USE_TWIST              : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_TWIST", id);              break;
+	case USE_TEETER             : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_TEETER", id);             break;
+	case USE_FIT                : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_FIT", id);                break;
+	case USE_BEVEL              : swprintf_s(str, count, L"%ls [0x%04X]", L"USE_BEVEL", id);              break;
+	case VIEWPORT_LAYOUT_OLD    : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEWPORT_LAYOUT_OLD", id);    break;
+	case VIEWPORT_DATA_OLD      : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEWPORT_DATA_OLD", id);      break;
+	case VIEWPORT_LAYOUT        : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEWPORT_LAYOUT", id);        break;
+	case VIEWPORT_DATA          : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEWPORT_DATA", id);          break;
+	case VIEWPORT_DATA_3        : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEWPORT_DATA_3", id);        break;
+	case VIEWPORT_SIZE          : swprintf_s(str, count, L"%ls [0x%04X]", L"VIEWPORT_SIZE", id);          break;
+	case NETWORK_VIEW           : swprintf_s(str, count, L"%ls [0x%04X]", L"NETWORK_VIEW", id);           break;
+	case XDATA_SECTION          : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_SECTION", id);          break;
+	case XDATA_ENTRY            : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_ENTRY", id);            break;
+	case XDATA_APPNAME          : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_APPNAME", id);          break;
+	case XDATA_STRING           : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_STRING", id);           break;
+	case XDATA_FLOAT            : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_FLOAT", id);            break;
+	case XDATA_DOUBLE           : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_DOUBLE", id);           break;
+	case XDATA_SHORT            : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_SHORT", id);            break;
+	case XDATA_LONG             : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_LONG", id);             break;
+	case XDATA_VOID             : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_VOID", id);             break;
+	case XDATA_GROUP            : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_GROUP", id);            break;
+	case XDATA_RFU6             : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_RFU6", id);             break;
+	case XDATA_RFU5             : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_RFU5", id);             break;
+	case XDATA_RFU4             : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_RFU4", id);             break;
+	case XDATA_RFU3             : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_RFU3", id);             break;
+	case XDATA_RFU2             : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_RFU2", id);             break;
+	case XDATA_RFU1             : swprintf_s(str, count, L"%ls [0x%04X]", L"XDATA_RFU1", id);             break;
+	case PARENT_NAME            : swprintf_s(str, count, L"%ls [0x%04X]", L"PARENT_NAME", id);            break;
+	case MAT_ENTRY              : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_ENTRY", id);              break;
+	case MAT_NAME               : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_NAME", id);               break;
+	case MAT_AMBIENT            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_AMBIENT", id);            break;
+	case MAT_DIFFUSE            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_DIFFUSE", id);            break;
+	case MAT_SPECULAR           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SPECULAR", id);           break;
+	case MAT_SHININESS          : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SHININESS", id);          break;
+	case MAT_SHIN2PCT           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SHIN2PCT", id);           break;
+	case MAT_SHIN3PCT           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SHIN3PCT", id);           break;
+	case MAT_TRANSPARENCY       : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_TRANSPARENCY", id);       break;
+	case MAT_XPFALL             : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_XPFALL", id);             break;
+	case MAT_REFBLUR            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_REFBLUR", id);            break;
+	case MAT_SELF_ILLUM         : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SELF_ILLUM", id);         break;
+	case MAT_TWO_SIDE           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_TWO_SIDE", id);           break;
+	case MAT_DECAL              : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_DECAL", id);              break;
+	case MAT_ADDITIVE           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_ADDITIVE", id);           break;
+	case MAT_SELF_ILPCT         : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SELF_ILPCT", id);         break;
+	case MAT_WIRE               : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_WIRE", id);               break;
+	case MAT_SUPERSMP           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SUPERSMP", id);           break;
+	case MAT_WIRESIZE           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_WIRESIZE", id);           break;
+	case MAT_FACEMAP            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_FACEMAP", id);            break;
+	case MAT_XPFALLIN           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_XPFALLIN", id);           break;
+	case MAT_PHONGSOFT          : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_PHONGSOFT", id);          break;
+	case MAT_WIREABS            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_WIREABS", id);            break;
+	case MAT_SHADING            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SHADING", id);            break;
+	case MAT_TEXMAP             : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_TEXMAP", id);             break;
+	case MAT_OPACMAP            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_OPACMAP", id);            break;
+	case MAT_REFLMAP            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_REFLMAP", id);            break;
+	case MAT_BUMPMAP            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_BUMPMAP", id);            break;
+	case MAT_SPECMAP            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SPECMAP", id);            break;
+	case MAT_USE_XPFALL         : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_USE_XPFALL", id);         break;
+	case MAT_USE_REFBLUR        : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_USE_REFBLUR", id);        break;
+	case MAT_BUMP_PERCENT       : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_BUMP_PERCENT", id);       break;
+	case MAT_MAPNAME            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAPNAME", id);            break;
+	case MAT_ACUBIC             : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_ACUBIC", id);             break;
+	case MAT_SXP_TEXT_DATA      : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_TEXT_DATA", id);      break;
+	case MAT_SXP_TEXT2_DATA     : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_TEXT2_DATA", id);     break;
+	case MAT_SXP_OPAC_DATA      : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_OPAC_DATA", id);      break;
+	case MAT_SXP_BUMP_DATA      : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_BUMP_DATA", id);      break;
+	case MAT_SXP_SPEC_DATA      : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_SPEC_DATA", id);      break;
+	case MAT_SXP_SHIN_DATA      : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_SHIN_DATA", id);      break;
+	case MAT_SXP_SELFI_DATA     : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_SELFI_DATA", id);     break;
+	case MAT_SXP_TEXT_MASKDATA  : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_TEXT_MASKDATA", id);  break;
+	case MAT_SXP_TEXT2_MASKDATA : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_TEXT2_MASKDATA", id); break;
+	case MAT_SXP_OPAC_MASKDATA  : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_OPAC_MASKDATA", id);  break;
+	case MAT_SXP_BUMP_MASKDATA  : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_BUMP_MASKDATA", id);  break;
+	case MAT_SXP_SPEC_MASKDATA  : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_SPEC_MASKDATA", id);  break;
+	case MAT_SXP_SHIN_MASKDATA  : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_SHIN_MASKDATA", id);  break;
+	case MAT_SXP_SELFI_MASKDATA : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_SELFI_MASKDATA", id); break;
+	case MAT_SXP_REFL_MASKDATA  : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SXP_REFL_MASKDATA", id);  break;
+	case MAT_TEX2MAP            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_TEX2MAP", id);            break;
+	case MAT_SHINMAP            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SHINMAP", id);            break;
+	case MAT_SELFIMAP           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SELFIMAP", id);           break;
+	case MAT_TEXMASK            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_TEXMASK", id);            break;
+	case MAT_TEX2MASK           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_TEX2MASK", id);           break;
+	case MAT_OPACMASK           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_OPACMASK", id);           break;
+	case MAT_BUMPMASK           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_BUMPMASK", id);           break;
+	case MAT_SHINMASK           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SHINMASK", id);           break;
+	case MAT_SPECMASK           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SPECMASK", id);           break;
+	case MAT_SELFIMASK          : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_SELFIMASK", id);          break;
+	case MAT_REFLMASK           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_REFLMASK", id);           break;
+	case MAT_MAP_TILINGOLD      : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_TILINGOLD", id);      break;
+	case MAT_MAP_TILING         : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_TILING", id);         break;
+	case MAT_MAP_TEXBLUR_OLD    : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_TEXBLUR_OLD", id);    break;
+	case MAT_MAP_TEXBLUR        : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_TEXBLUR", id);        break;
+	case MAT_MAP_USCALE         : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_USCALE", id);         break;
+	case MAT_MAP_VSCALE         : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_VSCALE", id);         break;
+	case MAT_MAP_UOFFSET        : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_UOFFSET", id);        break;
+	case MAT_MAP_VOFFSET        : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_VOFFSET", id);        break;
+	case MAT_MAP_ANG            : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_ANG", id);            break;
+	case MAT_MAP_COL1           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_COL1", id);           break;
+	case MAT_MAP_COL2           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_COL2", id);           break;
+	case MAT_MAP_RCOL           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_RCOL", id);           break;
+	case MAT_MAP_GCOL           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_GCOL", id);           break;
+	case MAT_MAP_BCOL           : swprintf_s(str, count, L"%ls [0x%04X]", L"MAT_MAP_BCOL", id);           break;
+	case KFDATA                 : swprintf_s(str, count, L"%ls [0x%04X]", L"KFDATA", id);                 break;
+	case KFHDR                  : swprintf_s(str, count, L"%ls [0x%04X]", L"KFHDR", id);                  break;
+	case AMBIENT_NODE_TAG       : swprintf_s(str, count, L"%ls [0x%04X]", L"AMBIENT_NODE_TAG", id);       break;
+	case OBJECT_NODE_TAG        : swprintf_s(str, count, L"%ls [0x%04X]", L"OBJECT_NODE_TAG", id);        break;
+	case CAMERA_NODE_TAG        : swprintf_s(str, count, L"%ls [0x%04X]", L"CAMERA_NODE_TAG", id);        break;
+	case TARGET_NODE_TAG        : swprintf_s(str, count, L"%ls [0x%04X]", L"TARGET_NODE_TAG", id);        break;
+	case LIGHT_NODE_TAG         : swprintf_s(str, count, L"%ls [0x%04X]", L"LIGHT_NODE_TAG", id);         break;
+	case L_TARGET_NODE_TAG      : swprintf_s(str, count, L"%ls [0x%04X]", L"L_TARGET_NODE_TAG", id);      break;
+	case SPOTLIGHT_NODE_TAG     : swprintf_s(str, count, L"%ls [0x%04X]", L"SPOTLIGHT_NODE_TAG", id);     break;
+	case KFSEG                  : swprintf_s(str, count, L"%ls [0x%04X]", L"KFSEG", id);                  break;
+	case KFCURTIME              : swprintf_s(str, count, L"%ls [0x%04X]", L"KFCURTIME", id);              break;
+	case NODE_HDR               : swprintf_s(str, count, L"%ls [0x%04X]", L"NODE_HDR", id);               break;
+	case INSTANCE_NAME          : swprintf_s(str, count, L"%ls [0x%04X]", L"INSTANCE_NAME", id);          break;
+	case PRESCALE               : swprintf_s(str, count, L"%ls [0x%04X]", L"PRESCALE", id);               break;
+	case PIVOT                  : swprintf_s(str, count, L"%ls [0x%04X]", L"PIVOT", id);                  break;
+	case BOUNDBOX               : swprintf_s(str, count, L"%ls [0x%04X]", L"BOUNDBOX", id);               break;
+	case MORPH_SMOOTH           : swprintf_s(str, count, L"%ls [0x%04X]", L"MORPH_SMOOTH", id);           break;
+	case POS_TRACK_TAG          : swprintf_s(str, count, L"%ls [0x%04X]", L"POS_TRACK_TAG", id);          break;
+	case ROT_TRACK_TAG          : swprintf_s(str, count, L"%ls [0x%04X]", L"ROT_TRACK_TAG", id);          break;
+	case SCL_TRACK_TAG          : swprintf_s(str, count, L"%ls [0x%04X]", L"SCL_TRACK_TAG", id);          break;
+	case FOV_TRACK_TAG          : swprintf_s(str, count, L"%ls [0x%04X]", L"FOV_TRACK_TAG", id);          break;
+	case ROLL_TRACK_TAG         : swprintf_s(str, count, L"%ls [0x%04X]", L"ROLL_TRACK_TAG", id);         break;
+	case COL_TRACK_TAG          : swprintf_s(str, count, L"%ls [0x%04X]", L"COL_TRACK_TAG", id);          break;
+	case MORPH_TRACK_TAG        : swprintf_s(str, count, L"%ls [0x%04X]", L"MORPH_TRACK_TAG", id);        break;
+	case HOT_TRACK_TAG          : swprintf_s(str, count, L"%ls [0x%04X]", L"HOT_TRACK_TAG", id);          break;
+	case FALL_TRACK_TAG         : swprintf_s(str, count, L"%ls [0x%04X]", L"FALL_TRACK_TAG", id);         break;
+	case HIDE_TRACK_TAG         : swprintf_s(str, count, L"%ls [0x%04X]", L"HIDE_TRACK_TAG", id);         break;
+	case NODE_ID                : swprintf_s(str, count, L"%ls [0x%04X]", L"NODE_ID", id);                break;
+	case CMAGIC                 : swprintf_s(str, count, L"%ls [0x%04X]", L"CMAGIC", id);                 break;
+	case C_MDRAWER              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MDRAWER", id);              break;
+	case C_TDRAWER              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TDRAWER", id);              break;
+	case C_SHPDRAWER            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SHPDRAWER", id);            break;
+	case C_MODDRAWER            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MODDRAWER", id);            break;
+	case C_RIPDRAWER            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RIPDRAWER", id);            break;
+	case C_TXDRAWER             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TXDRAWER", id);             break;
+	case C_PDRAWER              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PDRAWER", id);              break;
+	case C_MTLDRAWER            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MTLDRAWER", id);            break;
+	case C_FLIDRAWER            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_FLIDRAWER", id);            break;
+	case C_CUBDRAWER            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_CUBDRAWER", id);            break;
+	case C_MFILE                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MFILE", id);                break;
+	case C_SHPFILE              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SHPFILE", id);              break;
+	case C_MODFILE              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MODFILE", id);              break;
+	case C_RIPFILE              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RIPFILE", id);              break;
+	case C_TXFILE               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TXFILE", id);               break;
+	case C_PFILE                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PFILE", id);                break;
+	case C_MTLFILE              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MTLFILE", id);              break;
+	case C_FLIFILE              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_FLIFILE", id);              break;
+	case C_PALFILE              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PALFILE", id);              break;
+	case C_TX_STRING            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TX_STRING", id);            break;
+	case C_CONSTS               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_CONSTS", id);               break;
+	case C_SNAPS                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SNAPS", id);                break;
+	case C_GRIDS                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_GRIDS", id);                break;
+	case C_ASNAPS               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_ASNAPS", id);               break;
+	case C_GRID_RANGE           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_GRID_RANGE", id);           break;
+	case C_RENDTYPE             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RENDTYPE", id);             break;
+	case C_PROGMODE             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PROGMODE", id);             break;
+	case C_PREVMODE             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PREVMODE", id);             break;
+	case C_MODWMODE             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MODWMODE", id);             break;
+	case C_MODMODEL             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MODMODEL", id);             break;
+	case C_ALL_LINES            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_ALL_LINES", id);            break;
+	case C_BACK_TYPE            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BACK_TYPE", id);            break;
+	case C_MD_CS                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MD_CS", id);                break;
+	case C_MD_CE                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MD_CE", id);                break;
+	case C_MD_SML               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MD_SML", id);               break;
+	case C_MD_SMW               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MD_SMW", id);               break;
+	case C_LOFT_WITH_TEXTURE    : swprintf_s(str, count, L"%ls [0x%04X]", L"C_LOFT_WITH_TEXTURE", id);    break;
+	case C_LOFT_L_REPEAT        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_LOFT_L_REPEAT", id);        break;
+	case C_LOFT_W_REPEAT        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_LOFT_W_REPEAT", id);        break;
+	case C_LOFT_UV_NORMALIZE    : swprintf_s(str, count, L"%ls [0x%04X]", L"C_LOFT_UV_NORMALIZE", id);    break;
+	case C_WELD_LOFT            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WELD_LOFT", id);            break;
+	case C_MD_PDET              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MD_PDET", id);              break;
+	case C_MD_SDET              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MD_SDET", id);              break;
+	case C_RGB_RMODE            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_RMODE", id);            break;
+	case C_RGB_HIDE             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_HIDE", id);             break;
+	case C_RGB_MAPSW            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_MAPSW", id);            break;
+	case C_RGB_TWOSIDE          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_TWOSIDE", id);          break;
+	case C_RGB_SHADOW           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_SHADOW", id);           break;
+	case C_RGB_AA               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_AA", id);               break;
+	case C_RGB_OVW              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_OVW", id);              break;
+	case C_RGB_OVH              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_OVH", id);              break;
+	case C_RGB_PICTYPE          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_PICTYPE", id);          break;
+	case C_RGB_OUTPUT           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_OUTPUT", id);           break;
+	case C_RGB_TODISK           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_TODISK", id);           break;
+	case C_RGB_COMPRESS         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_COMPRESS", id);         break;
+	case C_JPEG_COMPRESSION     : swprintf_s(str, count, L"%ls [0x%04X]", L"C_JPEG_COMPRESSION", id);     break;
+	case C_RGB_DISPDEV          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_DISPDEV", id);          break;
+	case C_RGB_HARDDEV          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_HARDDEV", id);          break;
+	case C_RGB_PATH             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_PATH", id);             break;
+	case C_BITMAP_DRAWER        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BITMAP_DRAWER", id);        break;
+	case C_RGB_FILE             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_FILE", id);             break;
+	case C_RGB_OVASPECT         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_OVASPECT", id);         break;
+	case C_RGB_ANIMTYPE         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RGB_ANIMTYPE", id);         break;
+	case C_RENDER_ALL           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RENDER_ALL", id);           break;
+	case C_REND_FROM            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_REND_FROM", id);            break;
+	case C_REND_TO              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_REND_TO", id);              break;
+	case C_REND_NTH             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_REND_NTH", id);             break;
+	case C_PAL_TYPE             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PAL_TYPE", id);             break;
+	case C_RND_TURBO            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RND_TURBO", id);            break;
+	case C_RND_MIP              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RND_MIP", id);              break;
+	case C_BGND_METHOD          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BGND_METHOD", id);          break;
+	case C_AUTO_REFLECT         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_AUTO_REFLECT", id);         break;
+	case C_VP_FROM              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VP_FROM", id);              break;
+	case C_VP_TO                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VP_TO", id);                break;
+	case C_VP_NTH               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VP_NTH", id);               break;
+	case C_REND_TSTEP           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_REND_TSTEP", id);           break;
+	case C_VP_TSTEP             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VP_TSTEP", id);             break;
+	case C_SRDIAM               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SRDIAM", id);               break;
+	case C_SRDEG                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SRDEG", id);                break;
+	case C_SRSEG                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SRSEG", id);                break;
+	case C_SRDIR                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SRDIR", id);                break;
+	case C_HETOP                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HETOP", id);                break;
+	case C_HEBOT                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HEBOT", id);                break;
+	case C_HEHT                 : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HEHT", id);                 break;
+	case C_HETURNS              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HETURNS", id);              break;
+	case C_HEDEG                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HEDEG", id);                break;
+	case C_HESEG                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HESEG", id);                break;
+	case C_HEDIR                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HEDIR", id);                break;
+	case C_QUIKSTUFF            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_QUIKSTUFF", id);            break;
+	case C_SEE_LIGHTS           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SEE_LIGHTS", id);           break;
+	case C_SEE_CAMERAS          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SEE_CAMERAS", id);          break;
+	case C_SEE_3D               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SEE_3D", id);               break;
+	case C_MESHSEL              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MESHSEL", id);              break;
+	case C_MESHUNSEL            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MESHUNSEL", id);            break;
+	case C_POLYSEL              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_POLYSEL", id);              break;
+	case C_POLYUNSEL            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_POLYUNSEL", id);            break;
+	case C_SHPLOCAL             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SHPLOCAL", id);             break;
+	case C_MSHLOCAL             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MSHLOCAL", id);             break;
+	case C_NUM_FORMAT           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_NUM_FORMAT", id);           break;
+	case C_ARCH_DENOM           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_ARCH_DENOM", id);           break;
+	case C_IN_DEVICE            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_IN_DEVICE", id);            break;
+	case C_MSCALE               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MSCALE", id);               break;
+	case C_COMM_PORT            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_COMM_PORT", id);            break;
+	case C_TAB_BASES            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TAB_BASES", id);            break;
+	case C_TAB_DIVS             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TAB_DIVS", id);             break;
+	case C_MASTER_SCALES        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MASTER_SCALES", id);        break;
+	case C_SHOW_1STVERT         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SHOW_1STVERT", id);         break;
+	case C_SHAPER_OK            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SHAPER_OK", id);            break;
+	case C_LOFTER_OK            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_LOFTER_OK", id);            break;
+	case C_EDITOR_OK            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_EDITOR_OK", id);            break;
+	case C_KEYFRAMER_OK         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_KEYFRAMER_OK", id);         break;
+	case C_PICKSIZE             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PICKSIZE", id);             break;
+	case C_MAPTYPE              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPTYPE", id);              break;
+	case C_MAP_DISPLAY          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAP_DISPLAY", id);          break;
+	case C_TILE_XY              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TILE_XY", id);              break;
+	case C_MAP_XYZ              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAP_XYZ", id);              break;
+	case C_MAP_SCALE            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAP_SCALE", id);            break;
+	case C_MAP_MATRIX_OLD       : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAP_MATRIX_OLD", id);       break;
+	case C_MAP_MATRIX           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAP_MATRIX", id);           break;
+	case C_MAP_WID_HT           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAP_WID_HT", id);           break;
+	case C_OBNAME               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_OBNAME", id);               break;
+	case C_CAMNAME              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_CAMNAME", id);              break;
+	case C_LTNAME               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_LTNAME", id);               break;
+	case C_CUR_MNAME            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_CUR_MNAME", id);            break;
+	case C_CURMTL_FROM_MESH     : swprintf_s(str, count, L"%ls [0x%04X]", L"C_CURMTL_FROM_MESH", id);     break;
+	case C_GET_SHAPE_MAKE_FACES : swprintf_s(str, count, L"%ls [0x%04X]", L"C_GET_SHAPE_MAKE_FACES", id); break;
+	case C_DETAIL               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_DETAIL", id);               break;
+	case C_VERTMARK             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VERTMARK", id);             break;
+	case C_MSHAX                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MSHAX", id);                break;
+	case C_MSHCP                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MSHCP", id);                break;
+	case C_USERAX               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_USERAX", id);               break;
+	case C_SHOOK                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SHOOK", id);                break;
+	case C_RAX                  : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RAX", id);                  break;
+	case C_STAPE                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_STAPE", id);                break;
+	case C_LTAPE                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_LTAPE", id);                break;
+	case C_ETAPE                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_ETAPE", id);                break;
+	case C_KTAPE                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_KTAPE", id);                break;
+	case C_SPHSEGS              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SPHSEGS", id);              break;
+	case C_GEOSMOOTH            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_GEOSMOOTH", id);            break;
+	case C_HEMISEGS             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HEMISEGS", id);             break;
+	case C_PRISMSEGS            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PRISMSEGS", id);            break;
+	case C_PRISMSIDES           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PRISMSIDES", id);           break;
+	case C_TUBESEGS             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TUBESEGS", id);             break;
+	case C_TUBESIDES            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TUBESIDES", id);            break;
+	case C_TORSEGS              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TORSEGS", id);              break;
+	case C_TORSIDES             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TORSIDES", id);             break;
+	case C_CONESIDES            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_CONESIDES", id);            break;
+	case C_CONESEGS             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_CONESEGS", id);             break;
+	case C_NGPARMS              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_NGPARMS", id);              break;
+	case C_PTHLEVEL             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PTHLEVEL", id);             break;
+	case C_MSCSYM               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MSCSYM", id);               break;
+	case C_MFTSYM               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MFTSYM", id);               break;
+	case C_MTTSYM               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MTTSYM", id);               break;
+	case C_SMOOTHING            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SMOOTHING", id);            break;
+	case C_MODICOUNT            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MODICOUNT", id);            break;
+	case C_FONTSEL              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_FONTSEL", id);              break;
+	case C_TESS_TYPE            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TESS_TYPE", id);            break;
+	case C_TESS_TENSION         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TESS_TENSION", id);         break;
+	case C_SEG_START            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SEG_START", id);            break;
+	case C_SEG_END              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SEG_END", id);              break;
+	case C_CURTIME              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_CURTIME", id);              break;
+	case C_ANIMLENGTH           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_ANIMLENGTH", id);           break;
+	case C_PV_FROM              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PV_FROM", id);              break;
+	case C_PV_TO                : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PV_TO", id);                break;
+	case C_PV_DOFNUM            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PV_DOFNUM", id);            break;
+	case C_PV_RNG               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PV_RNG", id);               break;
+	case C_PV_NTH               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PV_NTH", id);               break;
+	case C_PV_TYPE              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PV_TYPE", id);              break;
+	case C_PV_METHOD            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PV_METHOD", id);            break;
+	case C_PV_FPS               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PV_FPS", id);               break;
+	case C_VTR_FRAMES           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VTR_FRAMES", id);           break;
+	case C_VTR_HDTL             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VTR_HDTL", id);             break;
+	case C_VTR_HD               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VTR_HD", id);               break;
+	case C_VTR_TL               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VTR_TL", id);               break;
+	case C_VTR_IN               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VTR_IN", id);               break;
+	case C_VTR_PK               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VTR_PK", id);               break;
+	case C_VTR_SH               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VTR_SH", id);               break;
+	case C_WORK_MTLS            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WORK_MTLS", id);            break;
+	case C_WORK_MTLS_2          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WORK_MTLS_2", id);          break;
+	case C_WORK_MTLS_3          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WORK_MTLS_3", id);          break;
+	case C_WORK_MTLS_4          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WORK_MTLS_4", id);          break;
+	case C_WORK_MTLS_5          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WORK_MTLS_5", id);          break;
+	case C_WORK_MTLS_6          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WORK_MTLS_6", id);          break;
+	case C_WORK_MTLS_7          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WORK_MTLS_7", id);          break;
+	case C_WORK_MTLS_8          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WORK_MTLS_8", id);          break;
+	case C_WORKMTL              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WORKMTL", id);              break;
+	case C_SXP_TEXT_DATA        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_TEXT_DATA", id);        break;
+	case C_SXP_TEXT2_DATA       : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_TEXT2_DATA", id);       break;
+	case C_SXP_OPAC_DATA        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_OPAC_DATA", id);        break;
+	case C_SXP_BUMP_DATA        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_BUMP_DATA", id);        break;
+	case C_SXP_SPEC_DATA        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_SPEC_DATA", id);        break;
+	case C_SXP_SHIN_DATA        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_SHIN_DATA", id);        break;
+	case C_SXP_SELFI_DATA       : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_SELFI_DATA", id);       break;
+	case C_SXP_TEXT_MASKDATA    : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_TEXT_MASKDATA", id);    break;
+	case C_SXP_TEXT2_MASKDATA   : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_TEXT2_MASKDATA", id);   break;
+	case C_SXP_OPAC_MASKDATA    : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_OPAC_MASKDATA", id);    break;
+	case C_SXP_BUMP_MASKDATA    : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_BUMP_MASKDATA", id);    break;
+	case C_SXP_SPEC_MASKDATA    : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_SPEC_MASKDATA", id);    break;
+	case C_SXP_SHIN_MASKDATA    : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_SHIN_MASKDATA", id);    break;
+	case C_SXP_SELFI_MASKDATA   : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_SELFI_MASKDATA", id);   break;
+	case C_SXP_REFL_MASKDATA    : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SXP_REFL_MASKDATA", id);    break;
+	case C_BGTYPE               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BGTYPE", id);               break;
+	case C_MEDTILE              : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MEDTILE", id);              break;
+	case C_LO_CONTRAST          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_LO_CONTRAST", id);          break;
+	case C_HI_CONTRAST          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HI_CONTRAST", id);          break;
+	case C_FROZ_DISPLAY         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_FROZ_DISPLAY", id);         break;
+	case C_BOOLWELD             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BOOLWELD", id);             break;
+	case C_BOOLTYPE             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BOOLTYPE", id);             break;
+	case C_ANG_THRESH           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_ANG_THRESH", id);           break;
+	case C_SS_THRESH            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SS_THRESH", id);            break;
+	case C_TEXTURE_BLUR_DEFAULT : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TEXTURE_BLUR_DEFAULT", id); break;
+	case C_MAPDRAWER            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER", id);            break;
+	case C_MAPDRAWER1           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER1", id);           break;
+	case C_MAPDRAWER2           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER2", id);           break;
+	case C_MAPDRAWER3           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER3", id);           break;
+	case C_MAPDRAWER4           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER4", id);           break;
+	case C_MAPDRAWER5           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER5", id);           break;
+	case C_MAPDRAWER6           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER6", id);           break;
+	case C_MAPDRAWER7           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER7", id);           break;
+	case C_MAPDRAWER8           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER8", id);           break;
+	case C_MAPDRAWER9           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER9", id);           break;
+	case C_MAPDRAWER_ENTRY      : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MAPDRAWER_ENTRY", id);      break;
+	case C_BACKUP_FILE          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BACKUP_FILE", id);          break;
+	case C_DITHER_256           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_DITHER_256", id);           break;
+	case C_SAVE_LAST            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SAVE_LAST", id);            break;
+	case C_USE_ALPHA            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_USE_ALPHA", id);            break;
+	case C_TGA_DEPTH            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TGA_DEPTH", id);            break;
+	case C_REND_FIELDS          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_REND_FIELDS", id);          break;
+	case C_REFLIP               : swprintf_s(str, count, L"%ls [0x%04X]", L"C_REFLIP", id);               break;
+	case C_SEL_ITEMTOG          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SEL_ITEMTOG", id);          break;
+	case C_SEL_RESET            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SEL_RESET", id);            break;
+	case C_STICKY_KEYINF        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_STICKY_KEYINF", id);        break;
+	case C_WELD_THRESHOLD       : swprintf_s(str, count, L"%ls [0x%04X]", L"C_WELD_THRESHOLD", id);       break;
+	case C_ZCLIP_POINT          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_ZCLIP_POINT", id);          break;
+	case C_ALPHA_SPLIT          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_ALPHA_SPLIT", id);          break;
+	case C_KF_SHOW_BACKFACE     : swprintf_s(str, count, L"%ls [0x%04X]", L"C_KF_SHOW_BACKFACE", id);     break;
+	case C_OPTIMIZE_LOFT        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_OPTIMIZE_LOFT", id);        break;
+	case C_TENS_DEFAULT         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_TENS_DEFAULT", id);         break;
+	case C_CONT_DEFAULT         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_CONT_DEFAULT", id);         break;
+	case C_BIAS_DEFAULT         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BIAS_DEFAULT", id);         break;
+	case C_DXFNAME_SRC          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_DXFNAME_SRC", id);          break;
+	case C_AUTO_WELD            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_AUTO_WELD", id);            break;
+	case C_AUTO_UNIFY           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_AUTO_UNIFY", id);           break;
+	case C_AUTO_SMOOTH          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_AUTO_SMOOTH", id);          break;
+	case C_DXF_SMOOTH_ANG       : swprintf_s(str, count, L"%ls [0x%04X]", L"C_DXF_SMOOTH_ANG", id);       break;
+	case C_SMOOTH_ANG           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SMOOTH_ANG", id);           break;
+	case C_NET_USE_VPOST        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_NET_USE_VPOST", id);        break;
+	case C_NET_USE_GAMMA        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_NET_USE_GAMMA", id);        break;
+	case C_NET_FIELD_ORDER      : swprintf_s(str, count, L"%ls [0x%04X]", L"C_NET_FIELD_ORDER", id);      break;
+	case C_BLUR_FRAMES          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BLUR_FRAMES", id);          break;
+	case C_BLUR_SAMPLES         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BLUR_SAMPLES", id);         break;
+	case C_BLUR_DUR             : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BLUR_DUR", id);             break;
+	case C_HOT_METHOD           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HOT_METHOD", id);           break;
+	case C_HOT_CHECK            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_HOT_CHECK", id);            break;
+	case C_PIXEL_SIZE           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_PIXEL_SIZE", id);           break;
+	case C_DISP_GAMMA           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_DISP_GAMMA", id);           break;
+	case C_FBUF_GAMMA           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_FBUF_GAMMA", id);           break;
+	case C_FILE_OUT_GAMMA       : swprintf_s(str, count, L"%ls [0x%04X]", L"C_FILE_OUT_GAMMA", id);       break;
+	case C_FILE_IN_GAMMA        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_FILE_IN_GAMMA", id);        break;
+	case C_GAMMA_CORRECT        : swprintf_s(str, count, L"%ls [0x%04X]", L"C_GAMMA_CORRECT", id);        break;
+	case C_APPLY_DISP_GAMMA     : swprintf_s(str, count, L"%ls [0x%04X]", L"C_APPLY_DISP_GAMMA", id);     break;
+	case C_APPLY_FBUF_GAMMA     : swprintf_s(str, count, L"%ls [0x%04X]", L"C_APPLY_FBUF_GAMMA", id);     break;
+	case C_APPLY_FILE_GAMMA     : swprintf_s(str, count, L"%ls [0x%04X]", L"C_APPLY_FILE_GAMMA", id);     break;
+	case C_FORCE_WIRE           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_FORCE_WIRE", id);           break;
+	case C_RAY_SHADOWS          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_RAY_SHADOWS", id);          break;
+	case C_MASTER_AMBIENT       : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MASTER_AMBIENT", id);       break;
+	case C_SUPER_SAMPLE         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SUPER_SAMPLE", id);         break;
+	case C_OBJECT_MBLUR         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_OBJECT_MBLUR", id);         break;
+	case C_MBLUR_DITHER         : swprintf_s(str, count, L"%ls [0x%04X]", L"C_MBLUR_DITHER", id);         break;
+	case C_DITHER_24            : swprintf_s(str, count, L"%ls [0x%04X]", L"C_DITHER_24", id);            break;
+	case C_SUPER_BLACK          : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SUPER_BLACK", id);          break;
+	case C_SAFE_FRAME           : swprintf_s(str, count, L"%ls [0x%04X]", L"C_SAFE_FRAME", id);           break;
+	case C_VIEW_PRES_RATIO      : swprintf_s(str, count, L"%ls [0x%04X]", L"C_VIEW_PRES_RATIO", id);      break;
+	case C_BGND_PRES_RATIO      : swprintf_s(str, count, L"%ls [0x%04X]", L"C_BGND_PRES_RATIO", id);      break;
+	case C_NTH_SERIAL_NUM       : swprintf_s(str, count, L"%ls [0x%04X]", L"C_NTH_SERIAL_NUM", id);       break;
+	case VPDATA                 : swprintf_s(str, count, L"%ls [0x%04X]", L"VPDATA", id);                 break;
+	case P_QUEUE_ENTRY          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_ENTRY", id);          break;
+	case P_QUEUE_IMAGE          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_IMAGE", id);          break;
+	case P_QUEUE_USEIGAMMA      : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_USEIGAMMA", id);      break;
+	case P_QUEUE_PROC           : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_PROC", id);           break;
+	case P_QUEUE_SOLID          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_SOLID", id);          break;
+	case P_QUEUE_GRADIENT       : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_GRADIENT", id);       break;
+	case P_QUEUE_KF             : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_KF", id);             break;
+	case P_QUEUE_MOTBLUR        : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_MOTBLUR", id);        break;
+	case P_QUEUE_MB_REPEAT      : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_MB_REPEAT", id);      break;
+	case P_QUEUE_NONE           : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_NONE", id);           break;
+	case P_QUEUE_RESIZE         : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_RESIZE", id);         break;
+	case P_QUEUE_OFFSET         : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_OFFSET", id);         break;
+	case P_QUEUE_ALIGN          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_QUEUE_ALIGN", id);          break;
+	case P_CUSTOM_SIZE          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_CUSTOM_SIZE", id);          break;
+	case P_ALPH_NONE            : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_NONE", id);            break;
+	case P_ALPH_PSEUDO          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_PSEUDO", id);          break;
+	case P_ALPH_OP_PSEUDO       : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_OP_PSEUDO", id);       break;
+	case P_ALPH_BLUR            : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_BLUR", id);            break;
+	case P_ALPH_PCOL            : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_PCOL", id);            break;
+	case P_ALPH_C0              : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_C0", id);              break;
+	case P_ALPH_OP_KEY          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_OP_KEY", id);          break;
+	case P_ALPH_KCOL            : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_KCOL", id);            break;
+	case P_ALPH_OP_NOCONV       : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_OP_NOCONV", id);       break;
+	case P_ALPH_IMAGE           : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_IMAGE", id);           break;
+	case P_ALPH_ALPHA           : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_ALPHA", id);           break;
+	case P_ALPH_QUES            : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_QUES", id);            break;
+	case P_ALPH_QUEIMG          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_QUEIMG", id);          break;
+	case P_ALPH_CUTOFF          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPH_CUTOFF", id);          break;
+	case P_ALPHANEG             : swprintf_s(str, count, L"%ls [0x%04X]", L"P_ALPHANEG", id);             break;
+	case P_TRAN_NONE            : swprintf_s(str, count, L"%ls [0x%04X]", L"P_TRAN_NONE", id);            break;
+	case P_TRAN_IMAGE           : swprintf_s(str, count, L"%ls [0x%04X]", L"P_TRAN_IMAGE", id);           break;
+	case P_TRAN_FRAMES          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_TRAN_FRAMES", id);          break;
+	case P_TRAN_FADEIN          : swprintf_s(str, count, L"%ls [0x%04X]", L"P_TRAN_FADEIN", id);          break;
+	case P_TRAN_FADEOUT         : swprintf_s(str, count, L"%ls [0x%04X]", L"P_TRAN_FADEOUT", id);         break;
+	case P_TRANNEG              : swprintf_s(str, count, L"%ls [0x%04X]", L"P_TRANNEG", id);              break;
+	case P_RANGES               : swprintf_s(str, count, L"%ls [0x%04X]", L"P_RANGES", id);               break;
+	case P_PROC_DATA            : swprintf_s(str, count, L"%ls [0x%04X]", L"P_PROC_DATA", id);            break;
+	default: swprintf_s(str, count, L"%ls[0x%04x]", L"DONT_KNOW_", id);
 	}
 
 }
@@ -4060,7 +4056,7 @@ void C3dsFile::Reset(unsigned char* buffer, wchar_t** str)
 		index += n;
 
 		*str = new wchar_t[n];
-		MultiByteToWideChar(CP_UTF8, 0, ch, -1, *str, n);
+		PlatformUtf8ToWide(ch, *str, n);
 	}
 }
 
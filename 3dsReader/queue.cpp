@@ -1,7 +1,7 @@
 
 // First In First Out Data Structure
 
-#include "framework.h"
+#include "platform.h"
 #include "queue.h"
 
 //
@@ -1,7 +1,7 @@
 
 // Last In First Out Data Structure
 
-#include "framework.h"
+#include "platform.h"
 #include "stack.h"
 
 // constructor
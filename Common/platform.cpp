@@ -0,0 +1,243 @@
+// platform.cpp : the few operating system calls used by the core library
+//
+
+#include "platform.h"
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#endif
+
+#ifdef _WIN32
+
+//
+long long PlatformGetFileSize(const wchar_t* filename)
+{
+	HANDLE handle;
+	WIN32_FIND_DATA finddata;
+
+	handle = FindFirstFile(filename, &finddata);
+	if (handle == INVALID_HANDLE_VALUE) return -1;
+	FindClose(handle);
+
+	return (long long)finddata.nFileSizeHigh * ((long long)MAXDWORD + 1) + (long long)finddata.nFileSizeLow;
+}
+
+//
+void* PlatformMapFile(const wchar_t* filename, long long* size)
+{
+	HANDLE file, mapping;
+	LARGE_INTEGER n;
+	void* address;
+
+	file = CreateFileW(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) return NULL;
+
+	// an empty file cannot be mapped
+	if (!GetFileSizeEx(file, &n) || n.QuadPart == 0) {
+		CloseHandle(file);
+		return NULL;
+	}
+
+	mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (mapping == NULL) return NULL;
+
+	// the view keeps the mapping open
+	address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (address == NULL) return NULL;
+
+	*size = n.QuadPart;
+
+	return address;
+}
+
+//
+void PlatformUnmapFile(void* address, long long /* size */)
+{
+	UnmapViewOfFile(address);
+}
+
+//
+int PlatformUtf8ToWide(const char* src, wchar_t* dst, int n)
+{
+	return MultiByteToWideChar(CP_UTF8, 0, src, -1, dst, n);
+}
+
+//
+int PlatformWideToUtf8(const wchar_t* src, char* dst, int n)
+{
+	return WideCharToMultiByte(CP_UTF8, 0, src, -1, dst, n, NULL, NULL);
+}
+
+//
+double PlatformGetTime()
+{
+	LARGE_INTEGER count, frequency;
+
+	QueryPerformanceCounter(&count);
+	QueryPerformanceFrequency(&frequency);
+
+	return (double)count.QuadPart / (double)frequency.QuadPart;
+}
+
+//
+void PlatformDebugString(const char* str)
+{
+	OutputDebugStringA(str);
+}
+
+#else
+
+//
+errno_t _wfopen_s(FILE** fp, const wchar_t* filename, const wchar_t* mode)
+{
+	char name[4 * MAX_PATH], m[16];
+
+	*fp = NULL;
+
+	if (PlatformWideToUtf8(filename, name, sizeof(name)) == 0) return EINVAL;
+	if (PlatformWideToUtf8(mode, m, sizeof(m)) == 0) return EINVAL;
+
+	*fp = fopen(name, m);
+
+	return (*fp == NULL ? errno : 0);
+}
+
+//
+long long PlatformGetFileSize(const wchar_t* filename)
+{
+	char name[4 * MAX_PATH];
+	struct stat st;
+
+	if (PlatformWideToUtf8(filename, name, sizeof(name)) == 0) return -1;
+	if (stat(name, &st) != 0) return -1;
+
+	return (long long)st.st_size;
+}
+
+//
+void* PlatformMapFile(const wchar_t* filename, long long* size)
+{
+	char name[4 * MAX_PATH];
+	struct stat st;
+	void* address;
+	int fd;
+
+	if (PlatformWideToUtf8(filename, name, sizeof(name)) == 0) return NULL;
+	if ((fd = open(name, O_RDONLY)) == -1) return NULL;
+
+	// an empty file cannot be mapped
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		return NULL;
+	}
+
+	// the mapping stays valid after the file is closed
+	address = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (address == MAP_FAILED) return NULL;
+
+	*size = (long long)st.st_size;
+
+	return address;
+}
+
+//
+void PlatformUnmapFile(void* address, long long size)
+{
+	munmap(address, (size_t)size);
+}
+
+// wchar_t holds a whole code point here, so this is a plain UTF-8 decoder
+int PlatformUtf8ToWide(const char* src, wchar_t* dst, int n)
+{
+	const unsigned char* p = (const unsigned char*)src;
+	unsigned int c;
+	int i, extra;
+
+	i = 0;
+
+	while (i < n) {
+
+		c = *p++;
+
+		if      (c < 0x80)           extra = 0;
+		else if ((c & 0xe0) == 0xc0) { extra = 1; c &= 0x1f; }
+		else if ((c & 0xf0) == 0xe0) { extra = 2; c &= 0x0f; }
+		else if ((c & 0xf8) == 0xf0) { extra = 3; c &= 0x07; }
+		else                         { extra = 0; c = 0xfffd; }
+
+		while (extra-- > 0) {
+			if ((*p & 0xc0) != 0x80) { c = 0xfffd; break; }
+			c = (c << 6) | (*p++ & 0x3f);
+		}
+
+		dst[i++] = (wchar_t)c;
+
+		if (c == 0) return i;
+	}
+
+	// not enough room
+	if (n > 0) dst[n - 1] = L'\0';
+
+	return 0;
+}
+
+//
+int PlatformWideToUtf8(const wchar_t* src, char* dst, int n)
+{
+	unsigned int c;
+	int i, len;
+
+	i = 0;
+
+	for (;;) {
+
+		c = (unsigned int)*src++;
+
+		if      (c < 0x80)    len = 1;
+		else if (c < 0x800)   len = 2;
+		else if (c < 0x10000) len = 3;
+		else                  len = 4;
+
+		if (i + len > n) break;
+
+		switch (len)
+		{
+		case 1: dst[i++] = (char)c; break;
+		case 2: dst[i++] = (char)(0xc0 | (c >> 6));  dst[i++] = (char)(0x80 | (c & 0x3f)); break;
+		case 3: dst[i++] = (char)(0xe0 | (c >> 12)); dst[i++] = (char)(0x80 | ((c >> 6) & 0x3f));  dst[i++] = (char)(0x80 | (c & 0x3f)); break;
+		case 4: dst[i++] = (char)(0xf0 | (c >> 18)); dst[i++] = (char)(0x80 | ((c >> 12) & 0x3f)); dst[i++] = (char)(0x80 | ((c >> 6) & 0x3f)); dst[i++] = (char)(0x80 | (c & 0x3f)); break;
+		}
+
+		if (c == 0) return i;
+	}
+
+	// not enough room
+	if (n > 0) dst[n - 1] = '\0';
+
+	return 0;
+}
+
+//
+double PlatformGetTime()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+//
+void PlatformDebugString(const char* str)
+{
+	fputs(str, stderr);
+}
+
+#endif
@@ -0,0 +1,156 @@
+// platform.h : include file for the platform-neutral core library
+//
+// The model, image and chunk readers were written against Win32 and the
+// MSVC secure runtime. On Windows this header just pulls in windows.h.
+// Everywhere else it supplies the few runtime functions the readers use
+// (_wfopen_s, strcpy_s, wcscpy_s, wcsncpy_s, swprintf_s, _itow_s) so that
+// their code stays the same on every platform.
+//
+// The Win32 calls that have no runtime equivalent are wrapped in the
+// Platform* functions below and implemented in platform.cpp.
+
+#pragma once
+
+#define _USE_MATH_DEFINES               // for M_PI
+
+// C RunTime Header Files
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <ctype.h>
+#include <wchar.h>
+#include <math.h>
+
+#ifdef _WIN32
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN             // Exclude rarely-used stuff from Windows headers
+#endif
+
+#include <windows.h>
+
+#else
+
+#include <errno.h>
+
+#define MAX_PATH 260
+
+typedef int errno_t;
+
+// open a file with a wide character path and mode
+errno_t _wfopen_s(FILE** fp, const wchar_t* filename, const wchar_t* mode);
+
+// copy a string, always null terminated
+inline errno_t strcpy_s(char* dst, size_t n, const char* src)
+{
+	if (dst == NULL || n == 0) return EINVAL;
+
+	strncpy(dst, src, n - 1);
+	dst[n - 1] = '\0';
+
+	return 0;
+}
+
+// copy a wide string, always null terminated
+inline errno_t wcscpy_s(wchar_t* dst, size_t n, const wchar_t* src)
+{
+	if (dst == NULL || n == 0) return EINVAL;
+
+	wcsncpy(dst, src, n - 1);
+	dst[n - 1] = L'\0';
+
+	return 0;
+}
+
+// copy at most count characters of a wide string, always null terminated
+// an empty string if they do not fit
+inline errno_t wcsncpy_s(wchar_t* dst, size_t n, const wchar_t* src, size_t count)
+{
+	size_t i;
+
+	if (dst == NULL || n == 0) return EINVAL;
+
+	for (i = 0; i < count && src[i] != L'\0'; i++) {
+		if (i + 1 == n) {
+			dst[0] = L'\0';
+			return ERANGE;
+		}
+		dst[i] = src[i];
+	}
+	dst[i] = L'\0';
+
+	return 0;
+}
+
+// formatted output to a wide string
+// use %ls for wide string arguments, it means the same thing on every compiler
+inline int swprintf_s(wchar_t* dst, size_t n, const wchar_t* format, ...)
+{
+	va_list args;
+	int result;
+
+	va_start(args, format);
+	result = vswprintf(dst, n, format, args);
+	va_end(args);
+
+	return result;
+}
+
+// convert an integer to a wide string in the given radix
+template <size_t n>
+errno_t _itow_s(int value, wchar_t (&dst)[n], int radix)
+{
+	wchar_t tmp[8 * sizeof(int) + 1];
+	unsigned int u;
+	size_t i, j;
+
+	if (radix < 2 || radix > 36) return EINVAL;
+
+	u = (value < 0 && radix == 10) ? 0u - (unsigned int)value : (unsigned int)value;
+
+	i = 0;
+	do {
+		tmp[i++] = L"0123456789abcdefghijklmnopqrstuvwxyz"[u % radix];
+		u /= radix;
+	} while (u != 0);
+
+	if (value < 0 && radix == 10) tmp[i++] = L'-';
+
+	if (i + 1 > n) return ERANGE;
+
+	for (j = 0; j < i; j++)
+		dst[j] = tmp[i - 1 - j];
+
+	dst[i] = L'\0';
+
+	return 0;
+}
+
+#endif
+
+// return the size of a file in bytes or -1 if it cannot be found
+long long PlatformGetFileSize(const wchar_t* filename);
+
+// map a whole file read-only into memory, the pages are read from the
+// disk when they are first touched and shared with other processes
+// return the address and the size in *size, or NULL if it cannot be mapped
+void* PlatformMapFile(const wchar_t* filename, long long* size);
+
+// release a file mapped by PlatformMapFile
+void PlatformUnmapFile(void* address, long long size);
+
+// convert a null terminated UTF-8 string to a wide string
+// return the number of characters written including the null
+int PlatformUtf8ToWide(const char* src, wchar_t* dst, int n);
+
+// convert a null terminated wide string to UTF-8
+// return the number of bytes written including the null
+int PlatformWideToUtf8(const wchar_t* src, char* dst, int n);
+
+// return a time in seconds from a monotonic clock
+double PlatformGetTime();
+
+// send a string to the debugger or to standard error
+void PlatformDebugString(const char* str);
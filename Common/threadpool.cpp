@@ -0,0 +1,204 @@
+/*
+   Class Name:
+
+	  CThreadPool
+
+   Description:
+
+	  run a loop over many threads
+
+*/
+
+#include "platform.h"
+#include "threadpool.h"
+
+// constructor
+CThreadPool::CThreadPool()
+{
+	thread_count = 1;
+	threads = NULL;
+	queues = NULL;
+	proc = NULL;
+	param = NULL;
+	item_count = 0;
+	block_size = 1;
+	generation = 0;
+	pending = 0;
+	quit = false;
+}
+
+// destructor
+CThreadPool::~CThreadPool()
+{
+	Destroy();
+}
+
+// start count - 1 threads, the thread calling ParallelFor is the last one
+// a count of 0 uses one thread per processor
+bool CThreadPool::Create(int count)
+{
+	int i;
+
+	Destroy();
+
+	if (count <= 0) count = (int)std::thread::hardware_concurrency();
+	if (count <= 0) count = 1;
+
+	thread_count = count;
+	queues = new QUEUE_STRUCT[count];
+	threads = new std::thread[count];
+	quit = false;
+
+	for (i = 1; i < count; i++)
+		threads[i] = std::thread(&CThreadPool::Worker, this, i);
+
+	return true;
+}
+
+// stop all threads
+void CThreadPool::Destroy()
+{
+	int i;
+
+	if (threads != NULL) {
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			quit = true;
+		}
+		start.notify_all();
+
+		for (i = 1; i < thread_count; i++)
+			threads[i].join();
+
+		delete[] threads;
+		threads = NULL;
+	}
+
+	if (queues != NULL) {
+		delete[] queues;
+		queues = NULL;
+	}
+
+	thread_count = 1;
+}
+
+// return the number of threads, including the calling thread
+int CThreadPool::GetThreadCount()
+{
+	return thread_count;
+}
+
+// Call proc(param, first, last) for blocks of about block items until all
+// count items are done, then return. Every thread starts with its own
+// share of the blocks, a thread that runs out steals from the others.
+void CThreadPool::ParallelFor(int count, int block, THREADPOOLPROC proc, void* param)
+{
+	int i, blocks;
+
+	if (count <= 0) return;
+	if (block < 1) block = 1;
+
+	blocks = (count + block - 1) / block;
+
+	// no threads or not worth it
+	if (threads == NULL || blocks == 1) {
+		proc(param, 0, count);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		this->proc = proc;
+		this->param = param;
+		item_count = count;
+		block_size = block;
+
+		// set before any block can be taken, a thread still leaving the
+		// last loop may already pick up a block of this one
+		pending = blocks;
+
+		// give every thread a run of blocks next to each other
+		for (i = 0; i < thread_count; i++) {
+			std::lock_guard<std::mutex> q(queues[i].lock);
+			queues[i].first = (int)((long long)blocks * i / thread_count);
+			queues[i].last = (int)((long long)blocks * (i + 1) / thread_count);
+		}
+
+		generation++;
+	}
+	start.notify_all();
+
+	// the calling thread works too
+	RunBlocks(0);
+
+	// wait for the blocks other threads are still running
+	std::unique_lock<std::mutex> guard(lock);
+	done.wait(guard, [this] { return pending == 0; });
+}
+
+// take the next block of our queue, or steal the last block of another
+bool CThreadPool::TakeBlock(int index, int* block)
+{
+	int i, k;
+
+	{
+		std::lock_guard<std::mutex> q(queues[index].lock);
+		if (queues[index].first < queues[index].last) {
+			*block = queues[index].first++;
+			return true;
+		}
+	}
+
+	for (i = 1; i < thread_count; i++) {
+
+		k = (index + i) % thread_count;
+
+		std::lock_guard<std::mutex> q(queues[k].lock);
+		if (queues[k].first < queues[k].last) {
+			*block = --queues[k].last;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// run blocks until there are none left
+void CThreadPool::RunBlocks(int index)
+{
+	int block, first, last;
+
+	while (TakeBlock(index, &block)) {
+
+		first = block * block_size;
+		last = first + block_size;
+		if (last > item_count) last = item_count;
+
+		proc(param, first, last);
+
+		if (--pending == 0) {
+			std::lock_guard<std::mutex> guard(lock);
+			done.notify_all();
+		}
+	}
+}
+
+// wait for a loop, help with it, and wait for the next one
+void CThreadPool::Worker(int index)
+{
+	unsigned int seen = 0;
+
+	for (;;) {
+
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			start.wait(guard, [this, seen] { return quit || generation != seen; });
+			if (quit) return;
+			seen = generation;
+		}
+
+		RunBlocks(index);
+	}
+}
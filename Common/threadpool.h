@@ -0,0 +1,62 @@
+/*
+   Class Name:
+
+	  CThreadPool
+
+   Description:
+
+	  run a loop over many threads
+
+*/
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// the work for one block of a loop, items first to last - 1
+typedef void (*THREADPOOLPROC)(void* param, int first, int last);
+
+class CThreadPool
+{
+private:
+	// the blocks a thread has not started yet, first to last - 1
+	// the owner takes from the front, others steal from the back
+	typedef struct
+	{
+		std::mutex lock;
+		int first, last;
+	}QUEUE_STRUCT;
+
+	int thread_count;
+	std::thread* threads;
+	QUEUE_STRUCT* queues;
+
+	// the loop being run
+	THREADPOOLPROC proc;
+	void* param;
+	int item_count, block_size;
+
+	std::mutex lock;
+	std::condition_variable start, done;
+	unsigned int generation;
+	std::atomic<int> pending;
+	bool quit;
+
+	void Worker(int index);
+	bool TakeBlock(int index, int* block);
+	void RunBlocks(int index);
+
+public:
+	CThreadPool();
+	~CThreadPool();
+
+	bool Create(int count);
+	void Destroy();
+
+	int GetThreadCount();
+
+	void ParallelFor(int count, int block, THREADPOOLPROC proc, void* param);
+};
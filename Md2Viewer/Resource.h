@@ -21,8 +21,12 @@
 #define IDM_POINT				121
 #define IDM_WIREFRAME			122
 #define IDM_SOLID				123
+#define IDM_TRIANGLES			124
+#define IDM_STRIPS				125
+#define IDM_NEXT_SKIN			126
 
 #define IDM_CONTROL				131
+#define IDM_PLAY				132
 
 #define IDC_STATIC1				1001
 #define IDC_TEXT1				1002
@@ -8,7 +8,7 @@
 	  position the camera
 */
 
-#include "framework.h"
+#include "platform.h"
 #include "camera.h"
 
 // constructor
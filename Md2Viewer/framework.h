@@ -15,6 +15,7 @@
 // Windows Header Files
 #include <windows.h>
 #include <commdlg.h>
+#include <windowsx.h>              // GET_X_LPARAM, GET_Y_LPARAM
 
 // C RunTime Header Files
 #include <stdlib.h>
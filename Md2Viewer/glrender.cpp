@@ -0,0 +1,159 @@
+/*
+   Class Name:
+
+	  CGlRender
+
+   Description:
+
+	  draw with fixed function OpenGL, the context must be current
+
+*/
+
+#include "platform.h"
+#include "glrender.h"
+
+#include <GL/gl.h>               // Standard opengl include.
+#include <GL/glu.h>              // Opengl utilities.
+
+// the OpenGL primitive of every RENDER_ primitive
+static const GLenum primitives[] = { GL_LINES, GL_TRIANGLES, GL_QUADS };
+
+// the OpenGL polygon mode of every RENDER_ mode
+static const GLenum modes[] = { GL_POINT, GL_LINE, GL_FILL };
+
+// constructor
+CGlRender::CGlRender()
+{
+}
+
+// destructor
+CGlRender::~CGlRender()
+{
+}
+
+//
+void CGlRender::BeginFrame(int width, int height, const float* color)
+{
+	glViewport(0, 0, width, height);
+	glClearColor(color[0], color[1], color[2], color[3]);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+// nothing to do, the caller swaps the buffers
+void CGlRender::EndFrame()
+{
+}
+
+//
+void CGlRender::SetMatrices(const float* projection, const float* modelview)
+{
+	glMatrixMode(GL_PROJECTION);
+	glLoadMatrixf(projection);
+
+	glMatrixMode(GL_MODELVIEW);
+	glLoadMatrixf(modelview);
+}
+
+//
+void CGlRender::SetPolygonMode(int mode)
+{
+	glPolygonMode(GL_FRONT_AND_BACK, modes[mode]);
+}
+
+//
+void CGlRender::SetDepthTest(bool enable)
+{
+	if (enable) glEnable(GL_DEPTH_TEST);
+	else glDisable(GL_DEPTH_TEST);
+}
+
+//
+void CGlRender::SetColor(float r, float g, float b)
+{
+	glColor3f(r, g, b);
+}
+
+// the texture is an OpenGL texture name
+void CGlRender::SetTexture(int texture)
+{
+	if (texture == 0) {
+		glDisable(GL_TEXTURE_2D);
+		return;
+	}
+
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, (GLuint)texture);
+}
+
+// upload with mipmaps
+int CGlRender::CreateTexture(int width, int height, int channels, const unsigned char* pixels)
+{
+	GLuint texture;
+
+	if (channels != 3 && channels != 4) return 0;
+
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	if (channels == 3) gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGB, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels);
+	else gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGBA, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+	return (int)texture;
+}
+
+//
+void CGlRender::DeleteTexture(int texture)
+{
+	GLuint name = (GLuint)texture;
+
+	if (texture != 0) glDeleteTextures(1, &name);
+}
+
+// point the client arrays at the vertices
+void CGlRender::SetArrays(int format, const float* vertices)
+{
+	if (format == RENDER_T2F_N3F_V3F) {
+		glInterleavedArrays(GL_T2F_N3F_V3F, 0, vertices);
+		return;
+	}
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, vertices);
+}
+
+//
+void CGlRender::ClearArrays(int format)
+{
+	if (format == RENDER_T2F_N3F_V3F) {
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		glDisableClientState(GL_NORMAL_ARRAY);
+	}
+
+	glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+//
+void CGlRender::Draw(int primitive, int format, const float* vertices, int vertex_count)
+{
+	SetArrays(format, vertices);
+	glDrawArrays(primitives[primitive], 0, vertex_count);
+	ClearArrays(format);
+}
+
+//
+void CGlRender::DrawIndexed(int primitive, int format, const float* vertices, int /* vertex_count */, const unsigned short* indices, int index_count)
+{
+	SetArrays(format, vertices);
+	glDrawElements(primitives[primitive], index_count, GL_UNSIGNED_SHORT, indices);
+	ClearArrays(format);
+}
+
+//
+void CGlRender::DrawIndexed(int primitive, int format, const float* vertices, int /* vertex_count */, const unsigned int* indices, int index_count)
+{
+	SetArrays(format, vertices);
+	glDrawElements(primitives[primitive], index_count, GL_UNSIGNED_INT, indices);
+	ClearArrays(format);
+}
@@ -0,0 +1,41 @@
+/*
+   Class Name:
+
+	  CGlRender
+
+   Description:
+
+	  draw with fixed function OpenGL, the context must be current
+
+*/
+
+#pragma once
+
+#include "render.h"
+
+class CGlRender : public CRender
+{
+private:
+	void SetArrays(int format, const float* vertices);
+	void ClearArrays(int format);
+
+public:
+	CGlRender();
+	~CGlRender();
+
+	void BeginFrame(int width, int height, const float* color);
+	void EndFrame();
+
+	void SetMatrices(const float* projection, const float* modelview);
+	void SetPolygonMode(int mode);
+	void SetDepthTest(bool enable);
+	void SetColor(float r, float g, float b);
+	void SetTexture(int texture);
+
+	int CreateTexture(int width, int height, int channels, const unsigned char* pixels);
+	void DeleteTexture(int texture);
+
+	void Draw(int primitive, int format, const float* vertices, int vertex_count);
+	void DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned short* indices, int index_count);
+	void DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned int* indices, int index_count);
+};
@@ -0,0 +1,463 @@
+/*
+   Class Name:
+
+	  CMd2Bvh
+
+   Description:
+
+	  bounding volume hierarchy over the faces of an md2 model, built
+	  once and refitted to every frame, to find what a ray hits
+
+*/
+
+#include "platform.h"
+#include "md2bvh.h"
+
+// the centers of the faces of a node are put into this many bins along
+// one axis to look for the cheapest split
+static const int BIN_COUNT = 12;
+
+// below this depth nodes are split where the surface area heuristic says,
+// deeper ones in half so the tree cannot get deeper than MD2_BVH_MAX_DEPTH
+static const int SAH_DEPTH = MD2_BVH_MAX_DEPTH / 2;
+
+// larger than any coordinate
+static const float BIG = 1e30f;
+
+// constructor
+CMd2Bvh::CMd2Bvh()
+{
+	node_count = 0;
+	nodes = NULL;
+	face_count = 0;
+	vertex_count = 0;
+	faces = NULL;
+	corners = NULL;
+	vertices = NULL;
+}
+
+// destructor
+CMd2Bvh::~CMd2Bvh()
+{
+	Free();
+}
+
+//
+void CMd2Bvh::Free()
+{
+	if (nodes != NULL) {
+		delete[] nodes;
+		nodes = NULL;
+	}
+
+	if (faces != NULL) {
+		delete[] faces;
+		faces = NULL;
+	}
+
+	if (corners != NULL) {
+		delete[] corners;
+		corners = NULL;
+	}
+
+	node_count = 0;
+	face_count = 0;
+	vertex_count = 0;
+	vertices = NULL;
+}
+
+//
+static void ClearBox(float* min, float* max)
+{
+	min[0] = min[1] = min[2] = BIG;
+	max[0] = max[1] = max[2] = -BIG;
+}
+
+//
+static void GrowBox(float* min, float* max, const float* bmin, const float* bmax)
+{
+	int k;
+
+	for (k = 0; k < 3; k++) {
+		if (bmin[k] < min[k]) min[k] = bmin[k];
+		if (bmax[k] > max[k]) max[k] = bmax[k];
+	}
+}
+
+// half the surface area of a box, 0 for an empty one
+static float GetArea(const float* min, const float* max)
+{
+	float dx, dy, dz;
+
+	dx = max[0] - min[0];
+	dy = max[1] - min[1];
+	dz = max[2] - min[2];
+
+	if (dx < 0.0f || dy < 0.0f || dz < 0.0f) return 0.0f;
+
+	return dx * dy + dy * dz + dz * dx;
+}
+
+// the bin a face center falls into
+static int GetBin(float c, float min, float extent)
+{
+	int b = (int)(BIN_COUNT * (c - min) / extent);
+
+	return (b < 0 ? 0 : (b >= BIN_COUNT ? BIN_COUNT - 1 : b));
+}
+
+// Build the tree from the shape of the first stored frame. Only the boxes
+// change from frame to frame, which keeps the tree good as long as the
+// animation moves the faces about together, as md2 animations do.
+bool CMd2Bvh::Create(CMd2File* file)
+{
+	float bin_min[BIN_COUNT][3], bin_max[BIN_COUNT][3], right_area[BIN_COUNT];
+	int bin_count[BIN_COUNT], right_count[BIN_COUNT];
+	int todo[2 * MD2_BVH_MAX_DEPTH], depth[2 * MD2_BVH_MAX_DEPTH];
+	float cmin[3], cmax[3], min[3], max[3];
+	float* box, * center;
+	const float* v;
+	const int* src;
+	float cost, best_cost, extent;
+	int i, j, k, f, n, c, d, axis, first, count, mid, best, left;
+
+	Free();
+
+	face_count = file->GetFaceCount();
+	vertex_count = file->GetVertexCount();
+
+	if (face_count == 0 || vertex_count == 0) {
+		Free();
+		return false;
+	}
+
+	v = file->GetFrameVertices(0);
+	src = file->GetCorners();
+
+	// box and center of every face
+	box = new float[6 * face_count];
+	center = new float[3 * face_count];
+
+	for (f = 0; f < face_count; f++) {
+
+		ClearBox(&box[6 * f], &box[6 * f + 3]);
+
+		for (j = 0; j < 3; j++) {
+
+			i = src[j * face_count + f];
+
+			min[0] = max[0] = v[i];
+			min[1] = max[1] = v[vertex_count + i];
+			min[2] = max[2] = v[2 * vertex_count + i];
+
+			GrowBox(&box[6 * f], &box[6 * f + 3], min, max);
+		}
+
+		for (k = 0; k < 3; k++) center[3 * f + k] = 0.5f * (box[6 * f + k] + box[6 * f + 3 + k]);
+	}
+
+	faces = new int[face_count];
+	for (f = 0; f < face_count; f++) faces[f] = f;
+
+	// a binary tree with leaves of at least one face
+	nodes = new BVH_NODE_STRUCT[2 * face_count - 1];
+	nodes[0].first = 0;
+	nodes[0].count = face_count;
+	node_count = 1;
+
+	todo[0] = 0;
+	depth[0] = 0;
+	n = 1;
+
+	while (n > 0) {
+
+		n--;
+		i = todo[n];
+		d = depth[n];
+
+		first = nodes[i].first;
+		count = nodes[i].count;
+
+		if (count <= MD2_BVH_LEAF_SIZE) continue;
+
+		// split across the longest side of the box around the centers
+		ClearBox(cmin, cmax);
+
+		for (j = first; j < first + count; j++)
+			GrowBox(cmin, cmax, &center[3 * faces[j]], &center[3 * faces[j]]);
+
+		axis = 0;
+		for (k = 1; k < 3; k++)
+			if (cmax[k] - cmin[k] > cmax[axis] - cmin[axis]) axis = k;
+
+		extent = cmax[axis] - cmin[axis];
+		mid = first;
+
+		if (extent > 0.0f && d < SAH_DEPTH) {
+
+			for (j = 0; j < BIN_COUNT; j++) {
+				bin_count[j] = 0;
+				ClearBox(bin_min[j], bin_max[j]);
+			}
+
+			for (j = first; j < first + count; j++) {
+				f = faces[j];
+				c = GetBin(center[3 * f + axis], cmin[axis], extent);
+				bin_count[c]++;
+				GrowBox(bin_min[c], bin_max[c], &box[6 * f], &box[6 * f + 3]);
+			}
+
+			// the area and count of everything right of every cut
+			ClearBox(min, max);
+
+			for (j = BIN_COUNT - 1; j > 0; j--) {
+				GrowBox(min, max, bin_min[j], bin_max[j]);
+				right_count[j] = (j < BIN_COUNT - 1 ? right_count[j + 1] : 0) + bin_count[j];
+				right_area[j] = GetArea(min, max);
+			}
+
+			// the cut with the least area times faces on both sides
+			ClearBox(min, max);
+			left = 0;
+			best = -1;
+			best_cost = BIG;
+
+			for (j = 1; j < BIN_COUNT; j++) {
+
+				GrowBox(min, max, bin_min[j - 1], bin_max[j - 1]);
+				left += bin_count[j - 1];
+
+				if (left == 0 || right_count[j] == 0) continue;
+
+				cost = GetArea(min, max) * left + right_area[j] * right_count[j];
+
+				if (cost < best_cost) {
+					best_cost = cost;
+					best = j;
+				}
+			}
+
+			// the faces left of the cut go first
+			if (best > 0) {
+				for (j = first; j < first + count; j++) {
+					f = faces[j];
+					if (GetBin(center[3 * f + axis], cmin[axis], extent) < best) {
+						faces[j] = faces[mid];
+						faces[mid++] = f;
+					}
+				}
+			}
+		}
+
+		// every center at one place, or too deep
+		if (mid == first || mid == first + count) mid = first + count / 2;
+
+		c = node_count;
+		node_count += 2;
+
+		nodes[c].first = first;
+		nodes[c].count = mid - first;
+		nodes[c + 1].first = mid;
+		nodes[c + 1].count = first + count - mid;
+
+		nodes[i].first = c;
+		nodes[i].count = 0;
+
+		todo[n] = c + 1;
+		depth[n++] = d + 1;
+		todo[n] = c;
+		depth[n++] = d + 1;
+	}
+
+	// the corners in the order of the tree, so a leaf reads them together
+	corners = new int[3 * face_count];
+
+	for (j = 0; j < face_count; j++)
+		for (k = 0; k < 3; k++) corners[3 * j + k] = src[k * face_count + faces[j]];
+
+	delete[] box;
+	delete[] center;
+
+	Refit(v);
+
+	return true;
+}
+
+// Fit the boxes to a frame or a pose, leaves first. Every child comes
+// after its parent, so going backwards through the nodes finds the
+// children of a node done. vertices holds x then y then z of every
+// vertex, as GetFrameVertices or Evaluate give it, and must stay alive
+// until the next Refit.
+void CMd2Bvh::Refit(const float* vertices)
+{
+	const float* x, * y, * z;
+	BVH_NODE_STRUCT* node;
+	int i, j, k;
+
+	this->vertices = vertices;
+
+	x = vertices;
+	y = x + vertex_count;
+	z = y + vertex_count;
+
+	for (i = node_count - 1; i >= 0; i--) {
+
+		node = &nodes[i];
+
+		if (node->count == 0) {
+			for (k = 0; k < 3; k++) {
+				node->min[k] = nodes[node->first].min[k];
+				node->max[k] = nodes[node->first].max[k];
+			}
+			GrowBox(node->min, node->max, nodes[node->first + 1].min, nodes[node->first + 1].max);
+			continue;
+		}
+
+		ClearBox(node->min, node->max);
+
+		for (j = 3 * node->first; j < 3 * (node->first + node->count); j++) {
+
+			k = corners[j];
+
+			if (x[k] < node->min[0]) node->min[0] = x[k];
+			if (x[k] > node->max[0]) node->max[0] = x[k];
+			if (y[k] < node->min[1]) node->min[1] = y[k];
+			if (y[k] > node->max[1]) node->max[1] = y[k];
+			if (z[k] < node->min[2]) node->min[2] = z[k];
+			if (z[k] > node->max[2]) node->max[2] = z[k];
+		}
+	}
+}
+
+// return where a ray enters a box, or BIG if it misses it or enters it
+// past max_t
+static float GetBoxDistance(const BVH_NODE_STRUCT* node, const float* origin, const float* inverse, float max_t)
+{
+	float t0, t1, enter, leave;
+	int k;
+
+	enter = 0.0f;
+	leave = max_t;
+
+	for (k = 0; k < 3; k++) {
+
+		t0 = (node->min[k] - origin[k]) * inverse[k];
+		t1 = (node->max[k] - origin[k]) * inverse[k];
+
+		if (t0 > t1) { float t = t0; t0 = t1; t1 = t; }
+
+		if (t0 > enter) enter = t0;
+		if (t1 < leave) leave = t1;
+	}
+
+	return (enter <= leave ? enter : BIG);
+}
+
+// Find the nearest face a ray hits, at most max_t along it (Moller and
+// Trumbore, Fast, Minimum Storage Ray/Triangle Intersection). Both sides
+// of a face are hit. direction does not have to be a unit vector, t is in
+// lengths of it. Nothing in the object is changed, so any number of
+// threads can cast rays at the same time.
+// return true if a face is hit
+bool CMd2Bvh::Intersect(const float* origin, const float* direction, float max_t, HIT_STRUCT* hit) const
+{
+	int stack[MD2_BVH_MAX_DEPTH];
+	const BVH_NODE_STRUCT* node;
+	const float* x, * y, * z;
+	float inverse[3], e1[3], e2[3], p[3], q[3], s[3];
+	float det, u, v, t, t0, t1;
+	int i, a, b, c, n;
+
+	hit->face = -1;
+	hit->t = max_t;
+	hit->u = hit->v = 0.0f;
+
+	if (node_count == 0) return false;
+
+	x = vertices;
+	y = x + vertex_count;
+	z = y + vertex_count;
+
+	inverse[0] = 1.0f / direction[0];
+	inverse[1] = 1.0f / direction[1];
+	inverse[2] = 1.0f / direction[2];
+
+	if (GetBoxDistance(&nodes[0], origin, inverse, max_t) == BIG) return false;
+
+	stack[0] = 0;
+	n = 1;
+
+	while (n > 0) {
+
+		node = &nodes[stack[--n]];
+
+		// the nearer child goes on top
+		if (node->count == 0) {
+
+			t0 = GetBoxDistance(&nodes[node->first], origin, inverse, hit->t);
+			t1 = GetBoxDistance(&nodes[node->first + 1], origin, inverse, hit->t);
+
+			if (t0 <= t1) {
+				if (t1 != BIG) stack[n++] = node->first + 1;
+				if (t0 != BIG) stack[n++] = node->first;
+			}
+			else {
+				if (t0 != BIG) stack[n++] = node->first;
+				stack[n++] = node->first + 1;
+			}
+
+			continue;
+		}
+
+		for (i = node->first; i < node->first + node->count; i++) {
+
+			a = corners[3 * i];
+			b = corners[3 * i + 1];
+			c = corners[3 * i + 2];
+
+			e1[0] = x[b] - x[a];  e1[1] = y[b] - y[a];  e1[2] = z[b] - z[a];
+			e2[0] = x[c] - x[a];  e2[1] = y[c] - y[a];  e2[2] = z[c] - z[a];
+
+			p[0] = direction[1] * e2[2] - direction[2] * e2[1];
+			p[1] = direction[2] * e2[0] - direction[0] * e2[2];
+			p[2] = direction[0] * e2[1] - direction[1] * e2[0];
+
+			// the ray runs along the face
+			det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+			if (det == 0.0f) continue;
+
+			det = 1.0f / det;
+
+			s[0] = origin[0] - x[a];
+			s[1] = origin[1] - y[a];
+			s[2] = origin[2] - z[a];
+
+			u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * det;
+			if (u < 0.0f || u > 1.0f) continue;
+
+			q[0] = s[1] * e1[2] - s[2] * e1[1];
+			q[1] = s[2] * e1[0] - s[0] * e1[2];
+			q[2] = s[0] * e1[1] - s[1] * e1[0];
+
+			v = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * det;
+			if (v < 0.0f || u + v > 1.0f) continue;
+
+			t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * det;
+
+			if (t >= 0.0f && t < hit->t) {
+				hit->face = faces[i];
+				hit->t = t;
+				hit->u = u;
+				hit->v = v;
+			}
+		}
+	}
+
+	return (hit->face != -1);
+}
+
+// return the number of nodes in the tree
+int CMd2Bvh::GetNodeCount()
+{
+	return node_count;
+}
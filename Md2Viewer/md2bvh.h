@@ -0,0 +1,68 @@
+/*
+   Class Name:
+
+	  CMd2Bvh
+
+   Description:
+
+	  bounding volume hierarchy over the faces of an md2 model, built
+	  once and refitted to every frame, to find what a ray hits
+
+*/
+
+#pragma once
+
+#include "md2file.h"
+
+// most faces in a leaf
+const int MD2_BVH_LEAF_SIZE = 4;
+
+// deepest a tree can be, Intersect keeps a stack this deep
+const int MD2_BVH_MAX_DEPTH = 64;
+
+// data structure for a node of the tree
+typedef struct
+{
+	float min[3];           // box around the faces under the node
+	float max[3];
+	int first;              // inner node - the first of its 2 children, the other follows it
+							// leaf       - its first face in the order of the tree
+	int count;              // faces of a leaf, 0 for an inner node
+}BVH_NODE_STRUCT;
+
+// data structure for where a ray hits a model
+typedef struct
+{
+	int face;               // face of the file
+	float t;                // the point is origin + t * direction
+	float u, v;             // the point is (1 - u - v) * a + u * b + v * c of the corners of the face
+}HIT_STRUCT;
+
+class CMd2Bvh
+{
+private:
+	// the nodes, node 0 is the root and children come after their parent
+	int node_count;
+	BVH_NODE_STRUCT* nodes;
+
+	// faces    - face of the file of every face, in the order of the tree
+	// corners  - 3 vertices of every face, in the order of the tree
+	// vertices - x then y then z of every vertex, from the last Refit
+	int face_count, vertex_count;
+	int* faces;
+	int* corners;
+	const float* vertices;
+
+public:
+
+	CMd2Bvh();
+	~CMd2Bvh();
+
+	bool Create(CMd2File* file);
+	void Free();
+	void Refit(const float* vertices);
+
+	bool Intersect(const float* origin, const float* direction, float max_t, HIT_STRUCT* hit) const;
+
+	int GetNodeCount();
+};
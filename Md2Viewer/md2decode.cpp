@@ -0,0 +1,767 @@
+/*
+   Function Name:
+
+	  DecodeFrame, LerpFrame, LerpNormals, MinMax, Reconstruct, FaceFacing
+
+   Description:
+
+	  expand the compressed vertices of an md2 frame into floats,
+	  blend two decoded frames, find their bounds, rebuild a frame
+	  from a mean and a basis and find the faces that face a light
+
+*/
+
+#include "platform.h"
+#include "md2decode.h"
+#include "md2normals.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DECODE_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_AVX2
+#define TARGET_SSE2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#endif
+#endif
+
+// vertices first to last - 1, one at a time
+static void DecodeRange(const FRAME_STRUCT* f, int first, int last, float* x, float* y, float* z, float* nx, float* ny, float* nz)
+{
+	const float* normal;
+	int i, k;
+
+	for (i = first; i < last; i++) {
+
+		x[i] = f->scale[0] * f->data[i].vertex[0] + f->translate[0];
+		z[i] = f->scale[1] * f->data[i].vertex[1] + f->translate[1];
+		y[i] = f->scale[2] * f->data[i].vertex[2] + f->translate[2];
+
+		// a bad index gets the first normal rather than reading past the table
+		k = f->data[i].normal;
+		normal = MD2_NORMALS[k < MD2_NORMAL_COUNT ? k : 0];
+
+		nx[i] = normal[0];
+		nz[i] = normal[1];
+		ny[i] = normal[2];
+	}
+}
+
+//
+static void DecodeFrameScalar(const FRAME_STRUCT* f, int count, float* x, float* y, float* z, float* nx, float* ny, float* nz)
+{
+	DecodeRange(f, 0, count, x, y, z, nx, ny, nz);
+}
+
+// out[i] = a[i] + t * (b[i] - a[i]), one float at a time
+static void LerpRange(const float* a, const float* b, float t, int first, int last, float* out)
+{
+	int i;
+
+	for (i = first; i < last; i++)
+		out[i] = a[i] + t * (b[i] - a[i]);
+}
+
+// blend the normals and scale them back to unit length, one at a time
+static void LerpNormalsRange(const float* a, const float* b, float t, int first, int last, int count, float* out)
+{
+	float x, y, z, len;
+	int i;
+
+	for (i = first; i < last; i++) {
+
+		x = a[i] + t * (b[i] - a[i]);
+		y = a[count + i] + t * (b[count + i] - a[count + i]);
+		z = a[2 * count + i] + t * (b[2 * count + i] - a[2 * count + i]);
+
+		len = sqrtf(x * x + y * y + z * z);
+		len = (len > 0.0f ? 1.0f / len : 0.0f);
+
+		out[i] = x * len;
+		out[count + i] = y * len;
+		out[2 * count + i] = z * len;
+	}
+}
+
+//
+static void LerpFrameScalar(const float* a, const float* b, float t, int count, float* out)
+{
+	LerpRange(a, b, t, 0, count, out);
+}
+
+// smallest and largest of floats first to last - 1, one at a time
+static void MinMaxRange(const float* v, int first, int last, float* min, float* max)
+{
+	int i;
+
+	for (i = first; i < last; i++) {
+		if (v[i] < *min) *min = v[i];
+		if (v[i] > *max) *max = v[i];
+	}
+}
+
+//
+static void MinMaxScalar(const float* v, int count, float* min, float* max)
+{
+	*min = 1e30f;
+	*max = -1e30f;
+
+	MinMaxRange(v, 0, count, min, max);
+}
+
+// out[j] = mean[j] + sum of c[i] * basis[i * count + j], one float at a time
+static void ReconstructRange(const float* mean, const short* basis, const float* c, int k, int first, int last, int count, float* out)
+{
+	float sum;
+	int i, j;
+
+	for (j = first; j < last; j++) {
+
+		sum = mean[j];
+
+		for (i = 0; i < k; i++)
+			sum += c[i] * (float)basis[(size_t)i * count + j];
+
+		out[j] = sum;
+	}
+}
+
+//
+static void ReconstructScalar(const float* mean, const short* basis, const float* c, int k, int count, float* out)
+{
+	ReconstructRange(mean, basis, c, k, 0, count, count, out);
+}
+
+//
+static void LerpNormalsScalar(const float* a, const float* b, float t, int count, float* out)
+{
+	LerpNormalsRange(a, b, t, 0, count, count, out);
+}
+
+// faces first to last - 1, one at a time
+// the SIMD versions do the same operations in the same order, so all agree
+static void FaceFacingRange(const float* x, const float* y, const float* z, const int* corners, int first, int last, int count, const float* light, unsigned char* facing)
+{
+	float ax, ay, az, ux, uy, uz, vx, vy, vz, nx, ny, nz;
+	int i, a, b, c;
+
+	for (i = first; i < last; i++) {
+
+		a = corners[i];
+		b = corners[count + i];
+		c = corners[2 * count + i];
+
+		ax = x[a];
+		ay = y[a];
+		az = z[a];
+
+		ux = x[b] - ax;  uy = y[b] - ay;  uz = z[b] - az;
+		vx = x[c] - ax;  vy = y[c] - ay;  vz = z[c] - az;
+
+		nx = uy * vz - uz * vy;
+		ny = uz * vx - ux * vz;
+		nz = ux * vy - uy * vx;
+
+		ax = light[0] - light[3] * ax;
+		ay = light[1] - light[3] * ay;
+		az = light[2] - light[3] * az;
+
+		facing[i] = (nx * ax + ny * ay + nz * az > 0.0f);
+	}
+}
+
+//
+static void FaceFacingScalar(const float* x, const float* y, const float* z, const int* corners, int count, const float* light, unsigned char* facing)
+{
+	FaceFacingRange(x, y, z, corners, 0, count, count, light, facing);
+}
+
+#ifdef DECODE_X86
+
+// A vertex is 4 bytes, so one 32-bit lane holds one vertex:
+//
+//     bit 31      24 23      16 15       8 7        0
+//        +----------+----------+----------+----------+
+//        |  normal  | vertex 2 | vertex 1 | vertex 0 |
+//        +----------+----------+----------+----------+
+//
+// Shift and mask each lane to get a component, convert to float,
+// then scale and translate 4 (SSE2) or 8 (AVX2) vertices at once.
+
+// 4 vertices at a time
+// SSE2 has no gather, so the normals are looked up one by one
+TARGET_SSE2 static void DecodeFrameSSE2(const FRAME_STRUCT* f, int count, float* x, float* y, float* z, float* nx, float* ny, float* nz)
+{
+	__m128i v, mask;
+	__m128 s0, s1, s2, t0, t1, t2;
+	const float* normal;
+	int i, j, k;
+
+	mask = _mm_set1_epi32(0xff);
+
+	s0 = _mm_set1_ps(f->scale[0]);  t0 = _mm_set1_ps(f->translate[0]);
+	s1 = _mm_set1_ps(f->scale[1]);  t1 = _mm_set1_ps(f->translate[1]);
+	s2 = _mm_set1_ps(f->scale[2]);  t2 = _mm_set1_ps(f->translate[2]);
+
+	for (i = 0; i + 4 <= count; i += 4) {
+
+		v = _mm_loadu_si128((const __m128i*)&f->data[i]);
+
+		_mm_storeu_ps(&x[i], _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(v, mask)), s0), t0));
+		_mm_storeu_ps(&z[i], _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 8), mask)), s1), t1));
+		_mm_storeu_ps(&y[i], _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 16), mask)), s2), t2));
+
+		for (j = i; j < i + 4; j++) {
+			k = f->data[j].normal;
+			normal = MD2_NORMALS[k < MD2_NORMAL_COUNT ? k : 0];
+			nx[j] = normal[0];
+			nz[j] = normal[1];
+			ny[j] = normal[2];
+		}
+	}
+
+	// the remaining vertices
+	DecodeRange(f, i, count, x, y, z, nx, ny, nz);
+}
+
+// 8 vertices at a time
+// the normals are gathered straight from the table, 3 floats per entry
+TARGET_AVX2 static void DecodeFrameAVX2(const FRAME_STRUCT* f, int count, float* x, float* y, float* z, float* nx, float* ny, float* nz)
+{
+	__m256i v, mask, last, k;
+	__m256 s0, s1, s2, t0, t1, t2;
+	const float* table = &MD2_NORMALS[0][0];
+	int i;
+
+	mask = _mm256_set1_epi32(0xff);
+	last = _mm256_set1_epi32(MD2_NORMAL_COUNT);
+
+	s0 = _mm256_set1_ps(f->scale[0]);  t0 = _mm256_set1_ps(f->translate[0]);
+	s1 = _mm256_set1_ps(f->scale[1]);  t1 = _mm256_set1_ps(f->translate[1]);
+	s2 = _mm256_set1_ps(f->scale[2]);  t2 = _mm256_set1_ps(f->translate[2]);
+
+	for (i = 0; i + 8 <= count; i += 8) {
+
+		v = _mm256_loadu_si256((const __m256i*)&f->data[i]);
+
+		_mm256_storeu_ps(&x[i], _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(v, mask)), s0), t0));
+		_mm256_storeu_ps(&z[i], _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, 8), mask)), s1), t1));
+		_mm256_storeu_ps(&y[i], _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(v, 16), mask)), s2), t2));
+
+		// index into the table, a bad index gets the first normal
+		k = _mm256_srli_epi32(v, 24);
+		k = _mm256_and_si256(k, _mm256_cmpgt_epi32(last, k));
+		k = _mm256_add_epi32(k, _mm256_add_epi32(k, k));
+
+		_mm256_storeu_ps(&nx[i], _mm256_i32gather_ps(table, k, 4));
+		_mm256_storeu_ps(&nz[i], _mm256_i32gather_ps(table + 1, k, 4));
+		_mm256_storeu_ps(&ny[i], _mm256_i32gather_ps(table + 2, k, 4));
+	}
+
+	// the remaining vertices
+	DecodeRange(f, i, count, x, y, z, nx, ny, nz);
+}
+
+// 4 floats at a time
+TARGET_SSE2 static void LerpFrameSSE2(const float* a, const float* b, float t, int count, float* out)
+{
+	__m128 va, vt;
+	int i;
+
+	vt = _mm_set1_ps(t);
+
+	for (i = 0; i + 4 <= count; i += 4) {
+		va = _mm_loadu_ps(&a[i]);
+		_mm_storeu_ps(&out[i], _mm_add_ps(va, _mm_mul_ps(vt, _mm_sub_ps(_mm_loadu_ps(&b[i]), va))));
+	}
+
+	LerpRange(a, b, t, i, count, out);
+}
+
+// 4 normals at a time
+TARGET_SSE2 static void LerpNormalsSSE2(const float* a, const float* b, float t, int count, float* out)
+{
+	__m128 x, y, z, len, vt, zero;
+	const float* ay, * az, * by, * bz;
+	float* oy, * oz;
+	int i;
+
+	ay = a + count;  az = ay + count;
+	by = b + count;  bz = by + count;
+	oy = out + count;  oz = oy + count;
+
+	vt = _mm_set1_ps(t);
+	zero = _mm_setzero_ps();
+
+	for (i = 0; i + 4 <= count; i += 4) {
+
+		x = _mm_loadu_ps(&a[i]);   x = _mm_add_ps(x, _mm_mul_ps(vt, _mm_sub_ps(_mm_loadu_ps(&b[i]), x)));
+		y = _mm_loadu_ps(&ay[i]);  y = _mm_add_ps(y, _mm_mul_ps(vt, _mm_sub_ps(_mm_loadu_ps(&by[i]), y)));
+		z = _mm_loadu_ps(&az[i]);  z = _mm_add_ps(z, _mm_mul_ps(vt, _mm_sub_ps(_mm_loadu_ps(&bz[i]), z)));
+
+		len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+		len = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), len), _mm_cmpgt_ps(len, zero));
+
+		_mm_storeu_ps(&out[i], _mm_mul_ps(x, len));
+		_mm_storeu_ps(&oy[i], _mm_mul_ps(y, len));
+		_mm_storeu_ps(&oz[i], _mm_mul_ps(z, len));
+	}
+
+	LerpNormalsRange(a, b, t, i, count, count, out);
+}
+
+// 8 floats at a time
+TARGET_AVX2 static void LerpFrameAVX2(const float* a, const float* b, float t, int count, float* out)
+{
+	__m256 va, vt;
+	int i;
+
+	vt = _mm256_set1_ps(t);
+
+	for (i = 0; i + 8 <= count; i += 8) {
+		va = _mm256_loadu_ps(&a[i]);
+		_mm256_storeu_ps(&out[i], _mm256_add_ps(va, _mm256_mul_ps(vt, _mm256_sub_ps(_mm256_loadu_ps(&b[i]), va))));
+	}
+
+	LerpRange(a, b, t, i, count, out);
+}
+
+// 8 normals at a time
+TARGET_AVX2 static void LerpNormalsAVX2(const float* a, const float* b, float t, int count, float* out)
+{
+	__m256 x, y, z, len, vt, zero;
+	const float* ay, * az, * by, * bz;
+	float* oy, * oz;
+	int i;
+
+	ay = a + count;  az = ay + count;
+	by = b + count;  bz = by + count;
+	oy = out + count;  oz = oy + count;
+
+	vt = _mm256_set1_ps(t);
+	zero = _mm256_setzero_ps();
+
+	for (i = 0; i + 8 <= count; i += 8) {
+
+		x = _mm256_loadu_ps(&a[i]);   x = _mm256_add_ps(x, _mm256_mul_ps(vt, _mm256_sub_ps(_mm256_loadu_ps(&b[i]), x)));
+		y = _mm256_loadu_ps(&ay[i]);  y = _mm256_add_ps(y, _mm256_mul_ps(vt, _mm256_sub_ps(_mm256_loadu_ps(&by[i]), y)));
+		z = _mm256_loadu_ps(&az[i]);  z = _mm256_add_ps(z, _mm256_mul_ps(vt, _mm256_sub_ps(_mm256_loadu_ps(&bz[i]), z)));
+
+		len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+		len = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(1.0f), len), _mm256_cmp_ps(len, zero, _CMP_GT_OQ));
+
+		_mm256_storeu_ps(&out[i], _mm256_mul_ps(x, len));
+		_mm256_storeu_ps(&oy[i], _mm256_mul_ps(y, len));
+		_mm256_storeu_ps(&oz[i], _mm256_mul_ps(z, len));
+	}
+
+	LerpNormalsRange(a, b, t, i, count, count, out);
+}
+
+// 4 floats at a time, then the 4 lanes are folded into one
+TARGET_SSE2 static void MinMaxSSE2(const float* v, int count, float* min, float* max)
+{
+	__m128 lo, hi, x;
+	int i;
+
+	lo = _mm_set1_ps(1e30f);
+	hi = _mm_set1_ps(-1e30f);
+
+	for (i = 0; i + 4 <= count; i += 4) {
+		x = _mm_loadu_ps(&v[i]);
+		lo = _mm_min_ps(lo, x);
+		hi = _mm_max_ps(hi, x);
+	}
+
+	lo = _mm_min_ps(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(1, 0, 3, 2)));
+	lo = _mm_min_ps(lo, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(2, 3, 0, 1)));
+	hi = _mm_max_ps(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(1, 0, 3, 2)));
+	hi = _mm_max_ps(hi, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(2, 3, 0, 1)));
+
+	*min = _mm_cvtss_f32(lo);
+	*max = _mm_cvtss_f32(hi);
+
+	MinMaxRange(v, i, count, min, max);
+}
+
+// 8 floats at a time
+TARGET_AVX2 static void MinMaxAVX2(const float* v, int count, float* min, float* max)
+{
+	__m256 lo, hi, x;
+	__m128 l, h;
+	int i;
+
+	lo = _mm256_set1_ps(1e30f);
+	hi = _mm256_set1_ps(-1e30f);
+
+	for (i = 0; i + 8 <= count; i += 8) {
+		x = _mm256_loadu_ps(&v[i]);
+		lo = _mm256_min_ps(lo, x);
+		hi = _mm256_max_ps(hi, x);
+	}
+
+	l = _mm_min_ps(_mm256_castps256_ps128(lo), _mm256_extractf128_ps(lo, 1));
+	h = _mm_max_ps(_mm256_castps256_ps128(hi), _mm256_extractf128_ps(hi, 1));
+
+	l = _mm_min_ps(l, _mm_shuffle_ps(l, l, _MM_SHUFFLE(1, 0, 3, 2)));
+	l = _mm_min_ps(l, _mm_shuffle_ps(l, l, _MM_SHUFFLE(2, 3, 0, 1)));
+	h = _mm_max_ps(h, _mm_shuffle_ps(h, h, _MM_SHUFFLE(1, 0, 3, 2)));
+	h = _mm_max_ps(h, _mm_shuffle_ps(h, h, _MM_SHUFFLE(2, 3, 0, 1)));
+
+	*min = _mm_cvtss_f32(l);
+	*max = _mm_cvtss_f32(h);
+
+	MinMaxRange(v, i, count, min, max);
+}
+
+// 4 floats at a time, 4 blocks of them at once so that every row of the
+// basis is read with 4 independent sums, the shorts of a row are widened
+// to ints by putting them in the high half and shifting back down
+TARGET_SSE2 static void ReconstructSSE2(const float* mean, const short* basis, const float* c, int k, int count, float* out)
+{
+	__m128 s0, s1, s2, s3, ci;
+	__m128i a, b;
+	const short* row;
+	int i, j;
+
+	for (j = 0; j + 16 <= count; j += 16) {
+
+		s0 = _mm_loadu_ps(&mean[j]);
+		s1 = _mm_loadu_ps(&mean[j + 4]);
+		s2 = _mm_loadu_ps(&mean[j + 8]);
+		s3 = _mm_loadu_ps(&mean[j + 12]);
+
+		for (i = 0; i < k; i++) {
+			ci = _mm_set1_ps(c[i]);
+			row = &basis[(size_t)i * count + j];
+			a = _mm_loadu_si128((const __m128i*)row);
+			b = _mm_loadu_si128((const __m128i*)(row + 8));
+			s0 = _mm_add_ps(s0, _mm_mul_ps(ci, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16))));
+			s1 = _mm_add_ps(s1, _mm_mul_ps(ci, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(a, a), 16))));
+			s2 = _mm_add_ps(s2, _mm_mul_ps(ci, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(b, b), 16))));
+			s3 = _mm_add_ps(s3, _mm_mul_ps(ci, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(b, b), 16))));
+		}
+
+		_mm_storeu_ps(&out[j], s0);
+		_mm_storeu_ps(&out[j + 4], s1);
+		_mm_storeu_ps(&out[j + 8], s2);
+		_mm_storeu_ps(&out[j + 12], s3);
+	}
+
+	ReconstructRange(mean, basis, c, k, j, count, count, out);
+}
+
+// 8 floats at a time, 4 blocks of them at once
+TARGET_AVX2 static void ReconstructAVX2(const float* mean, const short* basis, const float* c, int k, int count, float* out)
+{
+	__m256 s0, s1, s2, s3, ci;
+	const short* row;
+	int i, j;
+
+	for (j = 0; j + 32 <= count; j += 32) {
+
+		s0 = _mm256_loadu_ps(&mean[j]);
+		s1 = _mm256_loadu_ps(&mean[j + 8]);
+		s2 = _mm256_loadu_ps(&mean[j + 16]);
+		s3 = _mm256_loadu_ps(&mean[j + 24]);
+
+		for (i = 0; i < k; i++) {
+			ci = _mm256_set1_ps(c[i]);
+			row = &basis[(size_t)i * count + j];
+			s0 = _mm256_add_ps(s0, _mm256_mul_ps(ci, _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)row)))));
+			s1 = _mm256_add_ps(s1, _mm256_mul_ps(ci, _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(row + 8))))));
+			s2 = _mm256_add_ps(s2, _mm256_mul_ps(ci, _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(row + 16))))));
+			s3 = _mm256_add_ps(s3, _mm256_mul_ps(ci, _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(row + 24))))));
+		}
+
+		_mm256_storeu_ps(&out[j], s0);
+		_mm256_storeu_ps(&out[j + 8], s1);
+		_mm256_storeu_ps(&out[j + 16], s2);
+		_mm256_storeu_ps(&out[j + 24], s3);
+	}
+
+	ReconstructRange(mean, basis, c, k, j, count, count, out);
+}
+
+// 4 faces at a time
+// SSE2 has no gather, so the corners are loaded one by one
+TARGET_SSE2 static void FaceFacingSSE2(const float* x, const float* y, const float* z, const int* corners, int count, const float* light, unsigned char* facing)
+{
+	__m128 ax, ay, az, ux, uy, uz, vx, vy, vz, nx, ny, nz, d;
+	const int* a, * b, * c;
+	int i, j, mask;
+
+	a = corners;
+	b = corners + count;
+	c = corners + 2 * count;
+
+	for (i = 0; i + 4 <= count; i += 4) {
+
+		ax = _mm_setr_ps(x[a[i]], x[a[i + 1]], x[a[i + 2]], x[a[i + 3]]);
+		ay = _mm_setr_ps(y[a[i]], y[a[i + 1]], y[a[i + 2]], y[a[i + 3]]);
+		az = _mm_setr_ps(z[a[i]], z[a[i + 1]], z[a[i + 2]], z[a[i + 3]]);
+
+		ux = _mm_sub_ps(_mm_setr_ps(x[b[i]], x[b[i + 1]], x[b[i + 2]], x[b[i + 3]]), ax);
+		uy = _mm_sub_ps(_mm_setr_ps(y[b[i]], y[b[i + 1]], y[b[i + 2]], y[b[i + 3]]), ay);
+		uz = _mm_sub_ps(_mm_setr_ps(z[b[i]], z[b[i + 1]], z[b[i + 2]], z[b[i + 3]]), az);
+		vx = _mm_sub_ps(_mm_setr_ps(x[c[i]], x[c[i + 1]], x[c[i + 2]], x[c[i + 3]]), ax);
+		vy = _mm_sub_ps(_mm_setr_ps(y[c[i]], y[c[i + 1]], y[c[i + 2]], y[c[i + 3]]), ay);
+		vz = _mm_sub_ps(_mm_setr_ps(z[c[i]], z[c[i + 1]], z[c[i + 2]], z[c[i + 3]]), az);
+
+		nx = _mm_sub_ps(_mm_mul_ps(uy, vz), _mm_mul_ps(uz, vy));
+		ny = _mm_sub_ps(_mm_mul_ps(uz, vx), _mm_mul_ps(ux, vz));
+		nz = _mm_sub_ps(_mm_mul_ps(ux, vy), _mm_mul_ps(uy, vx));
+
+		ax = _mm_sub_ps(_mm_set1_ps(light[0]), _mm_mul_ps(_mm_set1_ps(light[3]), ax));
+		ay = _mm_sub_ps(_mm_set1_ps(light[1]), _mm_mul_ps(_mm_set1_ps(light[3]), ay));
+		az = _mm_sub_ps(_mm_set1_ps(light[2]), _mm_mul_ps(_mm_set1_ps(light[3]), az));
+
+		d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, ax), _mm_mul_ps(ny, ay)), _mm_mul_ps(nz, az));
+		mask = _mm_movemask_ps(_mm_cmpgt_ps(d, _mm_setzero_ps()));
+
+		for (j = 0; j < 4; j++) facing[i + j] = (unsigned char)((mask >> j) & 1);
+	}
+
+	FaceFacingRange(x, y, z, corners, i, count, count, light, facing);
+}
+
+// 8 faces at a time, the corners are gathered
+TARGET_AVX2 static void FaceFacingAVX2(const float* x, const float* y, const float* z, const int* corners, int count, const float* light, unsigned char* facing)
+{
+	__m256 ax, ay, az, ux, uy, uz, vx, vy, vz, nx, ny, nz, d, lw;
+	__m256i a, b, c;
+	int i, j, mask;
+
+	lw = _mm256_set1_ps(light[3]);
+
+	for (i = 0; i + 8 <= count; i += 8) {
+
+		a = _mm256_loadu_si256((const __m256i*)&corners[i]);
+		b = _mm256_loadu_si256((const __m256i*)&corners[count + i]);
+		c = _mm256_loadu_si256((const __m256i*)&corners[2 * count + i]);
+
+		ax = _mm256_i32gather_ps(x, a, 4);
+		ay = _mm256_i32gather_ps(y, a, 4);
+		az = _mm256_i32gather_ps(z, a, 4);
+
+		ux = _mm256_sub_ps(_mm256_i32gather_ps(x, b, 4), ax);
+		uy = _mm256_sub_ps(_mm256_i32gather_ps(y, b, 4), ay);
+		uz = _mm256_sub_ps(_mm256_i32gather_ps(z, b, 4), az);
+		vx = _mm256_sub_ps(_mm256_i32gather_ps(x, c, 4), ax);
+		vy = _mm256_sub_ps(_mm256_i32gather_ps(y, c, 4), ay);
+		vz = _mm256_sub_ps(_mm256_i32gather_ps(z, c, 4), az);
+
+		nx = _mm256_sub_ps(_mm256_mul_ps(uy, vz), _mm256_mul_ps(uz, vy));
+		ny = _mm256_sub_ps(_mm256_mul_ps(uz, vx), _mm256_mul_ps(ux, vz));
+		nz = _mm256_sub_ps(_mm256_mul_ps(ux, vy), _mm256_mul_ps(uy, vx));
+
+		ax = _mm256_sub_ps(_mm256_set1_ps(light[0]), _mm256_mul_ps(lw, ax));
+		ay = _mm256_sub_ps(_mm256_set1_ps(light[1]), _mm256_mul_ps(lw, ay));
+		az = _mm256_sub_ps(_mm256_set1_ps(light[2]), _mm256_mul_ps(lw, az));
+
+		d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, ax), _mm256_mul_ps(ny, ay)), _mm256_mul_ps(nz, az));
+		mask = _mm256_movemask_ps(_mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GT_OQ));
+
+		for (j = 0; j < 8; j++) facing[i + j] = (unsigned char)((mask >> j) & 1);
+	}
+
+	FaceFacingRange(x, y, z, corners, i, count, count, light, facing);
+}
+
+// ask the cpu which instruction sets it has
+static bool HasInstructionSet(int kind)
+{
+#ifdef _MSC_VER
+	int info[4];
+
+	__cpuid(info, 0);
+	if (info[0] < 7) return (kind == DECODE_SSE2);
+
+	__cpuid(info, 1);
+	if (kind == DECODE_SSE2) return (info[3] & (1 << 26)) != 0;
+
+	// the os must save the ymm registers
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+	if ((_xgetbv(0) & 6) != 6) return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+
+	switch (kind)
+	{
+	case DECODE_SSE2: return __builtin_cpu_supports("sse2");
+	case DECODE_AVX2: return __builtin_cpu_supports("avx2");
+	}
+
+	return false;
+#endif
+}
+
+#endif
+
+//
+DECODEFRAMEPROC GetDecodeFrameProc(int kind)
+{
+	switch (kind)
+	{
+	case DECODE_SCALAR: return DecodeFrameScalar;
+#ifdef DECODE_X86
+	case DECODE_SSE2: return HasInstructionSet(DECODE_SSE2) ? DecodeFrameSSE2 : NULL;
+	case DECODE_AVX2: return HasInstructionSet(DECODE_AVX2) ? DecodeFrameAVX2 : NULL;
+#endif
+	}
+
+	return NULL;
+}
+
+//
+LERPFRAMEPROC GetLerpFrameProc(int kind)
+{
+	switch (kind)
+	{
+	case DECODE_SCALAR: return LerpFrameScalar;
+#ifdef DECODE_X86
+	case DECODE_SSE2: return HasInstructionSet(DECODE_SSE2) ? LerpFrameSSE2 : NULL;
+	case DECODE_AVX2: return HasInstructionSet(DECODE_AVX2) ? LerpFrameAVX2 : NULL;
+#endif
+	}
+
+	return NULL;
+}
+
+//
+LERPFRAMEPROC GetLerpNormalsProc(int kind)
+{
+	switch (kind)
+	{
+	case DECODE_SCALAR: return LerpNormalsScalar;
+#ifdef DECODE_X86
+	case DECODE_SSE2: return HasInstructionSet(DECODE_SSE2) ? LerpNormalsSSE2 : NULL;
+	case DECODE_AVX2: return HasInstructionSet(DECODE_AVX2) ? LerpNormalsAVX2 : NULL;
+#endif
+	}
+
+	return NULL;
+}
+
+//
+MINMAXPROC GetMinMaxProc(int kind)
+{
+	switch (kind)
+	{
+	case DECODE_SCALAR: return MinMaxScalar;
+#ifdef DECODE_X86
+	case DECODE_SSE2: return HasInstructionSet(DECODE_SSE2) ? MinMaxSSE2 : NULL;
+	case DECODE_AVX2: return HasInstructionSet(DECODE_AVX2) ? MinMaxAVX2 : NULL;
+#endif
+	}
+
+	return NULL;
+}
+
+//
+RECONSTRUCTPROC GetReconstructProc(int kind)
+{
+	switch (kind)
+	{
+	case DECODE_SCALAR: return ReconstructScalar;
+#ifdef DECODE_X86
+	case DECODE_SSE2: return HasInstructionSet(DECODE_SSE2) ? ReconstructSSE2 : NULL;
+	case DECODE_AVX2: return HasInstructionSet(DECODE_AVX2) ? ReconstructAVX2 : NULL;
+#endif
+	}
+
+	return NULL;
+}
+
+//
+FACINGPROC GetFaceFacingProc(int kind)
+{
+	switch (kind)
+	{
+	case DECODE_SCALAR: return FaceFacingScalar;
+#ifdef DECODE_X86
+	case DECODE_SSE2: return HasInstructionSet(DECODE_SSE2) ? FaceFacingSSE2 : NULL;
+	case DECODE_AVX2: return HasInstructionSet(DECODE_AVX2) ? FaceFacingAVX2 : NULL;
+#endif
+	}
+
+	return NULL;
+}
+
+//
+const char* GetDecodeFrameName(int kind)
+{
+	switch (kind)
+	{
+	case DECODE_SCALAR: return "scalar";
+	case DECODE_SSE2:   return "sse2";
+	case DECODE_AVX2:   return "avx2";
+	}
+
+	return "unknown";
+}
+
+//
+int GetDecodeFrameKind()
+{
+	int kind;
+
+	for (kind = DECODE_COUNT - 1; kind > DECODE_SCALAR; kind--)
+		if (GetDecodeFrameProc(kind) != NULL) break;
+
+	return kind;
+}
+
+//
+void DecodeFrame(const FRAME_STRUCT* f, int count, float* x, float* y, float* z, float* nx, float* ny, float* nz)
+{
+	static const DECODEFRAMEPROC proc = GetDecodeFrameProc(GetDecodeFrameKind());
+
+	proc(f, count, x, y, z, nx, ny, nz);
+}
+
+//
+void LerpFrame(const float* a, const float* b, float t, int count, float* out)
+{
+	static const LERPFRAMEPROC proc = GetLerpFrameProc(GetDecodeFrameKind());
+
+	proc(a, b, t, count, out);
+}
+
+//
+void LerpNormals(const float* a, const float* b, float t, int count, float* out)
+{
+	static const LERPFRAMEPROC proc = GetLerpNormalsProc(GetDecodeFrameKind());
+
+	proc(a, b, t, count, out);
+}
+
+//
+void MinMax(const float* v, int count, float* min, float* max)
+{
+	static const MINMAXPROC proc = GetMinMaxProc(GetDecodeFrameKind());
+
+	proc(v, count, min, max);
+}
+
+//
+void Reconstruct(const float* mean, const short* basis, const float* c, int k, int count, float* out)
+{
+	static const RECONSTRUCTPROC proc = GetReconstructProc(GetDecodeFrameKind());
+
+	proc(mean, basis, c, k, count, out);
+}
+
+//
+void FaceFacing(const float* x, const float* y, const float* z, const int* corners, int count, const float* light, unsigned char* facing)
+{
+	static const FACINGPROC proc = GetFaceFacingProc(GetDecodeFrameKind());
+
+	proc(x, y, z, corners, count, light, facing);
+}
@@ -0,0 +1,81 @@
+/*
+   Function Name:
+
+	  DecodeFrame, LerpFrame, LerpNormals, MinMax, Reconstruct, FaceFacing
+
+   Description:
+
+	  expand the compressed vertices of an md2 frame into floats,
+	  blend two decoded frames, find their bounds, rebuild a frame
+	  from a mean and a basis and find the faces that face a light
+
+*/
+
+#pragma once
+
+#include "md2file.h"
+
+// instruction sets the decoder can use
+enum
+{
+	DECODE_SCALAR,
+	DECODE_SSE2,
+	DECODE_AVX2,
+	DECODE_COUNT
+};
+
+// decode count vertices of frame f
+// x[i]  = scale[0] * vertex[0] + translate[0]
+// y[i]  = scale[2] * vertex[2] + translate[2]     (y and z swapped to make the model standing up)
+// z[i]  = scale[1] * vertex[1] + translate[1]
+// nx[i] = MD2_NORMALS[normal][0]
+// ny[i] = MD2_NORMALS[normal][2]                  (swapped the same way)
+// nz[i] = MD2_NORMALS[normal][1]
+typedef void (*DECODEFRAMEPROC)(const FRAME_STRUCT* f, int count, float* x, float* y, float* z, float* nx, float* ny, float* nz);
+
+// blend count floats of two decoded frames
+// out[i] = a[i] + t * (b[i] - a[i])
+//
+// for LerpNormals a, b and out each hold an array of count x, then y, then z
+// and the blended normals are scaled back to unit length
+typedef void (*LERPFRAMEPROC)(const float* a, const float* b, float t, int count, float* out);
+
+// find the smallest and the largest of count floats
+// count 0 gives *min = 1e30 and *max = -1e30
+typedef void (*MINMAXPROC)(const float* v, int count, float* min, float* max);
+
+// rebuild count floats from a mean and k rows of count shorts of a basis,
+// c holds the scale of every row
+// out[j] = mean[j] + c[0] * basis[j] + ... + c[k - 1] * basis[(k - 1) * count + j]
+typedef void (*RECONSTRUCTPROC)(const float* mean, const short* basis, const float* c, int k, int count, float* out);
+
+// find which of count faces face a light
+// corners holds the vertex of every corner, all first corners, then all
+// second, then all third, and light is x, y, z, w: a point if w is 1 and
+// the direction toward the light if w is 0
+// n         = (b - a) x (c - a)
+// facing[i] = n . (light.xyz - light.w * a) > 0
+typedef void (*FACINGPROC)(const float* x, const float* y, const float* z, const int* corners, int count, const float* light, unsigned char* facing);
+
+// return the code for an instruction set, or NULL if this cpu does not have it
+DECODEFRAMEPROC GetDecodeFrameProc(int kind);
+LERPFRAMEPROC GetLerpFrameProc(int kind);
+LERPFRAMEPROC GetLerpNormalsProc(int kind);
+MINMAXPROC GetMinMaxProc(int kind);
+RECONSTRUCTPROC GetReconstructProc(int kind);
+FACINGPROC GetFaceFacingProc(int kind);
+
+// return the name of an instruction set
+const char* GetDecodeFrameName(int kind);
+
+// return the fastest instruction set this cpu has
+int GetDecodeFrameKind();
+
+// decode, blend, find bounds, rebuild or find facing faces with the fastest
+// code, chosen once on the first call
+void DecodeFrame(const FRAME_STRUCT* f, int count, float* x, float* y, float* z, float* nx, float* ny, float* nz);
+void LerpFrame(const float* a, const float* b, float t, int count, float* out);
+void LerpNormals(const float* a, const float* b, float t, int count, float* out);
+void MinMax(const float* v, int count, float* min, float* max);
+void Reconstruct(const float* mean, const short* basis, const float* c, int k, int count, float* out);
+void FaceFacing(const float* x, const float* y, const float* z, const int* corners, int count, const float* light, unsigned char* facing);
@@ -9,137 +9,1980 @@
 
 */
 
-#include "framework.h"
+#include "platform.h"
 #include "md2file.h"
+#include "md2decode.h"
+#include "md2order.h"
+#include "threadpool.h"
 
 // constructor
 CMd2File::CMd2File()
 {
 	buffer = NULL;
+	buffer_size = 0;
+	buffer_mapped = false;
+	header = NULL;
+	frame = NULL;
+	face = NULL;
+	st = NULL;
+	mesh_optimized = false;
+	vertices = NULL;
+	normals = NULL;
+	texcoords = NULL;
+	mesh_vertex_count = 0;
+	mesh_vertex = NULL;
+	mesh_texcoords = NULL;
+	mesh_indices = NULL;
+	command_count = 0;
+	command_vertex_count = 0;
+	commands = NULL;
+	command_vertex = NULL;
+	command_texcoords = NULL;
+	clip_count = 0;
+	clip_table_size = 0;
+	clips = NULL;
+	clip_table = NULL;
+	bounds = NULL;
+	key_count = 0;
+	keys = NULL;
+	key_index = NULL;
+	current = NULL;
+	adjacency = NULL;
+	corners = NULL;
 }
 
 // destructor
 CMd2File::~CMd2File()
 {
+	Free();
+}
+
+// release the file and the decoded frames
+// the arrays of a cooked file point into the file and are not deleted
+void CMd2File::Free()
+{
+	// the normals are in the same block as the vertices
+	if (vertices != NULL) {
+		if (!IsView(vertices)) delete[] vertices;
+		vertices = NULL;
+	}
+
+	normals = NULL;
+
+	if (texcoords != NULL) {
+		if (!IsView(texcoords)) delete[] texcoords;
+		texcoords = NULL;
+	}
+
+	if (mesh_vertex != NULL) {
+		if (!IsView(mesh_vertex)) delete[] mesh_vertex;
+		mesh_vertex = NULL;
+	}
+
+	if (mesh_texcoords != NULL) {
+		if (!IsView(mesh_texcoords)) delete[] mesh_texcoords;
+		mesh_texcoords = NULL;
+	}
+
+	if (mesh_indices != NULL) {
+		if (!IsView(mesh_indices)) delete[] mesh_indices;
+		mesh_indices = NULL;
+	}
+
+	mesh_vertex_count = 0;
+
+	if (commands != NULL) {
+		if (!IsView(commands)) delete[] commands;
+		commands = NULL;
+	}
+
+	if (command_vertex != NULL) {
+		if (!IsView(command_vertex)) delete[] command_vertex;
+		command_vertex = NULL;
+	}
+
+	if (command_texcoords != NULL) {
+		if (!IsView(command_texcoords)) delete[] command_texcoords;
+		command_texcoords = NULL;
+	}
+
+	command_count = 0;
+	command_vertex_count = 0;
+
+	if (clips != NULL) {
+		if (!IsView(clips)) delete[] clips;
+		clips = NULL;
+	}
+
+	if (clip_table != NULL) {
+		if (!IsView(clip_table)) delete[] clip_table;
+		clip_table = NULL;
+	}
+
+	clip_count = 0;
+	clip_table_size = 0;
+
+	if (bounds != NULL) {
+		if (!IsView(bounds)) delete[] bounds;
+		bounds = NULL;
+	}
+
+	if (keys != NULL) {
+		if (!IsView(keys)) delete[] keys;
+		keys = NULL;
+	}
+
+	if (key_index != NULL) {
+		if (!IsView(key_index)) delete[] key_index;
+		key_index = NULL;
+	}
+
+	if (current != NULL) {
+		delete[] current;
+		current = NULL;
+	}
+
+	key_count = 0;
+
+	if (adjacency != NULL) {
+		if (!IsView(adjacency)) delete[] adjacency;
+		adjacency = NULL;
+	}
+
+	if (corners != NULL) {
+		if (!IsView(corners)) delete[] corners;
+		corners = NULL;
+	}
+
 	if (buffer != NULL) {
-		delete[] buffer;
+		if (buffer_mapped) PlatformUnmapFile(buffer, buffer_size);
+		else delete[] buffer;
 		buffer = NULL;
 	}
+
+	// these point into the file
+	header = NULL;
+	frame = NULL;
+	face = NULL;
+	st = NULL;
+
+	mesh_optimized = false;
+
+	buffer_size = 0;
+	buffer_mapped = false;
 }
 
-//
-bool CMd2File::Open(wchar_t* filename)
+// return true if p points into the file
+bool CMd2File::IsView(const void* p)
+{
+	return (buffer != NULL && (const unsigned char*)p >= buffer && (const unsigned char*)p < buffer + buffer_size);
+}
+
+// read a whole file into memory
+// return the buffer and the size in *size, or NULL
+static unsigned char* ReadWholeFile(wchar_t* filename, long long* size)
 {
 	FILE* fp;
 	errno_t err;
-	char id[4];
+	unsigned char* p;
 	long n;
 
 	// open file
 	if ((err = _wfopen_s(&fp, filename, L"rb")) != 0)
-		return false;
-
-	// read id
-	if (fread(id, sizeof(char), 4, fp) != 4) {
-		fclose(fp);
-		return false;
-	}
-
-	// check if a file is a MD2 file
-	if (!(id[0] == 'I' && id[1] == 'D' && id[2] == 'P' && id[3] == '2')) {
-		fclose(fp);
-		return false;
-	}
+		return NULL;
 
 	// get file size
 	fseek(fp, 0, SEEK_END);
 	n = ftell(fp);
 	fseek(fp, 0, SEEK_SET);
 
-	// allocate memory
-	if (buffer != NULL) delete[] buffer;
-	buffer = new unsigned char[n];
+	if (n <= 0) {
+		fclose(fp);
+		return NULL;
+	}
 
-	// error checking
-	if (!buffer) return false;
+	// allocate memory
+	p = new unsigned char[n];
 
 	// read the whole file
-	if (fread(buffer, sizeof(unsigned char), n, fp) != n) {
+	if (fread(p, sizeof(unsigned char), n, fp) != (size_t)n) {
+		delete[] p;
 		fclose(fp);
+		return NULL;
+	}
+
+	fclose(fp);
+
+	*size = n;
+
+	return p;
+}
+
+// return true if the bytes at offset are inside a file of n bytes
+static bool IsInside(long long n, int offset, long long bytes)
+{
+	return (offset >= 0 && bytes >= 0 && offset + bytes <= n);
+}
+
+// return true if the bytes at offset are inside a file of n bytes
+// and start on a 16 byte boundary
+static bool IsSection(long long n, int offset, long long bytes)
+{
+	return (offset > 0 && offset % 16 == 0 && IsInside(n, offset, bytes));
+}
+
+// return true if the counts of an md2 header are not negative and every
+// section it points to is inside a file of n bytes
+static bool IsHeaderInside(const MD2FILEHEADER* h, long long n)
+{
+	return (h->vertex_count > 0 && h->frame_count > 0 && h->texture_image_count >= 0 &&
+		h->texture_count >= 0 && h->face_count >= 0 && h->cmd_count >= 0 &&
+		IsInside(n, h->texture_name_offset, (long long)MD2_SKIN_NAME_SIZE * h->texture_image_count) &&
+		IsInside(n, h->texture_offset, (long long)sizeof(TEXTURE_STRUCT) * h->texture_count) &&
+		IsInside(n, h->face_offset, (long long)sizeof(FACE_STRUCT) * h->face_count) &&
+		IsInside(n, h->frame_offset, (long long)h->framesize * h->frame_count) &&
+		IsInside(n, h->cmd_offset, 4LL * h->cmd_count));
+}
+
+// Open an md2 file or a cooked file made by Cook. With map the file is
+// mapped into memory instead of read, so opening costs no copy, the file
+// pages are shared by every process that opens the same model and the
+// system can drop them again once the frames are decoded. The file is
+// read when it cannot be mapped.
+bool CMd2File::Open(wchar_t* filename, bool map)
+{
+	unsigned char* p;
+	long long n;
+	bool mapped, cooked;
+
+	p = NULL;
+	mapped = false;
+
+	if (map && (p = (unsigned char*)PlatformMapFile(filename, &n)) != NULL)
+		mapped = true;
+
+	if (p == NULL && (p = ReadWholeFile(filename, &n)) == NULL)
+		return false;
+
+	// check if a file is a MD2 file or a cooked one
+	cooked = (n >= (long long)sizeof(MD2CFILEHEADER) && p[0] == 'M' && p[1] == 'D' && p[2] == '2' && p[3] == 'C');
+
+	if (!cooked && (n < (long long)sizeof(MD2FILEHEADER) || !(p[0] == 'I' && p[1] == 'D' && p[2] == 'P' && p[3] == '2'))) {
+		if (mapped) PlatformUnmapFile(p, n);
+		else delete[] p;
 		return false;
 	}
 
-	// initialize variables
-	header = (MD2FILEHEADER*)buffer;
-	face = (FACE_STRUCT*)&buffer[header->face_offset];
-	st = (TEXTURE_STRUCT*)&buffer[header->texture_offset];
+	// release the old model
+	Free();
+	buffer = p;
+	buffer_size = n;
+	buffer_mapped = mapped;
+
+	if (cooked) {
+
+		// everything is in the file already
+		if (!OpenCooked()) {
+			Free();
+			return false;
+		}
+	}
+	else {
+
+		// initialize variables
+		header = (MD2FILEHEADER*)buffer;
+
+		if (!IsHeaderInside(header, n)) {
+			Free();
+			return false;
+		}
+
+		face = (FACE_STRUCT*)&buffer[header->face_offset];
+		st = (TEXTURE_STRUCT*)&buffer[header->texture_offset];
+
+		// decode all frames and texture coordinates
+		if (!DecodeFrames()) {
+			Free();
+			return false;
+		}
+
+		DecodeTexCoords();
+
+		// share the vertices between faces
+		if (!BuildMesh()) {
+			Free();
+			return false;
+		}
+
+		// read the triangle strips and fans
+		ReadCommands((long)n);
+
+		// group the frames into animations
+		BuildClips();
+
+		// box and sphere of every frame
+		ComputeBounds();
+
+		// the faces across the edges
+		BuildAdjacency();
+	}
 
 	// go to first frame
 	SetFrame(0);
 
-	// close file
-	fclose(fp);
-
 	return true;
 }
 
-// set the frame with index index
-void CMd2File::SetFrame(int index)
+// Point the arrays into a cooked file. Only the compressed frames of a
+// quantized file are decoded, everything else is used as it is.
+bool CMd2File::OpenCooked()
 {
-	frame = (FRAME_STRUCT*)&buffer[header->frame_offset + header->framesize * index];
+	MD2CFILEHEADER* ch;
+	long long n, vc, fc;
+	int i, k;
+
+	ch = (MD2CFILEHEADER*)buffer;
+
+	if (ch->version != MD2C_VERSION || ch->size > buffer_size) return false;
+
+	n = ch->size;
+
+	if (!IsSection(n, ch->md2_offset, sizeof(MD2FILEHEADER))) return false;
+
+	header = (MD2FILEHEADER*)&buffer[ch->md2_offset];
+
+	vc = header->vertex_count;
+	fc = header->frame_count;
+
+	if (vc <= 0 || fc <= 0 || header->texture_image_count < 0 || header->texture_count < 0 || header->face_count < 0 ||
+		ch->mesh_vertex_count < 0 || ch->command_count < 0 || ch->command_vertex_count < 0 ||
+		ch->clip_count < 0 || ch->clip_table_size <= 0 || ch->key_count < 0) return false;
+
+	if (
+		!IsSection(n, header->texture_name_offset, (long long)MD2_SKIN_NAME_SIZE * header->texture_image_count) ||
+		!IsSection(n, header->face_offset, (long long)sizeof(FACE_STRUCT) * header->face_count) ||
+		!IsSection(n, ch->texcoord_offset, 8LL * header->texture_count) ||
+		!IsSection(n, ch->mesh_vertex_offset, 2LL * ch->mesh_vertex_count) ||
+		!IsSection(n, ch->mesh_texcoord_offset, 8LL * ch->mesh_vertex_count) ||
+		!IsSection(n, ch->mesh_index_offset, 6LL * header->face_count) ||
+		!IsSection(n, ch->clip_offset, (long long)sizeof(CLIP_STRUCT) * ch->clip_count) ||
+		!IsSection(n, ch->clip_table_offset, 4LL * ch->clip_table_size) ||
+		!IsSection(n, ch->bounds_offset, (long long)sizeof(BOUNDS_STRUCT) * fc) ||
+		!IsSection(n, ch->adjacency_offset, 12LL * header->face_count) ||
+		!IsSection(n, ch->corner_offset, 12LL * header->face_count)) return false;
+
+	// a model without strips and fans has no command sections
+	if (ch->command_count > 0 &&
+		(!IsSection(n, ch->command_offset, (long long)sizeof(COMMAND_STRUCT) * ch->command_count) ||
+		!IsSection(n, ch->command_vertex_offset, 2LL * ch->command_vertex_count) ||
+		!IsSection(n, ch->command_texcoord_offset, 8LL * ch->command_vertex_count))) return false;
+
+	face = (FACE_STRUCT*)&buffer[header->face_offset];
+	st = NULL;
+	texcoords = (float*)&buffer[ch->texcoord_offset];
+
+	mesh_vertex_count = ch->mesh_vertex_count;
+	mesh_vertex = (unsigned short*)&buffer[ch->mesh_vertex_offset];
+	mesh_texcoords = (float*)&buffer[ch->mesh_texcoord_offset];
+	mesh_indices = (unsigned short*)&buffer[ch->mesh_index_offset];
+
+	if (ch->command_count > 0) {
+		command_count = ch->command_count;
+		command_vertex_count = ch->command_vertex_count;
+		commands = (COMMAND_STRUCT*)&buffer[ch->command_offset];
+		command_vertex = (unsigned short*)&buffer[ch->command_vertex_offset];
+		command_texcoords = (float*)&buffer[ch->command_texcoord_offset];
+	}
+
+	clip_count = ch->clip_count;
+	clip_table_size = ch->clip_table_size;
+	clips = (CLIP_STRUCT*)&buffer[ch->clip_offset];
+	clip_table = (int*)&buffer[ch->clip_table_offset];
+	bounds = (BOUNDS_STRUCT*)&buffer[ch->bounds_offset];
+	adjacency = (int*)&buffer[ch->adjacency_offset];
+	corners = (int*)&buffer[ch->corner_offset];
+
+	// the sections are inside the file, the indices in them must be too
+	if (!IsCookedValid()) return false;
+
+	mesh_optimized = ((ch->flags & MD2C_OPTIMIZED) != 0);
+
+	if (ch->flags & MD2C_QUANTIZED) {
+
+		if (header->framesize < (int)sizeof(FRAME_STRUCT) ||
+			!IsSection(n, header->frame_offset, (long long)header->framesize * fc)) return false;
+
+		return DecodeFrames();
+	}
+
+	// a reduced model stores only the kept frames
+	if (ch->key_count > 0) {
+
+		if (ch->key_count > fc ||
+			!IsSection(n, ch->key_offset, 4LL * ch->key_count) ||
+			!IsSection(n, ch->key_index_offset, 4LL * fc)) return false;
+
+		key_count = ch->key_count;
+		keys = (int*)&buffer[ch->key_offset];
+		key_index = (int*)&buffer[ch->key_index_offset];
+
+		// the kept frames go up from the first frame to the last one, and
+		// every frame points at the last kept frame at or before it
+		if (keys[0] != 0 || keys[key_count - 1] != fc - 1) return false;
+
+		for (i = 1; i < key_count; i++)
+			if (keys[i] <= keys[i - 1] || keys[i] >= fc) return false;
+
+		for (i = 0, k = 0; i < fc; i++) {
+			if (k + 1 < key_count && keys[k + 1] == i) k++;
+			if (key_index[i] != k) return false;
+		}
+
+		current = new float[6 * vc];
+		fc = key_count;
+	}
+
+	if (!IsSection(n, ch->vertex_offset, 12LL * vc * fc) ||
+		!IsSection(n, ch->normal_offset, 12LL * vc * fc)) return false;
+
+	vertices = (float*)&buffer[ch->vertex_offset];
+	normals = (float*)&buffer[ch->normal_offset];
+
+	return true;
 }
 
-// return the number of triangles in the model
-int CMd2File::GetFaceCount()
+// Check every index a cooked file holds, so that a damaged file cannot
+// make the drawing and animation read outside the arrays.
+// return false if one points outside what it indexes
+bool CMd2File::IsCookedValid()
 {
-	return (buffer == NULL ? 0 : header->face_count);
+	int i, j, vc, fc;
+
+	vc = header->vertex_count;
+	fc = header->frame_count;
+
+	for (i = 0; i < header->face_count; i++)
+		for (j = 0; j < 3; j++)
+			if (face[i].VertexIndex[j] >= vc || face[i].TextureIndex[j] >= header->texture_count) return false;
+
+	for (i = 0; i < 3 * header->face_count; i++)
+		if (mesh_indices[i] >= mesh_vertex_count) return false;
+
+	// the face across every edge, -1 if none, and the vertex of every corner
+	for (i = 0; i < 3 * header->face_count; i++)
+		if (adjacency[i] < -1 || adjacency[i] >= header->face_count || corners[i] < 0 || corners[i] >= vc) return false;
+
+	for (i = 0; i < mesh_vertex_count; i++)
+		if (mesh_vertex[i] >= vc) return false;
+
+	for (i = 0; i < command_count; i++)
+		if (commands[i].first < 0 || commands[i].count < 0 || commands[i].first > command_vertex_count - commands[i].count) return false;
+
+	for (i = 0; i < command_vertex_count; i++)
+		if (command_vertex[i] >= vc) return false;
+
+	for (i = 0; i < clip_count; i++)
+		if (memchr(clips[i].name, '\0', sizeof(clips[i].name)) == NULL ||
+			clips[i].first < 0 || clips[i].count < 1 || clips[i].first > fc - clips[i].count) return false;
+
+	// the hash table is a power of 2 with at least one empty slot, so a
+	// name that is not there ends the search
+	if ((clip_table_size & (clip_table_size - 1)) != 0) return false;
+
+	for (i = 0, j = 0; i < clip_table_size; i++) {
+		if (clip_table[i] < -1 || clip_table[i] >= clip_count) return false;
+		if (clip_table[i] == -1) j++;
+	}
+
+	return (j > 0);
 }
 
-// return the number of frames of animation
-int CMd2File::GetFrameCount()
+// reserve bytes at the end of a cooked file of *size bytes
+// return the offset, the next section starts on a 16 byte boundary
+static int AddSection(long long* size, long long bytes)
 {
-	return header->frame_count;
+	int offset = (int)*size;
+
+	*size = (*size + bytes + 15) & ~15LL;
+
+	return offset;
 }
 
-// return the name of a texture file for the model
-void CMd2File::GetTextureName(char* str, size_t n)
+// Write the model as a cooked file (.md2c) that Open can use without
+// decoding, welding or parsing anything. With quantized the compressed
+// frames of the md2 file are kept instead of the decoded floats, which
+// makes the file about 5 times smaller but costs a decode when opened.
+// A cooked file without compressed frames or a model reduced by Reduce
+// cannot be cooked quantized.
+bool CMd2File::Cook(wchar_t* filename, bool quantized)
 {
-	char* p;
+	MD2CFILEHEADER ch;
+	MD2FILEHEADER mh;
+	unsigned char* p;
+	FILE* fp;
+	errno_t err;
+	long long size, vc, fc, stored;
+	bool ok;
+
+	if (buffer == NULL || (quantized && (GetFrame(0) == NULL || keys != NULL))) return false;
+
+	vc = header->vertex_count;
+	fc = header->frame_count;
+	stored = GetKeyCount();
+
+	memset(&ch, 0, sizeof(ch));
+	memcpy(&mh, header, sizeof(mh));
 
-	p = (char*)&buffer[header->texture_name_offset];
-	strcpy_s(str, n, p);
+	memcpy(ch.id, "MD2C", 4);
+	ch.version = MD2C_VERSION;
+	ch.flags = (quantized ? MD2C_QUANTIZED : 0) | (mesh_optimized ? MD2C_OPTIMIZED : 0);
+
+	// lay out the file, the md2 header gets the offsets of its sections
+	// in the cooked file, the st and command sections are not needed
+	size = 0;
+	AddSection(&size, sizeof(ch));
+
+	ch.md2_offset = AddSection(&size, sizeof(mh));
+	mh.texture_name_offset = AddSection(&size, (long long)MD2_SKIN_NAME_SIZE * header->texture_image_count);
+	mh.face_offset = AddSection(&size, (long long)sizeof(FACE_STRUCT) * header->face_count);
+	mh.texture_offset = 0;
+	mh.cmd_offset = 0;
+	mh.cmd_count = 0;
+
+	if (quantized) {
+		mh.frame_offset = AddSection(&size, (long long)header->framesize * fc);
+	}
+	else {
+		mh.frame_offset = 0;
+		mh.framesize = 0;
+		ch.vertex_offset = AddSection(&size, 12 * vc * stored);
+		ch.normal_offset = AddSection(&size, 12 * vc * stored);
+	}
+
+	if (keys != NULL) {
+		ch.key_count = key_count;
+		ch.key_offset = AddSection(&size, 4LL * key_count);
+		ch.key_index_offset = AddSection(&size, 4 * fc);
+	}
+
+	ch.texcoord_offset = AddSection(&size, 8LL * header->texture_count);
+
+	ch.mesh_vertex_count = mesh_vertex_count;
+	ch.mesh_vertex_offset = AddSection(&size, 2LL * mesh_vertex_count);
+	ch.mesh_texcoord_offset = AddSection(&size, 8LL * mesh_vertex_count);
+	ch.mesh_index_offset = AddSection(&size, 6LL * header->face_count);
+
+	if (command_count > 0) {
+		ch.command_count = command_count;
+		ch.command_vertex_count = command_vertex_count;
+		ch.command_offset = AddSection(&size, (long long)sizeof(COMMAND_STRUCT) * command_count);
+		ch.command_vertex_offset = AddSection(&size, 2LL * command_vertex_count);
+		ch.command_texcoord_offset = AddSection(&size, 8LL * command_vertex_count);
+	}
+
+	ch.clip_count = clip_count;
+	ch.clip_table_size = clip_table_size;
+	ch.clip_offset = AddSection(&size, (long long)sizeof(CLIP_STRUCT) * clip_count);
+	ch.clip_table_offset = AddSection(&size, 4LL * clip_table_size);
+	ch.bounds_offset = AddSection(&size, (long long)sizeof(BOUNDS_STRUCT) * fc);
+	ch.adjacency_offset = AddSection(&size, 12LL * header->face_count);
+	ch.corner_offset = AddSection(&size, 12LL * header->face_count);
+
+	// the offsets are ints
+	if (size > 0x7fffffff) return false;
+
+	ch.size = (int)size;
+	mh.end_offset = (int)size;
+
+	// fill the file, the gaps between sections are zero
+	p = new unsigned char[size];
+	memset(p, 0, (size_t)size);
+
+	memcpy(p, &ch, sizeof(ch));
+	memcpy(&p[ch.md2_offset], &mh, sizeof(mh));
+	memcpy(&p[mh.texture_name_offset], &buffer[header->texture_name_offset], MD2_SKIN_NAME_SIZE * header->texture_image_count);
+	memcpy(&p[mh.face_offset], face, sizeof(FACE_STRUCT) * header->face_count);
+
+	if (quantized) {
+		memcpy(&p[mh.frame_offset], GetFrame(0), (size_t)header->framesize * fc);
+	}
+	else {
+		memcpy(&p[ch.vertex_offset], vertices, (size_t)(12 * vc * stored));
+		memcpy(&p[ch.normal_offset], normals, (size_t)(12 * vc * stored));
+	}
+
+	if (keys != NULL) {
+		memcpy(&p[ch.key_offset], keys, 4 * key_count);
+		memcpy(&p[ch.key_index_offset], key_index, (size_t)(4 * fc));
+	}
+
+	memcpy(&p[ch.texcoord_offset], texcoords, 8 * header->texture_count);
+	memcpy(&p[ch.mesh_vertex_offset], mesh_vertex, 2 * mesh_vertex_count);
+	memcpy(&p[ch.mesh_texcoord_offset], mesh_texcoords, 8 * mesh_vertex_count);
+	memcpy(&p[ch.mesh_index_offset], mesh_indices, 6 * header->face_count);
+
+	if (command_count > 0) {
+		memcpy(&p[ch.command_offset], commands, sizeof(COMMAND_STRUCT) * command_count);
+		memcpy(&p[ch.command_vertex_offset], command_vertex, 2 * command_vertex_count);
+		memcpy(&p[ch.command_texcoord_offset], command_texcoords, 8 * command_vertex_count);
+	}
+
+	memcpy(&p[ch.clip_offset], clips, sizeof(CLIP_STRUCT) * clip_count);
+	memcpy(&p[ch.clip_table_offset], clip_table, 4 * clip_table_size);
+	memcpy(&p[ch.bounds_offset], bounds, sizeof(BOUNDS_STRUCT) * fc);
+	memcpy(&p[ch.adjacency_offset], adjacency, 12 * header->face_count);
+	memcpy(&p[ch.corner_offset], corners, 12 * header->face_count);
+
+	// write the file
+	if ((err = _wfopen_s(&fp, filename, L"wb")) != 0) {
+		delete[] p;
+		return false;
+	}
+
+	ok = (fwrite(p, sizeof(unsigned char), (size_t)size, fp) == (size_t)size);
+	ok = (fclose(fp) == 0) && ok;
+
+	delete[] p;
+
+	return ok;
 }
 
-// return the data we need to draw the model
+// Expand the compressed vertices of every frame into floats, so that
+// drawing a frame does not decode anything.
 // we swap the y and z to make the model standing up
-MD2_STRUCT& CMd2File::operator[](int i)
+// return false if the frames are not all inside the file
+bool CMd2File::DecodeFrames()
+{
+	FRAME_STRUCT* f;
+	float* px, * py, * pz, * pnx, * pny, * pnz;
+	int i, vc;
+
+	vc = header->vertex_count;
+
+	// a frame is the scale, the translation and the name, then 4 bytes
+	// for every vertex
+	if (vc <= 0 || header->frame_count <= 0 || header->frame_offset < 0 ||
+		header->framesize < (long long)offsetof(FRAME_STRUCT, data) + 4LL * vc ||
+		header->frame_offset + (long long)header->framesize * header->frame_count > buffer_size) return false;
+
+	// one block, the normals of all frames follow the vertices, with two
+	// blocks the writes to both fall on the same page offsets and decoding
+	// gets several times slower
+	vertices = new float[6 * vc * header->frame_count];
+	normals = vertices + 3 * vc * header->frame_count;
+
+	for (i = 0; i < header->frame_count; i++) {
+
+		f = GetFrame(i);
+
+		px = &vertices[3 * vc * i];
+		py = px + vc;
+		pz = py + vc;
+		pnx = &normals[3 * vc * i];
+		pny = pnx + vc;
+		pnz = pny + vc;
+
+		DecodeFrame(f, vc, px, py, pz, pnx, pny, pnz);
+	}
+
+	return true;
+}
+
+// divide the texture coordinates by the texture size
+void CMd2File::DecodeTexCoords()
+{
+	int i;
+
+	texcoords = new float[2 * header->texture_count];
+
+	for (i = 0; i < header->texture_count; i++) {
+		texcoords[2 * i] = (float)st[i].s / (float)header->texture_width;
+		texcoords[2 * i + 1] = (float)st[i].t / (float)header->texture_height;
+	}
+}
+
+// Find the box and the sphere of a frame. The sphere is centered on the
+// box and reaches the farthest vertex, which is tighter than the sphere
+// around the box.
+static void GetFrameBox(const float* px, const float* py, const float* pz, int vc, BOUNDS_STRUCT* b)
+{
+	float dx, dy, dz, d, r;
+	int j;
+
+	MinMax(px, vc, &b->min[0], &b->max[0]);
+	MinMax(py, vc, &b->min[1], &b->max[1]);
+	MinMax(pz, vc, &b->min[2], &b->max[2]);
+
+	b->center[0] = 0.5f * (b->min[0] + b->max[0]);
+	b->center[1] = 0.5f * (b->min[1] + b->max[1]);
+	b->center[2] = 0.5f * (b->min[2] + b->max[2]);
+
+	r = 0.0f;
+
+	for (j = 0; j < vc; j++) {
+		dx = px[j] - b->center[0];
+		dy = py[j] - b->center[1];
+		dz = pz[j] - b->center[2];
+		d = dx * dx + dy * dy + dz * dz;
+		if (d > r) r = d;
+	}
+
+	b->radius = sqrtf(r);
+}
+
+// find the box and the sphere of every frame
+void CMd2File::ComputeBounds()
+{
+	const float* p;
+	int i, vc;
+
+	vc = header->vertex_count;
+
+	bounds = new BOUNDS_STRUCT[header->frame_count];
+
+	for (i = 0; i < header->frame_count; i++) {
+		p = &vertices[3 * vc * i];
+		GetFrameBox(p, p + vc, p + 2 * vc, vc, &bounds[i]);
+	}
+}
+
+// A face uses one index for the position and another for the texture
+// coordinate, so the same corner can appear with different texture
+// coordinates. Give every different (vertex, texture) pair its own mesh
+// vertex and describe the faces with 16-bit indices into them.
+// return false if a corner is not in the file or there are too many pairs
+bool CMd2File::BuildMesh()
+{
+	unsigned int key, h, size, mask;
+	unsigned int* keys;
+	int* table;
+	int i, j, k, count;
+
+	count = 3 * header->face_count;
+
+	// open addressing hash table, at most half full
+	size = 16;
+	while (size < 2 * (unsigned int)count) size *= 2;
+	mask = size - 1;
+
+	table = new int[size];
+	for (h = 0; h < size; h++) table[h] = -1;
+
+	keys = new unsigned int[count];
+	mesh_vertex = new unsigned short[count];
+	mesh_texcoords = new float[2 * count];
+	mesh_indices = new unsigned short[count];
+	mesh_vertex_count = 0;
+
+	for (i = 0; i < header->face_count; i++) {
+		for (j = 0; j < 3; j++) {
+
+			// a corner that is not a vertex or texture coordinate of the file
+			if (face[i].VertexIndex[j] >= header->vertex_count || face[i].TextureIndex[j] >= header->texture_count) {
+				delete[] table;
+				delete[] keys;
+				return false;
+			}
+
+			key = ((unsigned int)face[i].VertexIndex[j] << 16) | face[i].TextureIndex[j];
+
+			// look for the pair, add it if it is new
+			h = (key * 2654435761u) & mask;
+
+			while ((k = table[h]) != -1 && keys[k] != key)
+				h = (h + 1) & mask;
+
+			if (k == -1) {
+
+				// more than 16-bit indices can address
+				if (mesh_vertex_count > 0xffff) {
+					delete[] table;
+					delete[] keys;
+					return false;
+				}
+
+				k = mesh_vertex_count++;
+				table[h] = k;
+				keys[k] = key;
+
+				mesh_vertex[k] = face[i].VertexIndex[j];
+				mesh_texcoords[2 * k] = texcoords[2 * face[i].TextureIndex[j]];
+				mesh_texcoords[2 * k + 1] = texcoords[2 * face[i].TextureIndex[j] + 1];
+			}
+
+			mesh_indices[3 * i + j] = (unsigned short)k;
+		}
+	}
+
+	delete[] table;
+	delete[] keys;
+
+	return true;
+}
+
+// return true if two vertices are at the same place in every stored frame
+static bool IsSameVertex(const float* v, int vc, int frames, int a, int b)
+{
+	int i;
+
+	for (i = 0; i < 3 * frames; i++, v += vc)
+		if (v[a] != v[b]) return false;
+
+	return true;
+}
+
+// Find the face across every edge. The vertices are welded first, a
+// vertex that is at the same place as another one in every frame is
+// the same vertex, so a seam the modeller left in the mesh does not cut
+// it. Then every edge looks for the edge that goes the other way between
+// the same two vertices. An edge used by more than two faces is paired
+// with the first face found and is a border for the others, an edge
+// used twice the same way is a border for both.
+void CMd2File::BuildAdjacency()
 {
-	data.s1 = (float)st[face[i].TextureIndex[0]].s / (float)header->texture_width;
-	data.t1 = (float)st[face[i].TextureIndex[0]].t / (float)header->texture_height;
+	unsigned int key, h, size, mask, bits[3];
+	unsigned int* keys;
+	int* table, * weld, * next;
+	int i, j, k, a, b, vc, count, frames;
+
+	vc = header->vertex_count;
+	count = 3 * header->face_count;
+	frames = GetKeyCount();
+
+	corners = new int[count];
+	adjacency = new int[count];
+
+	for (i = 0; i < header->face_count; i++)
+		for (j = 0; j < 3; j++) corners[j * header->face_count + i] = face[i].VertexIndex[j];
 
-	data.s2 = (float)st[face[i].TextureIndex[1]].s / (float)header->texture_width;
-	data.t2 = (float)st[face[i].TextureIndex[1]].t / (float)header->texture_height;
+	// weld the vertices, hashed by where they are in the first frame
+	size = 16;
+	while (size < 2 * (unsigned int)vc || size < 2 * (unsigned int)count) size *= 2;
+	mask = size - 1;
 
-	data.s3 = (float)st[face[i].TextureIndex[2]].s / (float)header->texture_width;
-	data.t3 = (float)st[face[i].TextureIndex[2]].t / (float)header->texture_height;
+	table = new int[size];
+	weld = new int[vc];
 
-	data.nx = frame->data[face[i].VertexIndex[0]].normal;
-	data.nz = frame->data[face[i].VertexIndex[1]].normal;
-	data.ny = frame->data[face[i].VertexIndex[2]].normal;
+	for (h = 0; h < size; h++) table[h] = -1;
 
-	data.x1 = frame->scale[0] * frame->data[face[i].VertexIndex[0]].vertex[0] + frame->translate[0];
-	data.z1 = frame->scale[1] * frame->data[face[i].VertexIndex[0]].vertex[1] + frame->translate[1];
-	data.y1 = frame->scale[2] * frame->data[face[i].VertexIndex[0]].vertex[2] + frame->translate[2];
+	for (i = 0; i < vc; i++) {
 
-	data.x2 = frame->scale[0] * frame->data[face[i].VertexIndex[1]].vertex[0] + frame->translate[0];
-	data.z2 = frame->scale[1] * frame->data[face[i].VertexIndex[1]].vertex[1] + frame->translate[1];
-	data.y2 = frame->scale[2] * frame->data[face[i].VertexIndex[1]].vertex[2] + frame->translate[2];
+		memcpy(&bits[0], &vertices[i], 4);
+		memcpy(&bits[1], &vertices[vc + i], 4);
+		memcpy(&bits[2], &vertices[2 * vc + i], 4);
 
-	data.x3 = frame->scale[0] * frame->data[face[i].VertexIndex[2]].vertex[0] + frame->translate[0];
-	data.z3 = frame->scale[1] * frame->data[face[i].VertexIndex[2]].vertex[1] + frame->translate[1];
-	data.y3 = frame->scale[2] * frame->data[face[i].VertexIndex[2]].vertex[2] + frame->translate[2];
+		key = bits[0] * 73856093u ^ bits[1] * 19349663u ^ bits[2] * 83492791u;
+		h = (key * 2654435761u) & mask;
 
-	return data;
+		while ((k = table[h]) != -1 && !IsSameVertex(vertices, vc, frames, i, k))
+			h = (h + 1) & mask;
+
+		if (k == -1) table[h] = k = i;
+
+		weld[i] = k;
+	}
+
+	// every edge a -> b, chained by key
+	keys = new unsigned int[count];
+	next = new int[count];
+
+	for (h = 0; h < size; h++) table[h] = -1;
+
+	for (i = 0; i < count; i++) {
+
+		a = weld[face[i / 3].VertexIndex[i % 3]];
+		b = weld[face[i / 3].VertexIndex[(i + 1) % 3]];
+
+		adjacency[i] = -1;
+		keys[i] = ((unsigned int)a << 16) | (unsigned int)b;
+		next[i] = -1;
+
+		// a collapsed edge has no face across
+		if (a == b) continue;
+
+		h = (keys[i] * 2654435761u) & mask;
+
+		while ((k = table[h]) != -1 && keys[k] != keys[i])
+			h = (h + 1) & mask;
+
+		if (k == -1) table[h] = i;
+		else {
+			while (next[k] != -1) k = next[k];
+			next[k] = i;
+		}
+	}
+
+	// pair every edge with an unpaired one going back
+	for (i = 0; i < count; i++) {
+
+		if (adjacency[i] != -1 || (keys[i] >> 16) == (keys[i] & 0xffff)) continue;
+
+		key = (keys[i] << 16) | (keys[i] >> 16);
+		h = (key * 2654435761u) & mask;
+
+		while ((k = table[h]) != -1 && keys[k] != key)
+			h = (h + 1) & mask;
+
+		for (; k != -1; k = next[k]) {
+			if (adjacency[k] == -1 && k / 3 != i / 3) {
+				adjacency[i] = k / 3;
+				adjacency[k] = i / 3;
+				break;
+			}
+		}
+	}
+
+	delete[] table;
+	delete[] weld;
+	delete[] keys;
+	delete[] next;
+}
+
+// Reorder the triangles of the welded mesh for the vertex cache and for
+// overdraw, see md2order.h. The clusters are sorted by the shape of the
+// first frame. Only the mesh indices change, the faces keep the order of
+// the file. A file cooked after OptimizeMesh is not reordered again.
+void CMd2File::OptimizeMesh()
+{
+	unsigned short* p;
+	float* positions;
+	int i, k, n, vc;
+
+	// a cooked file is usually written with them in order already
+	if (buffer == NULL || mesh_optimized) return;
+
+	vc = header->vertex_count;
+	n = 3 * header->face_count;
+
+	// the indices of a cooked file are read-only
+	if (IsView(mesh_indices)) {
+		p = new unsigned short[n];
+		memcpy(p, mesh_indices, n * sizeof(unsigned short));
+		mesh_indices = p;
+	}
+
+	positions = new float[3 * mesh_vertex_count];
+
+	for (i = 0; i < mesh_vertex_count; i++) {
+		k = mesh_vertex[i];
+		positions[3 * i] = vertices[k];
+		positions[3 * i + 1] = vertices[vc + k];
+		positions[3 * i + 2] = vertices[2 * vc + k];
+	}
+
+	OptimizeTriangleOrder(mesh_indices, n, positions, mesh_vertex_count);
+
+	delete[] positions;
+
+	mesh_optimized = true;
+}
+
+// The command list is a list of ints. Each run starts with a count,
+// positive for a triangle strip and negative for a triangle fan, followed
+// by that many (float s, float t, int vertex index) entries. A count of
+// zero ends the list.
+//
+//     +-------+---------+---------+-------+-------+---------+-----+---+
+//     | count | s t idx | s t idx |  ...  | count | s t idx | ... | 0 |
+//     +-------+---------+---------+-------+-------+---------+-----+---+
+//
+// A file with a bad command list just gets no runs.
+void CMd2File::ReadCommands(long n)
+{
+	int* p, * end;
+	int i, k, count, runs, vc;
+
+	if (header->cmd_count <= 0 || header->cmd_offset < 0 ||
+		(long long)header->cmd_offset + 4LL * header->cmd_count > n) return;
+
+	p = (int*)&buffer[header->cmd_offset];
+	end = p + header->cmd_count;
+
+	// count the runs and the vertices first
+	runs = vc = 0;
+
+	while (p < end && *p != 0) {
+		count = abs(*p);
+		if (count < 3 || end - p - 1 < 3 * count) return;
+		for (i = 0; i < count; i++)
+			if (p[3 * i + 3] < 0 || p[3 * i + 3] >= header->vertex_count) return;
+		p += 1 + 3 * count;
+		vc += count;
+		runs++;
+	}
+
+	commands = new COMMAND_STRUCT[runs];
+	command_vertex = new unsigned short[vc];
+	command_texcoords = new float[2 * vc];
+
+	p = (int*)&buffer[header->cmd_offset];
+	k = 0;
+
+	for (i = 0; i < runs; i++) {
+
+		count = abs(*p);
+
+		commands[i].type = (*p > 0 ? COMMAND_STRIP : COMMAND_FAN);
+		commands[i].first = k;
+		commands[i].count = count;
+
+		for (p++; count > 0; count--, p += 3, k++) {
+			memcpy(&command_texcoords[2 * k], p, 2 * sizeof(float));
+			command_vertex[k] = (unsigned short)p[2];
+		}
+	}
+
+	command_count = runs;
+	command_vertex_count = vc;
+}
+
+// turn a frame name into the name of its animation, in lower case
+// the frame number at the end is removed, "run01" belongs to "run"
+// a number of 3 digits or more keeps all but the last 2, as in "pain101"
+static void GetClipName(const char* frame, char* name)
+{
+	int i, n, digits;
+
+	for (n = 0; n < 15 && frame[n] != '\0'; n++)
+		name[n] = (char)tolower((unsigned char)frame[n]);
+
+	for (digits = 0; digits < n && isdigit((unsigned char)name[n - 1 - digits]); digits++);
+
+	if (digits >= 3) digits = 2;
+
+	for (i = n - digits; i < 16; i++)
+		name[i] = '\0';
+}
+
+// hash of a clip name
+static unsigned int GetClipHash(const char* name)
+{
+	unsigned int h = 2166136261u;
+
+	while (*name != '\0')
+		h = (h ^ (unsigned char)*name++) * 16777619u;
+
+	return h;
+}
+
+// sort clips by name
+static int CompareClip(const void* a, const void* b)
+{
+	return strcmp(((const CLIP_STRUCT*)a)->name, ((const CLIP_STRUCT*)b)->name);
+}
+
+// Frames of one animation are stored one after another and share a name
+// apart from the frame number. Make one clip for each run of frames with
+// the same name, sort them by name and put them in a hash table so that
+// FindClip does not have to look through the frames.
+void CMd2File::BuildClips()
+{
+	char name[16];
+	unsigned int h, mask;
+	int i;
+
+	clips = new CLIP_STRUCT[header->frame_count > 0 ? header->frame_count : 1];
+	clip_count = 0;
+
+	for (i = 0; i < header->frame_count; i++) {
+
+		GetClipName(GetFrame(i)->name, name);
+
+		if (clip_count > 0 && strcmp(clips[clip_count - 1].name, name) == 0) {
+			clips[clip_count - 1].count++;
+			continue;
+		}
+
+		memcpy(clips[clip_count].name, name, 16);
+		clips[clip_count].first = i;
+		clips[clip_count].count = 1;
+		clips[clip_count].fps = MD2_FPS;
+		clip_count++;
+	}
+
+	qsort(clips, clip_count, sizeof(CLIP_STRUCT), CompareClip);
+
+	// at most half full
+	clip_table_size = 16;
+	while (clip_table_size < 2 * clip_count) clip_table_size *= 2;
+	mask = clip_table_size - 1;
+
+	clip_table = new int[clip_table_size];
+	for (i = 0; i < clip_table_size; i++) clip_table[i] = -1;
+
+	// a name used twice keeps the first clip in the table
+	for (i = 0; i < clip_count; i++) {
+
+		h = GetClipHash(clips[i].name) & mask;
+
+		while (clip_table[h] != -1 && strcmp(clips[clip_table[h]].name, clips[i].name) != 0)
+			h = (h + 1) & mask;
+
+		if (clip_table[h] == -1) clip_table[h] = i;
+	}
+}
+
+// set the frame with index index
+// a frame dropped by Reduce is blended from the kept frames around it
+void CMd2File::SetFrame(int index)
+{
+	int vc, slot;
+
+	if (buffer == NULL) return;
+
+	vc = header->vertex_count;
+	slot = GetSlot(index);
+
+	frame = GetFrame(index);
+
+	if (slot < 0) {
+		InterpolateFrame(index, current);
+		SetPose(current);
+		return;
+	}
+
+	x = &vertices[3 * vc * slot];
+	y = x + vc;
+	z = y + vc;
+	nx = &normals[3 * vc * slot];
+	ny = nx + vc;
+	nz = ny + vc;
+}
+
+// return the number of animations
+int CMd2File::GetClipCount()
+{
+	return clip_count;
+}
+
+// return an animation, they are sorted by name
+const CLIP_STRUCT* CMd2File::GetClip(int index)
+{
+	return &clips[index];
+}
+
+// return the animation with a name, or NULL if there is none
+// the name is not case sensitive
+const CLIP_STRUCT* CMd2File::FindClip(const char* name)
+{
+	char key[16];
+	unsigned int h, mask;
+	int i;
+
+	if (clip_table == NULL) return NULL;
+
+	for (i = 0; i < 15 && name[i] != '\0'; i++)
+		key[i] = (char)tolower((unsigned char)name[i]);
+	key[i] = '\0';
+
+	mask = clip_table_size - 1;
+	h = GetClipHash(key) & mask;
+
+	while ((i = clip_table[h]) != -1) {
+		if (strcmp(clips[i].name, key) == 0) return &clips[i];
+		h = (h + 1) & mask;
+	}
+
+	return NULL;
+}
+
+// return the number of floats in a pose
+// a pose is an array of x, y, z, nx, ny, nz, each with one float per vertex
+int CMd2File::GetPoseSize()
+{
+	return (buffer == NULL ? 0 : 6 * header->vertex_count);
+}
+
+// Find the two frames around a time in seconds into a clip and how far
+// the time is between them. The clip loops, the frame after the last is
+// the first.
+void CMd2File::GetClipFrames(const CLIP_STRUCT* clip, double time, int* i0, int* i1, float* t)
+{
+	double f;
+	int first, count;
+
+	// keep the clip inside the file
+	first = clip->first;
+	count = clip->count;
+
+	if (first < 0) first = 0;
+	if (first > header->frame_count - 1) first = header->frame_count - 1;
+	if (count > header->frame_count - first) count = header->frame_count - first;
+	if (count < 1) count = 1;
+
+	// the two frames and how far we are between them
+	f = fmod(time * clip->fps, (double)count);
+	if (f < 0.0) f += count;
+
+	*i0 = (int)f;
+	if (*i0 > count - 1) *i0 = count - 1;
+	*i1 = (*i0 + 1) % count;
+	*t = (float)(f - *i0);
+
+	*i0 += first;
+	*i1 += first;
+}
+
+// Blend a pose t of the way to the frame that is u of the way from stored
+// frame a to stored frame b, the same as InterpolateFrame then LerpFrame
+// and LerpNormals would with another pose. The normals of a blended
+// frame are made unit length first, those of a stored frame are not.
+static void LerpToBlend(const float* a, const float* b, const float* na, const float* nb, bool blended, float u, float t, int vc, float* pose)
+{
+	float x, y, z, len;
+	float* n;
+	int i;
+
+	for (i = 0; i < 3 * vc; i++) {
+		x = a[i] + u * (b[i] - a[i]);
+		pose[i] = pose[i] + t * (x - pose[i]);
+	}
+
+	n = pose + 3 * vc;
+
+	for (i = 0; i < vc; i++) {
+
+		x = na[i] + u * (nb[i] - na[i]);
+		y = na[vc + i] + u * (nb[vc + i] - na[vc + i]);
+		z = na[2 * vc + i] + u * (nb[2 * vc + i] - na[2 * vc + i]);
+
+		if (blended) {
+			len = sqrtf(x * x + y * y + z * z);
+			len = (len > 0.0f ? 1.0f / len : 0.0f);
+			x *= len;
+			y *= len;
+			z *= len;
+		}
+
+		x = n[i] + t * (x - n[i]);
+		y = n[vc + i] + t * (y - n[vc + i]);
+		z = n[2 * vc + i] + t * (z - n[2 * vc + i]);
+
+		len = sqrtf(x * x + y * y + z * z);
+		len = (len > 0.0f ? 1.0f / len : 0.0f);
+
+		n[i] = x * len;
+		n[vc + i] = y * len;
+		n[2 * vc + i] = z * len;
+	}
+}
+
+// Compute the pose of the model at a time in seconds into a clip.
+// The two frames around that time are blended, so the animation is smooth
+// at any frame rate.
+// pose must hold GetPoseSize() floats.
+void CMd2File::Evaluate(const CLIP_STRUCT* clip, double time, float* pose)
+{
+	float t, u;
+	int i0, i1, s0, s1, vc;
+
+	vc = header->vertex_count;
+
+	GetClipFrames(clip, time, &i0, &i1, &t);
+
+	s0 = GetSlot(i0);
+	s1 = GetSlot(i1);
+
+	if (s0 < 0 || s1 < 0) {
+
+		if (i1 == i0 + 1) {
+
+			// both are in the run between two kept frames, blend those
+			s0 = key_index[i0];
+			s1 = s0 + 1;
+			t = ((float)(i0 - keys[s0]) + t) / (float)(keys[s1] - keys[s0]);
+		}
+		else {
+
+			// a clip that loops from its last frame to its first with one
+			// of them dropped, the first is blended into the pose as it is
+			// made so no other pose is needed
+			InterpolateFrame(i0, pose);
+
+			s0 = key_index[i1];
+			s1 = (keys[s0] == i1 ? s0 : s0 + 1);
+			u = (s1 == s0 ? 0.0f : (float)(i1 - keys[s0]) / (float)(keys[s1] - keys[s0]));
+
+			LerpToBlend(&vertices[3 * vc * s0], &vertices[3 * vc * s1], &normals[3 * vc * s0], &normals[3 * vc * s1],
+				s1 != s0, u, t, vc, pose);
+			return;
+		}
+	}
+
+	LerpFrame(&vertices[3 * vc * s0], &vertices[3 * vc * s1], t, 3 * vc, pose);
+	LerpNormals(&normals[3 * vc * s0], &normals[3 * vc * s1], t, vc, pose + 3 * vc);
+}
+
+// return where a frame is stored in vertices and normals,
+// or -1 if Reduce dropped it
+int CMd2File::GetSlot(int index)
+{
+	if (keys == NULL) return index;
+
+	return (keys[key_index[index]] == index ? key_index[index] : -1);
+}
+
+// copy a frame into a pose, a dropped frame is blended from the kept
+// frames around it
+void CMd2File::InterpolateFrame(int index, float* pose)
+{
+	float t;
+	int s0, s1, vc;
+
+	vc = header->vertex_count;
+	s0 = (keys == NULL ? index : key_index[index]);
+
+	if (GetSlot(index) >= 0) {
+		memcpy(pose, &vertices[3 * vc * s0], 12 * vc);
+		memcpy(pose + 3 * vc, &normals[3 * vc * s0], 12 * vc);
+		return;
+	}
+
+	s1 = s0 + 1;
+	t = (float)(index - keys[s0]) / (float)(keys[s1] - keys[s0]);
+
+	LerpFrame(&vertices[3 * vc * s0], &vertices[3 * vc * s1], t, 3 * vc, pose);
+	LerpNormals(&normals[3 * vc * s0], &normals[3 * vc * s1], t, vc, pose + 3 * vc);
+}
+
+// return the largest distance between a vertex of frame f and the same
+// vertex blended between frames a and b, each an array of x then y then z
+static float GetBlendError(const float* a, const float* b, const float* f, float t, int vc)
+{
+	float dx, dy, dz, d, max;
+	int i;
+
+	max = 0.0f;
+
+	for (i = 0; i < vc; i++) {
+		dx = a[i] + t * (b[i] - a[i]) - f[i];
+		dy = a[vc + i] + t * (b[vc + i] - a[vc + i]) - f[vc + i];
+		dz = a[2 * vc + i] + t * (b[2 * vc + i] - a[2 * vc + i]) - f[2 * vc + i];
+		d = dx * dx + dy * dy + dz * dz;
+		if (d > max) max = d;
+	}
+
+	return sqrtf(max);
+}
+
+// keep the frame between kept frames a and b that blending a and b
+// rebuilds worst, if it is worse than tolerance, and do the same for
+// both halves
+void CMd2File::ReduceRun(int a, int b, float tolerance, bool* keep)
+{
+	float error, max;
+	int i, worst, vc;
+
+	vc = header->vertex_count;
+	worst = -1;
+	max = tolerance;
+
+	for (i = a + 1; i < b; i++) {
+		error = GetBlendError(&vertices[3 * vc * a], &vertices[3 * vc * b], &vertices[3 * vc * i], (float)(i - a) / (float)(b - a), vc);
+		if (error > max) {
+			max = error;
+			worst = i;
+		}
+	}
+
+	if (worst < 0) return;
+
+	keep[worst] = true;
+
+	ReduceRun(a, worst, tolerance, keep);
+	ReduceRun(worst, b, tolerance, keep);
+}
+
+// Drop the frames that blending the frames around them rebuilds with no
+// vertex farther than tolerance from where it was. The first and the last
+// frame of every clip are kept, so the frame numbers and the timing of
+// the clips do not change: Evaluate and SetFrame blend the kept frames
+// around a dropped one, and a clip still loops from its last frame to its
+// first. Only the kept frames are stored, the bounds are those of the
+// blended frames.
+// return false if there is no model or it is reduced already
+bool CMd2File::Reduce(float tolerance)
+{
+	bool* keep;
+	float* v;
+	int i, a, k, vc, fc;
+
+	if (buffer == NULL || keys != NULL) return false;
+
+	vc = header->vertex_count;
+	fc = header->frame_count;
+
+	keep = new bool[fc];
+
+	for (i = 0; i < fc; i++) keep[i] = false;
+
+	keep[0] = keep[fc - 1] = true;
+
+	for (i = 0; i < clip_count; i++) {
+		keep[clips[i].first] = true;
+		keep[clips[i].first + clips[i].count - 1] = true;
+	}
+
+	// simplify the runs between frames that must stay
+	for (a = 0, i = 1; i < fc; i++) {
+		if (keep[i]) {
+			ReduceRun(a, i, tolerance, keep);
+			a = i;
+		}
+	}
+
+	key_count = 0;
+	for (i = 0; i < fc; i++)
+		if (keep[i]) key_count++;
+
+	keys = new int[key_count];
+	key_index = new int[fc];
+	v = new float[6 * vc * key_count];
+
+	// move the kept frames into one block, as DecodeFrames does
+	for (k = -1, i = 0; i < fc; i++) {
+		if (keep[i]) {
+			keys[++k] = i;
+			memcpy(&v[3 * vc * k], &vertices[3 * vc * i], 12 * vc);
+			memcpy(&v[3 * vc * (key_count + k)], &normals[3 * vc * i], 12 * vc);
+		}
+		key_index[i] = k;
+	}
+
+	delete[] keep;
+
+	if (!IsView(vertices)) delete[] vertices;
+
+	vertices = v;
+	normals = v + 3 * vc * key_count;
+	current = new float[6 * vc];
+
+	// bounds of the frames as they are blended now
+	if (IsView(bounds)) bounds = new BOUNDS_STRUCT[fc];
+
+	for (i = 0; i < fc; i++) {
+		InterpolateFrame(i, current);
+		GetFrameBox(current, current + vc, current + 2 * vc, vc, &bounds[i]);
+	}
+
+	SetFrame(0);
+
+	return true;
+}
+
+// return the box and the sphere of a frame
+const BOUNDS_STRUCT* CMd2File::GetFrameBounds(int index)
+{
+	return (buffer == NULL || index < 0 || index >= header->frame_count ? NULL : &bounds[index]);
+}
+
+// Find the bounds of the pose Evaluate gives for the same clip and time.
+// Every vertex of the pose is blended between two frames, so it is inside
+// the box blended between their boxes and inside the sphere blended
+// between their spheres. No vertex has to be read.
+void CMd2File::GetBounds(const CLIP_STRUCT* clip, double time, BOUNDS_STRUCT* b)
+{
+	const BOUNDS_STRUCT* a0, * a1;
+	float t;
+	int i0, i1, k;
+
+	GetClipFrames(clip, time, &i0, &i1, &t);
+
+	a0 = &bounds[i0];
+	a1 = &bounds[i1];
+
+	for (k = 0; k < 3; k++) {
+		b->min[k] = a0->min[k] + t * (a1->min[k] - a0->min[k]);
+		b->max[k] = a0->max[k] + t * (a1->max[k] - a0->max[k]);
+		b->center[k] = a0->center[k] + t * (a1->center[k] - a0->center[k]);
+	}
+
+	b->radius = a0->radius + t * (a1->radius - a0->radius);
+}
+
+// what each block of a batch needs
+typedef struct
+{
+	CMd2File* file;
+	const INSTANCE_STRUCT* instances;
+	float* poses;
+	int size;
+}BATCH_STRUCT;
+
+// evaluate instances first to last - 1 of a batch
+static void EvaluateBlock(void* param, int first, int last)
+{
+	BATCH_STRUCT* batch = (BATCH_STRUCT*)param;
+	int i;
+
+	for (i = first; i < last; i++)
+		batch->file->Evaluate(batch->instances[i].clip, batch->instances[i].time, &batch->poses[(size_t)batch->size * i]);
+}
+
+// Compute the pose of many copies of the model at once.
+// poses must hold count * GetPoseSize() floats, one pose after another.
+// Evaluate only reads the decoded frames, so the instances are shared
+// between the threads of pool. A NULL pool does them all on this thread.
+void CMd2File::Evaluate(const INSTANCE_STRUCT* instances, int count, float* poses, CThreadPool* pool)
+{
+	BATCH_STRUCT batch;
+
+	batch.file = this;
+	batch.instances = instances;
+	batch.poses = poses;
+	batch.size = GetPoseSize();
+
+	// a block of 16 poses is a few hundred kilobytes, big enough that
+	// taking a block costs nothing next to the work in it
+	if (pool != NULL)
+		pool->ParallelFor(count, 16, EvaluateBlock, &batch);
+	else
+		EvaluateBlock(&batch, 0, count);
+}
+
+// use a pose from Evaluate instead of a frame
+// the pose must stay alive until the next SetFrame or SetPose
+void CMd2File::SetPose(float* pose)
+{
+	int vc = header->vertex_count;
+
+	x = pose;
+	y = x + vc;
+	z = y + vc;
+	nx = z + vc;
+	ny = nx + vc;
+	nz = ny + vc;
+}
+
+// return the number of triangles in the model
+int CMd2File::GetFaceCount()
+{
+	return (buffer == NULL ? 0 : header->face_count);
+}
+
+// return the number of vertices in one frame
+int CMd2File::GetVertexCount()
+{
+	return (buffer == NULL ? 0 : header->vertex_count);
+}
+
+// return the compressed data of a frame as stored in the file
+// a cooked file without compressed frames returns NULL
+FRAME_STRUCT* CMd2File::GetFrame(int index)
+{
+	if (header->frame_offset == 0) return NULL;
+
+	return (FRAME_STRUCT*)&buffer[header->frame_offset + header->framesize * index];
+}
+
+// return the decoded vertices of a frame, an array of x then y then z
+// a frame dropped by Reduce returns NULL
+const float* CMd2File::GetFrameVertices(int index)
+{
+	int slot = GetSlot(index);
+
+	return (slot < 0 ? NULL : &vertices[3 * header->vertex_count * slot]);
+}
+
+// return the decoded normals of a frame, an array of x then y then z
+// a frame dropped by Reduce returns NULL
+const float* CMd2File::GetFrameNormals(int index)
+{
+	int slot = GetSlot(index);
+
+	return (slot < 0 ? NULL : &normals[3 * header->vertex_count * slot]);
+}
+
+// return the number of frames of animation
+int CMd2File::GetFrameCount()
+{
+	return (buffer == NULL ? 0 : header->frame_count);
+}
+
+// return the number of frames stored, less than GetFrameCount after Reduce
+int CMd2File::GetKeyCount()
+{
+	return (buffer == NULL ? 0 : (keys == NULL ? header->frame_count : key_count));
+}
+
+// return the number of skins, texture files the model can be drawn with
+int CMd2File::GetSkinCount()
+{
+	return (buffer == NULL ? 0 : header->texture_image_count);
+}
+
+// return the name of the texture file of a skin
+// a name may fill all MD2_SKIN_NAME_SIZE bytes with no null, its last
+// character is dropped then
+void CMd2File::GetSkinName(int index, char* str, size_t n)
+{
+	char name[MD2_SKIN_NAME_SIZE];
+
+	if (n == 0) return;
+	str[0] = '\0';
+
+	if (buffer == NULL || index < 0 || index >= header->texture_image_count ||
+		header->texture_name_offset < 0 ||
+		header->texture_name_offset + (long long)MD2_SKIN_NAME_SIZE * (index + 1) > buffer_size) return;
+
+	memcpy(name, &buffer[header->texture_name_offset + MD2_SKIN_NAME_SIZE * index], MD2_SKIN_NAME_SIZE);
+	name[MD2_SKIN_NAME_SIZE - 1] = '\0';
+
+	strcpy_s(str, n, name);
+}
+
+// return the name of the texture file of the first skin
+void CMd2File::GetTextureName(char* str, size_t n)
+{
+	GetSkinName(0, str, n);
+}
+
+// return the number of vertices in the welded mesh
+int CMd2File::GetMeshVertexCount()
+{
+	return mesh_vertex_count;
+}
+
+// return the number of indices in the welded mesh, 3 per face
+int CMd2File::GetMeshIndexCount()
+{
+	return (buffer == NULL ? 0 : 3 * header->face_count);
+}
+
+// return the indices of the welded mesh
+const unsigned short* CMd2File::GetMeshIndices()
+{
+	return mesh_indices;
+}
+
+// return the s, t pair of every mesh vertex
+const float* CMd2File::GetMeshTexCoords()
+{
+	return mesh_texcoords;
+}
+
+// return the frame vertex of every mesh vertex
+const unsigned short* CMd2File::GetMeshVertexIndices()
+{
+	return mesh_vertex;
+}
+
+// copy x, y, z of every mesh vertex of the current frame into v
+// v must hold 3 * GetMeshVertexCount() floats
+void CMd2File::GetMeshVertices(float* v)
+{
+	int i, k;
+
+	for (i = 0; i < mesh_vertex_count; i++) {
+		k = mesh_vertex[i];
+		v[3 * i] = x[k];
+		v[3 * i + 1] = y[k];
+		v[3 * i + 2] = z[k];
+	}
+}
+
+// copy x, y, z of every mesh vertex normal of the current frame into n
+// n must hold 3 * GetMeshVertexCount() floats
+void CMd2File::GetMeshNormals(float* n)
+{
+	int i, k;
+
+	for (i = 0; i < mesh_vertex_count; i++) {
+		k = mesh_vertex[i];
+		n[3 * i] = nx[k];
+		n[3 * i + 1] = ny[k];
+		n[3 * i + 2] = nz[k];
+	}
+}
+
+// Fill v with every mesh vertex of the current frame, MD2_STREAM_SIZE
+// floats each, to be drawn from one array with GetMeshIndices.
+// v must hold MD2_STREAM_SIZE * GetMeshVertexCount() floats
+void CMd2File::GetMeshStream(float* v)
+{
+	int i, k;
+
+	for (i = 0; i < mesh_vertex_count; i++, v += MD2_STREAM_SIZE) {
+		k = mesh_vertex[i];
+		v[0] = mesh_texcoords[2 * i];
+		v[1] = mesh_texcoords[2 * i + 1];
+		v[2] = nx[k];
+		v[3] = ny[k];
+		v[4] = nz[k];
+		v[5] = x[k];
+		v[6] = y[k];
+		v[7] = z[k];
+	}
+}
+
+// return the number of runs in the command list
+int CMd2File::GetCommandCount()
+{
+	return command_count;
+}
+
+// return the number of vertices of all runs
+int CMd2File::GetCommandVertexCount()
+{
+	return command_vertex_count;
+}
+
+// return the runs of the command list
+const COMMAND_STRUCT* CMd2File::GetCommands()
+{
+	return commands;
+}
+
+// return the s, t pair of every command vertex
+const float* CMd2File::GetCommandTexCoords()
+{
+	return command_texcoords;
+}
+
+// copy x, y, z of every command vertex of the current frame into v
+// v must hold 3 * GetCommandVertexCount() floats
+void CMd2File::GetCommandVertices(float* v)
+{
+	int i, k;
+
+	for (i = 0; i < command_vertex_count; i++) {
+		k = command_vertex[i];
+		v[3 * i] = x[k];
+		v[3 * i + 1] = y[k];
+		v[3 * i + 2] = z[k];
+	}
+}
+
+// copy x, y, z of every command vertex normal of the current frame into n
+// n must hold 3 * GetCommandVertexCount() floats
+void CMd2File::GetCommandNormals(float* n)
+{
+	int i, k;
+
+	for (i = 0; i < command_vertex_count; i++) {
+		k = command_vertex[i];
+		n[3 * i] = nx[k];
+		n[3 * i + 1] = ny[k];
+		n[3 * i + 2] = nz[k];
+	}
+}
+
+// return the face across every edge, 3 per face, the edge k of a face
+// goes from corner k to corner k + 1 (mod 3), -1 on a border
+const int* CMd2File::GetAdjacency()
+{
+	return adjacency;
+}
+
+// return the vertex of every corner of every face, all first corners,
+// then all second, then all third
+const int* CMd2File::GetCorners()
+{
+	return corners;
+}
+
+// Find the edges between the faces that face a light and the ones that
+// do not, for a shadow volume or an outline. light is x, y, z, w: a point
+// if w is 1 and the direction toward the light if w is 0. pose is from
+// Evaluate, NULL for the current frame or pose.
+// facing gets 1 for every face that faces the light and 0 for the
+// others, GetFaceCount() bytes. edges gets 2 vertices for every edge, in
+// the winding of the face that faces the light, at most 6 * GetFaceCount().
+// An edge on a border of a face that faces the light is in the silhouette.
+// Nothing in the object is changed, as for GetTriangles.
+// return the number of edges
+int CMd2File::GetSilhouette(const float* pose, const float* light, unsigned char* facing, unsigned short* edges) const
+{
+	const float* px, * py, * pz;
+	int i, j, k, n, fc;
+
+	if (buffer == NULL) return 0;
+
+	fc = header->face_count;
+
+	if (pose != NULL) {
+		px = pose;
+		py = pose + header->vertex_count;
+		pz = pose + 2 * header->vertex_count;
+	}
+	else {
+		px = x;
+		py = y;
+		pz = z;
+	}
+
+	FaceFacing(px, py, pz, corners, fc, light, facing);
+
+	n = 0;
+
+	for (i = 0; i < fc; i++) {
+
+		if (!facing[i]) continue;
+
+		for (j = 0; j < 3; j++) {
+
+			k = adjacency[3 * i + j];
+
+			if (k == -1 || !facing[k]) {
+				edges[2 * n] = face[i].VertexIndex[j];
+				edges[2 * n + 1] = face[i].VertexIndex[j == 2 ? 0 : j + 1];
+				n++;
+			}
+		}
+	}
+
+	return n;
+}
+
+// the same for every command vertex
+// v must hold MD2_STREAM_SIZE * GetCommandVertexCount() floats
+void CMd2File::GetCommandStream(float* v)
+{
+	int i, k;
+
+	for (i = 0; i < command_vertex_count; i++, v += MD2_STREAM_SIZE) {
+		k = command_vertex[i];
+		v[0] = command_texcoords[2 * i];
+		v[1] = command_texcoords[2 * i + 1];
+		v[2] = nx[k];
+		v[3] = ny[k];
+		v[4] = nz[k];
+		v[5] = x[k];
+		v[6] = y[k];
+		v[7] = z[k];
+	}
+}
+
+// Turn the strips and fans into one triangle list of command vertices,
+// so they can be drawn with one call. Every other triangle of a strip is
+// turned around to keep the winding of the first.
+// indices must hold 3 * GetCommandVertexCount() ints
+// return the number of indices
+int CMd2File::GetCommandIndices(unsigned int* indices)
+{
+	unsigned int a;
+	int i, k, n;
+
+	n = 0;
+
+	for (i = 0; i < command_count; i++) {
+
+		a = commands[i].first;
+
+		for (k = 0; k + 2 < commands[i].count; k++) {
+
+			if (commands[i].type == COMMAND_FAN) {
+				indices[n++] = a;
+				indices[n++] = a + k + 1;
+				indices[n++] = a + k + 2;
+			}
+			else if (k % 2 == 0) {
+				indices[n++] = a + k;
+				indices[n++] = a + k + 1;
+				indices[n++] = a + k + 2;
+			}
+			else {
+				indices[n++] = a + k + 1;
+				indices[n++] = a + k;
+				indices[n++] = a + k + 2;
+			}
+		}
+	}
+
+	return n;
+}
+
+// Fill out with the faces first to first + count - 1, one MD2_STRUCT per
+// face, reading the positions and normals from the given arrays. Nothing
+// in the object is changed, so any number of threads can call this at the
+// same time as long as each one has its own out.
+// return the number of faces written
+int CMd2File::ReadTriangles(const float* px, const float* py, const float* pz,
+	const float* pnx, const float* pny, const float* pnz, int first, int count, MD2_STRUCT* out) const
+{
+	float fx, fy, fz, len;
+	int i, a, b, c;
+
+	if (buffer == NULL) return 0;
+
+	// keep the range inside the model
+	if (first < 0) { count += first; first = 0; }
+	if (count > header->face_count - first) count = header->face_count - first;
+	if (count <= 0) return 0;
+
+	for (i = 0; i < count; i++, out++) {
+
+		const FACE_STRUCT& f = face[first + i];
+
+		a = f.TextureIndex[0];
+		b = f.TextureIndex[1];
+		c = f.TextureIndex[2];
+
+		out->s1 = texcoords[2 * a];     out->t1 = texcoords[2 * a + 1];
+		out->s2 = texcoords[2 * b];     out->t2 = texcoords[2 * b + 1];
+		out->s3 = texcoords[2 * c];     out->t3 = texcoords[2 * c + 1];
+
+		a = f.VertexIndex[0];
+		b = f.VertexIndex[1];
+		c = f.VertexIndex[2];
+
+		// the face normal is the average of its vertex normals
+		fx = pnx[a] + pnx[b] + pnx[c];
+		fy = pny[a] + pny[b] + pny[c];
+		fz = pnz[a] + pnz[b] + pnz[c];
+
+		len = sqrtf(fx * fx + fy * fy + fz * fz);
+		if (len > 0.0f) len = 1.0f / len;
+
+		out->nx = fx * len;
+		out->ny = fy * len;
+		out->nz = fz * len;
+
+		out->x1 = px[a];     out->y1 = py[a];     out->z1 = pz[a];
+		out->x2 = px[b];     out->y2 = py[b];     out->z2 = pz[b];
+		out->x3 = px[c];     out->y3 = py[c];     out->z3 = pz[c];
+	}
+
+	return count;
+}
+
+// the same for a pose filled by Evaluate
+int CMd2File::GetTriangles(const float* pose, int first, int count, MD2_STRUCT* out) const
+{
+	int vc;
+
+	if (buffer == NULL) return 0;
+
+	vc = header->vertex_count;
+
+	return ReadTriangles(pose, pose + vc, pose + 2 * vc, pose + 3 * vc, pose + 4 * vc, pose + 5 * vc, first, count, out);
+}
+
+// the same for a decoded frame, the frame is not made the current one
+int CMd2File::GetFrameTriangles(int frame, int first, int count, MD2_STRUCT* out) const
+{
+	const float* p, * n;
+	int vc;
+
+	if (buffer == NULL || frame < 0 || frame >= header->frame_count) return 0;
+
+	// a frame dropped by Reduce is not stored
+	if (keys != NULL) {
+		if (keys[key_index[frame]] != frame) return 0;
+		frame = key_index[frame];
+	}
+
+	vc = header->vertex_count;
+	p = &vertices[3 * vc * frame];
+	n = &normals[3 * vc * frame];
+
+	return ReadTriangles(p, p + vc, p + 2 * vc, n, n + vc, n + 2 * vc, first, count, out);
+}
+
+// the same for the current frame or pose
+int CMd2File::GetTriangles(int first, int count, MD2_STRUCT* out) const
+{
+	return ReadTriangles(x, y, z, nx, ny, nz, first, count, out);
 }
 
 //
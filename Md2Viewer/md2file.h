@@ -11,6 +11,8 @@
 
 #pragma once
 
+class CThreadPool;
+
 // header
 typedef struct
 {
@@ -33,6 +35,54 @@ typedef struct
 	int 	end_offset; 			// Offset to end of file
 }MD2FILEHEADER;
 
+// size of the name of a skin, a texture file of the model
+const int MD2_SKIN_NAME_SIZE = 64;
+
+// version of the cooked format written by CMd2File::Cook
+const int MD2C_VERSION = 4;
+
+// flags of a cooked file
+enum
+{
+	MD2C_QUANTIZED = 1,     // compressed frames instead of decoded floats
+	MD2C_OPTIMIZED = 2      // mesh indices in the order OptimizeMesh gives
+};
+
+// header of a cooked file (.md2c)
+// The file holds the decoded data of a model so that opening it needs no
+// work. Every offset is from the start of the file and a multiple of 16,
+// so the arrays can be used straight from a mapped file.
+typedef struct
+{
+	char 	id[4];					// Must be equal to "MD2C"
+	int 	version;				// MD2C_VERSION
+	int 	flags;					// MD2C_QUANTIZED, MD2C_OPTIMIZED
+	int 	size;					// Size of the file in bytes
+	int 	md2_offset;				// Offset to an md2 header with offsets into this file
+	int 	vertex_offset;			// Offset to decoded vertices of the stored frames, 0 if quantized
+	int 	normal_offset;			// Offset to decoded normals of the stored frames, 0 if quantized
+	int 	texcoord_offset;		// Offset to s-t pairs divided by the texture size
+	int 	mesh_vertex_count;		// Number of vertices in the welded mesh
+	int 	mesh_vertex_offset;		// Offset to the frame vertex of each mesh vertex
+	int 	mesh_texcoord_offset;	// Offset to the s-t pair of each mesh vertex
+	int 	mesh_index_offset;		// Offset to 3 mesh vertices per face
+	int 	command_count;			// Number of triangle strips and fans
+	int 	command_vertex_count;	// Number of command vertices
+	int 	command_offset;			// Offset to the strips and fans
+	int 	command_vertex_offset;	// Offset to the frame vertex of each command vertex
+	int 	command_texcoord_offset;// Offset to the s-t pair of each command vertex
+	int 	clip_count;				// Number of animations
+	int 	clip_table_size;		// Size of the animation hash table
+	int 	clip_offset;			// Offset to the animations
+	int 	clip_table_offset;		// Offset to the animation hash table
+	int 	bounds_offset;			// Offset to the bounds of every frame
+	int 	key_count;				// Number of frames kept by CMd2File::Reduce, 0 if all
+	int 	key_offset;				// Offset to the kept frames
+	int 	key_index_offset;		// Offset to the last kept frame at or before every frame
+	int 	adjacency_offset;		// Offset to the face across every edge of every face
+	int 	corner_offset;			// Offset to the vertex of every corner of every face
+}MD2CFILEHEADER;
+
 // data structure for texture
 typedef struct
 {
@@ -63,6 +113,53 @@ typedef struct
 	VERTEX_STRUCT data[1];
 }FRAME_STRUCT;
 
+// kinds of run in the OpenGL command list
+enum
+{
+	COMMAND_STRIP,
+	COMMAND_FAN
+};
+
+// data structure for a run of the OpenGL command list
+typedef struct
+{
+	int type;               // COMMAND_STRIP or COMMAND_FAN
+	int first;              // first command vertex of the run
+	int count;              // number of command vertices in the run
+}COMMAND_STRUCT;
+
+// data structure for an animation, a run of frames played in a loop
+typedef struct
+{
+	char name[16];
+	int first;              // first frame
+	int count;              // number of frames
+	float fps;              // frames per second
+}CLIP_STRUCT;
+
+// data structure for one copy of the model playing an animation
+typedef struct
+{
+	const CLIP_STRUCT* clip;
+	double time;            // seconds into the clip
+}INSTANCE_STRUCT;
+
+// data structure for the bounds of a frame
+typedef struct
+{
+	float min[3];           // axis aligned box
+	float max[3];
+	float center[3];        // sphere around the center of the box
+	float radius;
+}BOUNDS_STRUCT;
+
+// floats of a vertex in an interleaved stream: s, t, nx, ny, nz, x, y, z,
+// the layout of GL_T2F_N3F_V3F
+const int MD2_STREAM_SIZE = 8;
+
+// md2 animations are made to be played at 10 frames per second
+const float MD2_FPS = 10.0f;
+
 // data structure to draw model
 typedef struct
 {
@@ -75,24 +172,152 @@ class CMd2File
 {
 private:
 	MD2FILEHEADER* header;
+
+	// the whole file, read into memory or mapped read-only
 	unsigned char* buffer;
+	long long buffer_size;
+	bool buffer_mapped;
 	FRAME_STRUCT* frame;
 	FACE_STRUCT* face;
 	TEXTURE_STRUCT* st;
-	MD2_STRUCT data;
+
+	// every frame is decoded once when the file is opened
+	// vertices  - per frame, an array of x then y then z (y and z swapped)
+	// normals   - per frame, an array of x then y then z of the vertex normals,
+	//             in the same block after the vertices of all frames
+	// texcoords - s, t pairs already divided by the texture size
+	float* vertices;
+	float* normals;
+	float* texcoords;
+
+	// the decoded data of the current frame
+	float* x, * y, * z;
+	float* nx, * ny, * nz;
+
+	// welded mesh, one vertex for each different (vertex, texture) pair
+	// mesh_vertex    - vertex index in the frame of each mesh vertex
+	// mesh_texcoords - s, t pair of each mesh vertex
+	// mesh_indices   - 3 mesh vertices per face, in the order of the faces
+	//                  until OptimizeMesh
+	// mesh_optimized - OptimizeMesh has ordered the indices already
+	int mesh_vertex_count;
+	unsigned short* mesh_vertex;
+	float* mesh_texcoords;
+	unsigned short* mesh_indices;
+	bool mesh_optimized;
+
+	// the OpenGL command list, triangle strips and fans
+	// commands          - the runs
+	// command_vertex    - vertex index in the frame of each command vertex
+	// command_texcoords - s, t pair of each command vertex
+	int command_count, command_vertex_count;
+	COMMAND_STRUCT* commands;
+	unsigned short* command_vertex;
+	float* command_texcoords;
+
+	// animations found from the frame names, sorted by name
+	// clip_table is an open addressing hash table of indices into clips
+	int clip_count, clip_table_size;
+	CLIP_STRUCT* clips;
+	int* clip_table;
+
+	// box and sphere of every frame
+	BOUNDS_STRUCT* bounds;
+
+	// frames kept by Reduce, keys is NULL when every frame is stored
+	// keys      - the kept frames in order, vertices and normals only hold these
+	// key_index - for every frame, the last kept frame at or before it
+	// current   - a frame that was dropped, made current by SetFrame
+	int key_count;
+	int* keys;
+	int* key_index;
+	float* current;
+
+	// faces across the edges, found once when the model is opened
+	// adjacency - 3 per face, the face across the edge from corner k to
+	//             corner k + 1 (mod 3), -1 on a border
+	// corners   - the vertex of every corner, all first corners, then all
+	//             second, then all third, as FaceFacing reads them
+	int* adjacency;
+	int* corners;
+
+	bool OpenCooked();
+	bool IsCookedValid();
+	bool IsView(const void* p);
+	bool DecodeFrames();
+	void DecodeTexCoords();
+	bool BuildMesh();
+	void ReadCommands(long n);
+	void BuildClips();
+	void ComputeBounds();
+	void BuildAdjacency();
+	int GetSlot(int index);
+	void InterpolateFrame(int index, float* pose);
+	void ReduceRun(int a, int b, float tolerance, bool* keep);
+	void Free();
+
+	int ReadTriangles(const float* px, const float* py, const float* pz,
+		const float* pnx, const float* pny, const float* pnz, int first, int count, MD2_STRUCT* out) const;
 
 public:
 
 	CMd2File();
 	~CMd2File();
 
-	bool Open(wchar_t* filename);
+	bool Open(wchar_t* filename, bool map = true);
+	bool Cook(wchar_t* filename, bool quantized = false);
+	bool Reduce(float tolerance);
+	void OptimizeMesh();
 
 	void SetFrame(int index);
 
+	int GetClipCount();
+	const CLIP_STRUCT* GetClip(int index);
+	const CLIP_STRUCT* FindClip(const char* name);
+
+	int GetPoseSize();
+	void GetClipFrames(const CLIP_STRUCT* clip, double time, int* i0, int* i1, float* t);
+	void Evaluate(const CLIP_STRUCT* clip, double time, float* pose);
+	void Evaluate(const INSTANCE_STRUCT* instances, int count, float* poses, CThreadPool* pool);
+	void SetPose(float* pose);
+
+	const BOUNDS_STRUCT* GetFrameBounds(int index);
+	void GetBounds(const CLIP_STRUCT* clip, double time, BOUNDS_STRUCT* b);
+
 	int GetFaceCount();
+	int GetVertexCount();
 	int GetFrameCount();
+	int GetKeyCount();
+	FRAME_STRUCT* GetFrame(int index);
+	const float* GetFrameVertices(int index);
+	const float* GetFrameNormals(int index);
+	int GetSkinCount();
+	void GetSkinName(int index, char* str, size_t n);
 	void GetTextureName(char* str, size_t n);
 
-	MD2_STRUCT& operator[](int i);
+	int GetMeshVertexCount();
+	int GetMeshIndexCount();
+	const unsigned short* GetMeshIndices();
+	const float* GetMeshTexCoords();
+	const unsigned short* GetMeshVertexIndices();
+	void GetMeshVertices(float* v);
+	void GetMeshNormals(float* n);
+	void GetMeshStream(float* v);
+
+	int GetCommandCount();
+	int GetCommandVertexCount();
+	const COMMAND_STRUCT* GetCommands();
+	const float* GetCommandTexCoords();
+	void GetCommandVertices(float* v);
+	void GetCommandNormals(float* n);
+	void GetCommandStream(float* v);
+	int GetCommandIndices(unsigned int* indices);
+
+	const int* GetAdjacency();
+	const int* GetCorners();
+	int GetSilhouette(const float* pose, const float* light, unsigned char* facing, unsigned short* edges) const;
+
+	int GetTriangles(int first, int count, MD2_STRUCT* out) const;
+	int GetTriangles(const float* pose, int first, int count, MD2_STRUCT* out) const;
+	int GetFrameTriangles(int frame, int first, int count, MD2_STRUCT* out) const;
 };
@@ -0,0 +1,800 @@
+/*
+   Class Name:
+
+	  CMd2Lod
+
+   Description:
+
+	  simplified versions of the welded mesh of an md2 model, one
+	  triangle list that is used for every frame of the animation
+
+*/
+
+#include "platform.h"
+#include "md2lod.h"
+#include "md2order.h"
+
+// an edge of the mesh between two frame vertices
+typedef struct
+{
+	int a, b;
+	int from, to;           // the cheaper way to collapse it, from moves onto to
+	double cost;
+	bool live;
+	bool blocked;           // CanCollapse said no, try again when the edge changes
+}EDGE_STRUCT;
+
+// the side of a face, to find the edges of the mesh
+typedef struct
+{
+	int a, b;               // a < b
+	int face;
+}SIDE_STRUCT;
+
+// the mesh while it is simplified
+typedef struct
+{
+	int vertex_count, frame_count, face_count, live_count, edge_count, mesh_vertex_count;
+	const float** frames;               // the stored frames
+	const unsigned short* mesh_vertex;  // frame vertex of every mesh vertex
+	const float* texcoords;             // s, t pair of every mesh vertex
+	float* positions;                   // x, y, z of every mesh vertex in the first frame
+	double* quadrics;                   // 10 doubles for every frame of every vertex
+	int* corners;                       // 3 mesh vertices per face
+	bool* faces;                        // the face is still there
+	int* first, * next;                 // the mesh vertices of every frame vertex
+	EDGE_STRUCT* edges;
+	int* work;                          // edge_count ints
+	int* neighbour, * shared;           // vertices marked with stamp by CanCollapse
+	int stamp;
+	int* parent;                        // the vertex a vertex was moved onto, or itself
+}SIMPLIFY_STRUCT;
+
+// constructor
+CMd2Lod::CMd2Lod()
+{
+	int i;
+
+	level_count = 0;
+
+	for (i = 0; i < MD2_LOD_MAX_LEVELS; i++) {
+		index_count[i] = 0;
+		indices[i] = NULL;
+		error[i] = 0.0f;
+		mean_error[i] = 0.0f;
+	}
+}
+
+// destructor
+CMd2Lod::~CMd2Lod()
+{
+	Free();
+}
+
+//
+void CMd2Lod::Free()
+{
+	int i;
+
+	for (i = 0; i < MD2_LOD_MAX_LEVELS; i++) {
+		if (indices[i] != NULL) {
+			delete[] indices[i];
+			indices[i] = NULL;
+		}
+		index_count[i] = 0;
+		error[i] = 0.0f;
+		mean_error[i] = 0.0f;
+	}
+
+	level_count = 0;
+}
+
+// add the plane ax + by + cz + d = 0, with a unit normal, to a quadric
+static void AddPlane(double* q, double a, double b, double c, double d)
+{
+	q[0] += a * a;  q[1] += a * b;  q[2] += a * c;  q[3] += a * d;
+	q[4] += b * b;  q[5] += b * c;  q[6] += b * d;
+	q[7] += c * c;  q[8] += c * d;
+	q[9] += d * d;
+}
+
+// return the sum of the squared distances of a point from the planes of a quadric
+static double GetQuadricError(const double* q, const double* p)
+{
+	return q[0] * p[0] * p[0] + 2.0 * (q[1] * p[0] * p[1] + q[2] * p[0] * p[2] + q[3] * p[0]) +
+		q[4] * p[1] * p[1] + 2.0 * (q[5] * p[1] * p[2] + q[6] * p[1]) +
+		q[7] * p[2] * p[2] + 2.0 * q[8] * p[2] + q[9];
+}
+
+// return the quadric of a vertex in a frame
+static double* GetQuadric(SIMPLIFY_STRUCT* s, int v, int f)
+{
+	return &s->quadrics[((size_t)v * s->frame_count + f) * 10];
+}
+
+// return the position of a vertex in a frame
+static void GetPoint(const SIMPLIFY_STRUCT* s, int v, int f, double* p)
+{
+	const float* x = s->frames[f];
+
+	p[0] = x[v];
+	p[1] = x[s->vertex_count + v];
+	p[2] = x[2 * s->vertex_count + v];
+}
+
+// return the normal of a triangle, as long as twice its area
+static void GetNormal(const double* a, const double* b, const double* c, double* n)
+{
+	double u[3], v[3];
+	int i;
+
+	for (i = 0; i < 3; i++) {
+		u[i] = b[i] - a[i];
+		v[i] = c[i] - a[i];
+	}
+
+	n[0] = u[1] * v[2] - u[2] * v[1];
+	n[1] = u[2] * v[0] - u[0] * v[2];
+	n[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+// return the frame vertex of a corner of a face
+static int GetCorner(const SIMPLIFY_STRUCT* s, int face, int k)
+{
+	return s->mesh_vertex[s->corners[3 * face + k]];
+}
+
+// Give every vertex, in every frame, the planes of the faces around it.
+// A face that is a line or a point in a frame adds nothing to that frame.
+static void AddFacePlanes(SIMPLIFY_STRUCT* s)
+{
+	double p[3][3], n[3], len;
+	int i, f, k;
+
+	for (i = 0; i < s->face_count; i++) {
+		for (f = 0; f < s->frame_count; f++) {
+
+			for (k = 0; k < 3; k++) GetPoint(s, GetCorner(s, i, k), f, p[k]);
+
+			GetNormal(p[0], p[1], p[2], n);
+
+			len = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			if (len < 1e-12) continue;
+
+			n[0] /= len;  n[1] /= len;  n[2] /= len;
+
+			for (k = 0; k < 3; k++)
+				AddPlane(GetQuadric(s, GetCorner(s, i, k), f), n[0], n[1], n[2], -(n[0] * p[0][0] + n[1] * p[0][1] + n[2] * p[0][2]));
+		}
+	}
+}
+
+// Give both ends of an edge with one face the plane through the edge at
+// right angles to the face, so the border of the mesh keeps its shape.
+static void AddBorderPlanes(SIMPLIFY_STRUCT* s, int a, int b, int face)
+{
+	double p[3][3], e[3], n[3], m[3], len;
+	int f, k;
+
+	for (f = 0; f < s->frame_count; f++) {
+
+		for (k = 0; k < 3; k++) GetPoint(s, GetCorner(s, face, k), f, p[k]);
+
+		GetNormal(p[0], p[1], p[2], n);
+		GetPoint(s, a, f, p[0]);
+		GetPoint(s, b, f, p[1]);
+
+		for (k = 0; k < 3; k++) e[k] = p[1][k] - p[0][k];
+
+		m[0] = e[1] * n[2] - e[2] * n[1];
+		m[1] = e[2] * n[0] - e[0] * n[2];
+		m[2] = e[0] * n[1] - e[1] * n[0];
+
+		len = sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+		if (len < 1e-12) continue;
+
+		m[0] /= len;  m[1] /= len;  m[2] /= len;
+
+		AddPlane(GetQuadric(s, a, f), m[0], m[1], m[2], -(m[0] * p[0][0] + m[1] * p[0][1] + m[2] * p[0][2]));
+		AddPlane(GetQuadric(s, b, f), m[0], m[1], m[2], -(m[0] * p[0][0] + m[1] * p[0][1] + m[2] * p[0][2]));
+	}
+}
+
+//
+static int CompareSide(const void* a, const void* b)
+{
+	const SIDE_STRUCT* p = (const SIDE_STRUCT*)a;
+	const SIDE_STRUCT* q = (const SIDE_STRUCT*)b;
+
+	if (p->a != q->a) return (p->a < q->a ? -1 : 1);
+	if (p->b != q->b) return (p->b < q->b ? -1 : 1);
+	return 0;
+}
+
+// Price collapsing an edge either way. Moving a onto b costs the error of
+// the planes of both ends at b, summed over all frames, so the same
+// collapse is good for the whole animation.
+static void PriceEdge(SIMPLIFY_STRUCT* s, EDGE_STRUCT* e)
+{
+	double pa[3], pb[3], ab, ba;
+	double* qa, * qb;
+	int f;
+
+	ab = 0.0;
+	ba = 0.0;
+
+	for (f = 0; f < s->frame_count; f++) {
+
+		qa = GetQuadric(s, e->a, f);
+		qb = GetQuadric(s, e->b, f);
+
+		GetPoint(s, e->a, f, pa);
+		GetPoint(s, e->b, f, pb);
+
+		ab += GetQuadricError(qa, pb) + GetQuadricError(qb, pb);
+		ba += GetQuadricError(qa, pa) + GetQuadricError(qb, pa);
+	}
+
+	if (ab <= ba) {
+		e->from = e->a;
+		e->to = e->b;
+		e->cost = (ab > 0.0 ? ab : 0.0);
+	}
+	else {
+		e->from = e->b;
+		e->to = e->a;
+		e->cost = (ba > 0.0 ? ba : 0.0);
+	}
+
+	e->blocked = false;
+}
+
+// find the edges of the mesh, give the border its planes and price them
+static void BuildEdges(SIMPLIFY_STRUCT* s)
+{
+	SIDE_STRUCT* sides;
+	int i, j, k, a, b, n;
+
+	n = 3 * s->face_count;
+	sides = new SIDE_STRUCT[n];
+
+	for (i = 0; i < s->face_count; i++) {
+		for (k = 0; k < 3; k++) {
+			a = GetCorner(s, i, k);
+			b = GetCorner(s, i, (k + 1) % 3);
+			sides[3 * i + k].a = (a < b ? a : b);
+			sides[3 * i + k].b = (a < b ? b : a);
+			sides[3 * i + k].face = i;
+		}
+	}
+
+	qsort(sides, n, sizeof(SIDE_STRUCT), CompareSide);
+
+	s->edges = new EDGE_STRUCT[n];
+	s->edge_count = 0;
+
+	for (i = 0; i < n; i = j) {
+
+		for (j = i + 1; j < n && sides[j].a == sides[i].a && sides[j].b == sides[i].b; j++);
+
+		// a face with two corners on one vertex has no edge there
+		if (sides[i].a == sides[i].b) continue;
+
+		if (j - i == 1) AddBorderPlanes(s, sides[i].a, sides[i].b, sides[i].face);
+
+		s->edges[s->edge_count].a = sides[i].a;
+		s->edges[s->edge_count].b = sides[i].b;
+		s->edges[s->edge_count].live = true;
+		s->edge_count++;
+	}
+
+	for (i = 0; i < s->edge_count; i++) PriceEdge(s, &s->edges[i]);
+
+	s->work = new int[s->edge_count + 1];
+
+	delete[] sides;
+}
+
+// return the corner of a face on vertex v, or -1
+static int FindCorner(const SIMPLIFY_STRUCT* s, int face, int v)
+{
+	int k;
+
+	for (k = 0; k < 3; k++)
+		if (GetCorner(s, face, k) == v) return k;
+
+	return -1;
+}
+
+// Return true if vertex u can move onto vertex v. It cannot if no face
+// of either is left, which would take away a small piece of the model,
+// if u and v have a neighbour that is not on a face of the edge, which
+// would pinch the surface, or if a face that stays turns over in any frame.
+static bool CanCollapse(SIMPLIFY_STRUCT* s, int u, int v)
+{
+	double p[3][3], n0[3], n1[3];
+	int i, j, k, f, w, left;
+
+	s->stamp++;
+
+	// mark the neighbours of u, and the third corners of the faces of the edge
+	for (i = 0; i < s->face_count; i++) {
+
+		if (!s->faces[i] || FindCorner(s, i, u) < 0) continue;
+
+		for (k = 0; k < 3; k++) {
+			w = GetCorner(s, i, k);
+			if (w == u || w == v) continue;
+			s->neighbour[w] = s->stamp;
+			if (FindCorner(s, i, v) >= 0) s->shared[w] = s->stamp;
+		}
+	}
+
+	left = 0;
+
+	for (i = 0; i < s->face_count; i++) {
+
+		if (!s->faces[i] || (FindCorner(s, i, u) >= 0 && FindCorner(s, i, v) >= 0)) continue;
+
+		// a face of v that stays
+		if (FindCorner(s, i, v) >= 0) {
+
+			left++;
+
+			for (k = 0; k < 3; k++) {
+				w = GetCorner(s, i, k);
+				if (w != v && s->neighbour[w] == s->stamp && s->shared[w] != s->stamp) return false;
+			}
+
+			continue;
+		}
+
+		// a face of u that moves
+		j = FindCorner(s, i, u);
+		if (j < 0) continue;
+
+		left++;
+
+		for (f = 0; f < s->frame_count; f++) {
+
+			for (k = 0; k < 3; k++) GetPoint(s, GetCorner(s, i, k), f, p[k]);
+			GetNormal(p[0], p[1], p[2], n0);
+
+			GetPoint(s, v, f, p[j]);
+			GetNormal(p[0], p[1], p[2], n1);
+
+			if (n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2] < 0.0) return false;
+		}
+	}
+
+	return (left > 0);
+}
+
+// return the mesh vertex of frame vertex v with the s, t pair closest to
+// that of mesh vertex m, so a corner keeps its side of a texture seam
+static int GetNearestMeshVertex(SIMPLIFY_STRUCT* s, int m, int v)
+{
+	double ds, dt, d, min;
+	int i, best;
+
+	best = s->first[v];
+	min = -1.0;
+
+	for (i = s->first[v]; i >= 0; i = s->next[i]) {
+
+		ds = s->texcoords[2 * i] - s->texcoords[2 * m];
+		dt = s->texcoords[2 * i + 1] - s->texcoords[2 * m + 1];
+		d = ds * ds + dt * dt;
+
+		if (min < 0.0 || d < min) {
+			min = d;
+			best = i;
+		}
+	}
+
+	return best;
+}
+
+// move vertex u onto vertex v
+static void Collapse(SIMPLIFY_STRUCT* s, int u, int v)
+{
+	double* qu, * qv;
+	int i, j, k, f, n, w, hu, hv;
+
+	s->parent[u] = v;
+
+	// v now stands for the planes of both
+	for (f = 0; f < s->frame_count; f++) {
+		qu = GetQuadric(s, u, f);
+		qv = GetQuadric(s, v, f);
+		for (k = 0; k < 10; k++) qv[k] += qu[k];
+	}
+
+	// the faces on the edge go away, the others move their corner
+	for (i = 0; i < s->face_count; i++) {
+
+		if (!s->faces[i]) continue;
+
+		hu = hv = 0;
+		for (k = 0; k < 3; k++) {
+			if (GetCorner(s, i, k) == u) hu = 1;
+			if (GetCorner(s, i, k) == v) hv = 1;
+		}
+
+		if (hu && hv) {
+			s->faces[i] = false;
+			s->live_count--;
+			continue;
+		}
+
+		if (hu) {
+			for (k = 0; k < 3; k++)
+				if (GetCorner(s, i, k) == u)
+					s->corners[3 * i + k] = GetNearestMeshVertex(s, s->corners[3 * i + k], v);
+		}
+	}
+
+	// the edges of u become edges of v
+	for (i = n = 0; i < s->edge_count; i++) {
+
+		EDGE_STRUCT* e = &s->edges[i];
+
+		if (!e->live) continue;
+
+		if (e->a == u) e->a = v;
+		if (e->b == u) e->b = v;
+
+		if (e->a == e->b) e->live = false;
+		else if (e->a == v || e->b == v) s->work[n++] = i;
+	}
+
+	// an edge that both u and v had is there twice now
+	for (i = 0; i < n; i++) {
+
+		EDGE_STRUCT* e = &s->edges[s->work[i]];
+
+		if (!e->live) continue;
+
+		w = (e->a == v ? e->b : e->a);
+
+		for (j = i + 1; j < n; j++) {
+			EDGE_STRUCT* g = &s->edges[s->work[j]];
+			if (g->live && (g->a == w || g->b == w)) g->live = false;
+		}
+
+		PriceEdge(s, e);
+	}
+}
+
+// return the vertex that stands for vertex v now
+static int FindParent(SIMPLIFY_STRUCT* s, int v)
+{
+	int p;
+
+	while (s->parent[v] != v) {
+		p = s->parent[v];
+		s->parent[v] = s->parent[p];
+		v = p;
+	}
+
+	return v;
+}
+
+// return the squared distance of point p from triangle abc
+static double GetTriangleDistance(const double* p, const double* a, const double* b, const double* c)
+{
+	double ab[3], ac[3], ap[3], q[3], d1, d2, d3, d4, d5, d6, va, vb, vc, v, w;
+	int i;
+
+	for (i = 0; i < 3; i++) {
+		ab[i] = b[i] - a[i];
+		ac[i] = c[i] - a[i];
+		ap[i] = p[i] - a[i];
+	}
+
+	d1 = ab[0] * ap[0] + ab[1] * ap[1] + ab[2] * ap[2];
+	d2 = ac[0] * ap[0] + ac[1] * ap[1] + ac[2] * ap[2];
+	d3 = d1 - (ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2]);
+	d4 = d2 - (ab[0] * ac[0] + ab[1] * ac[1] + ab[2] * ac[2]);
+	d5 = d1 - (ab[0] * ac[0] + ab[1] * ac[1] + ab[2] * ac[2]);
+	d6 = d2 - (ac[0] * ac[0] + ac[1] * ac[1] + ac[2] * ac[2]);
+
+	// find the closest point by the region of the triangle p is in
+	va = d3 * d6 - d5 * d4;
+	vb = d5 * d2 - d1 * d6;
+	vc = d1 * d4 - d3 * d2;
+
+	if (d1 <= 0.0 && d2 <= 0.0) { v = 0.0; w = 0.0; }
+	else if (d3 >= 0.0 && d4 <= d3) { v = 1.0; w = 0.0; }
+	else if (d6 >= 0.0 && d5 <= d6) { v = 0.0; w = 1.0; }
+	else if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) { v = d1 / (d1 - d3); w = 0.0; }
+	else if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) { v = 0.0; w = d2 / (d2 - d6); }
+	else if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0) { w = (d4 - d3) / ((d4 - d3) + (d5 - d6)); v = 1.0 - w; }
+	else { v = vb / (va + vb + vc); w = vc / (va + vb + vc); }
+
+	for (i = 0; i < 3; i++) q[i] = a[i] + v * ab[i] + w * ac[i] - p[i];
+
+	return q[0] * q[0] + q[1] * q[1] + q[2] * q[2];
+}
+
+// Measure how far the vertices that were moved are from the level, in
+// every frame, each one from the faces around the vertex that stands for
+// it. The surface of the level may be closer, so these are upper bounds.
+// *max is the farthest of them and *mean their mean, the vertices that
+// were not moved are not counted. Both are 0 when no vertex was moved.
+static void GetMoved(SIMPLIFY_STRUCT* s, float* max, float* mean)
+{
+	double p[3], t[3][3], d, min, farthest, sum;
+	int* first, * next;
+	int i, j, k, f, v, n;
+
+	// the faces around every vertex, as linked lists
+	first = new int[s->vertex_count];
+	next = new int[3 * s->face_count];
+
+	for (i = 0; i < s->vertex_count; i++) first[i] = -1;
+
+	for (i = 0; i < 3 * s->face_count; i++) {
+		if (s->faces[i / 3]) {
+			v = GetCorner(s, i / 3, i % 3);
+			next[i] = first[v];
+			first[v] = i;
+		}
+	}
+
+	farthest = sum = 0.0;
+	n = 0;
+
+	for (i = 0; i < s->vertex_count; i++) {
+
+		v = FindParent(s, i);
+		if (v == i) continue;
+
+		for (f = 0; f < s->frame_count; f++) {
+
+			GetPoint(s, i, f, p);
+			GetPoint(s, v, f, t[0]);
+
+			min = (p[0] - t[0][0]) * (p[0] - t[0][0]) + (p[1] - t[0][1]) * (p[1] - t[0][1]) + (p[2] - t[0][2]) * (p[2] - t[0][2]);
+
+			for (j = first[v]; j >= 0; j = next[j]) {
+				for (k = 0; k < 3; k++) GetPoint(s, GetCorner(s, j / 3, k), f, t[k]);
+				d = GetTriangleDistance(p, t[0], t[1], t[2]);
+				if (d < min) min = d;
+			}
+
+			d = sqrt(min);
+			if (d > farthest) farthest = d;
+			sum += d;
+			n++;
+		}
+	}
+
+	*max = (float)farthest;
+	*mean = (float)(n > 0 ? sum / n : 0.0);
+
+	delete[] first;
+	delete[] next;
+}
+
+// keep the faces that are left as the indices of a level
+static void CopyLevel(SIMPLIFY_STRUCT* s, unsigned short** indices, int* count)
+{
+	int i, k, n;
+
+	*indices = new unsigned short[3 * s->live_count + 1];
+
+	for (i = n = 0; i < s->face_count; i++) {
+		if (s->faces[i]) {
+			for (k = 0; k < 3; k++) (*indices)[n++] = (unsigned short)s->corners[3 * i + k];
+		}
+	}
+
+	*count = n;
+
+	// the faces are in no useful order after the collapses
+	OptimizeTriangleOrder(*indices, n, s->positions, s->mesh_vertex_count);
+}
+
+// Build up to level_count levels of detail of a model. Every level has
+// about half the faces of the one before. Edges are collapsed cheapest
+// first, the cost is the quadric error summed over all stored frames, so
+// one triangle list fits the whole animation and the levels can be drawn
+// with any frame or pose. Level 0 is the welded mesh of the model. There
+// are fewer levels when no more edges can be collapsed, see CanCollapse.
+//
+// The quadrics need 80 bytes for every frame of every vertex while the
+// levels are built, 16 MB for a model of 1000 vertices and 200 frames.
+bool CMd2Lod::Create(CMd2File* file, int level_count)
+{
+	SIMPLIFY_STRUCT s;
+	EDGE_STRUCT* best;
+	const unsigned short* src;
+	int i, f, n, level, target, collapsed;
+
+	Free();
+
+	n = file->GetMeshIndexCount();
+
+	if (file->GetVertexCount() == 0 || n == 0) return false;
+
+	if (level_count > MD2_LOD_MAX_LEVELS) level_count = MD2_LOD_MAX_LEVELS;
+	if (level_count < 1) level_count = 1;
+
+	this->level_count = level_count;
+
+	// level 0 is the model
+	src = file->GetMeshIndices();
+	indices[0] = new unsigned short[n];
+	memcpy(indices[0], src, n * sizeof(unsigned short));
+	index_count[0] = n;
+
+	if (level_count == 1) return true;
+
+	s.vertex_count = file->GetVertexCount();
+	s.face_count = n / 3;
+	s.live_count = s.face_count;
+	s.mesh_vertex = file->GetMeshVertexIndices();
+	s.texcoords = file->GetMeshTexCoords();
+
+	// the frames dropped by CMd2File::Reduce are blends of the others
+	s.frames = new const float* [file->GetFrameCount()];
+	s.frame_count = 0;
+
+	for (f = 0; f < file->GetFrameCount(); f++)
+		if (file->GetFrameVertices(f) != NULL) s.frames[s.frame_count++] = file->GetFrameVertices(f);
+
+	s.quadrics = new double[(size_t)s.vertex_count * s.frame_count * 10];
+	memset(s.quadrics, 0, (size_t)s.vertex_count * s.frame_count * 10 * sizeof(double));
+
+	s.corners = new int[n];
+	s.faces = new bool[s.face_count];
+
+	for (i = 0; i < n; i++) s.corners[i] = src[i];
+	for (i = 0; i < s.face_count; i++) s.faces[i] = true;
+
+	// the mesh vertices of every frame vertex, as linked lists
+	s.mesh_vertex_count = file->GetMeshVertexCount();
+	s.first = new int[s.vertex_count];
+	s.next = new int[s.mesh_vertex_count];
+
+	for (i = 0; i < s.vertex_count; i++) s.first[i] = -1;
+
+	for (i = s.mesh_vertex_count - 1; i >= 0; i--) {
+		s.next[i] = s.first[s.mesh_vertex[i]];
+		s.first[s.mesh_vertex[i]] = i;
+	}
+
+	s.positions = new float[3 * s.mesh_vertex_count];
+
+	for (i = 0; i < s.mesh_vertex_count; i++) {
+		s.positions[3 * i] = s.frames[0][s.mesh_vertex[i]];
+		s.positions[3 * i + 1] = s.frames[0][s.vertex_count + s.mesh_vertex[i]];
+		s.positions[3 * i + 2] = s.frames[0][2 * s.vertex_count + s.mesh_vertex[i]];
+	}
+
+	s.neighbour = new int[s.vertex_count];
+	s.shared = new int[s.vertex_count];
+	s.parent = new int[s.vertex_count];
+	s.stamp = 0;
+
+	for (i = 0; i < s.vertex_count; i++) {
+		s.neighbour[i] = s.shared[i] = 0;
+		s.parent[i] = i;
+	}
+
+	AddFacePlanes(&s);
+	BuildEdges(&s);
+
+	collapsed = 0;
+	level = 1;
+	target = s.face_count / 2;
+
+	while (level < level_count && target > 0) {
+
+		if (s.live_count <= target) {
+			CopyLevel(&s, &indices[level], &index_count[level]);
+			GetMoved(&s, &error[level], &mean_error[level]);
+			level++;
+			target /= 2;
+			continue;
+		}
+
+		// the cheapest edge
+		best = NULL;
+
+		for (i = 0; i < s.edge_count; i++) {
+			EDGE_STRUCT* e = &s.edges[i];
+			if (e->live && !e->blocked && (best == NULL || e->cost < best->cost)) best = e;
+		}
+
+		// the faces around a blocked edge may have changed since, try them
+		// all again, and if none can go keep what is left as the last level
+		// if it has fewer faces than the one before
+		if (best == NULL) {
+
+			if (collapsed == 0) {
+				target = (3 * s.live_count < index_count[level - 1] ? s.live_count : 0);
+				continue;
+			}
+
+			for (i = 0; i < s.edge_count; i++) s.edges[i].blocked = false;
+
+			collapsed = 0;
+			continue;
+		}
+
+		if (!CanCollapse(&s, best->from, best->to)) {
+			best->blocked = true;
+			continue;
+		}
+
+		Collapse(&s, best->from, best->to);
+		collapsed++;
+	}
+
+	delete[] s.frames;
+	delete[] s.quadrics;
+	delete[] s.corners;
+	delete[] s.faces;
+	delete[] s.first;
+	delete[] s.next;
+	delete[] s.edges;
+	delete[] s.work;
+	delete[] s.neighbour;
+	delete[] s.shared;
+	delete[] s.parent;
+	delete[] s.positions;
+
+	// fewer levels if the mesh could not be simplified that far
+	this->level_count = level;
+
+	return true;
+}
+
+// return the number of levels
+int CMd2Lod::GetLevelCount()
+{
+	return level_count;
+}
+
+// return the number of indices of a level, 3 for every face
+int CMd2Lod::GetIndexCount(int level)
+{
+	return (level >= 0 && level < level_count ? index_count[level] : 0);
+}
+
+// return the indices of a level into the welded mesh of the model
+const unsigned short* CMd2Lod::GetIndices(int level)
+{
+	return (level >= 0 && level < level_count ? indices[level] : NULL);
+}
+
+// Return the farthest a vertex of the model is, in any frame, from the
+// faces of a level around the vertex that stands for it.
+float CMd2Lod::GetError(int level)
+{
+	return (level >= 0 && level < level_count ? error[level] : 0.0f);
+}
+
+// Return the mean of the same distances, over the vertices the level
+// moved in every frame.
+float CMd2Lod::GetMeanError(int level)
+{
+	return (level >= 0 && level < level_count ? mean_error[level] : 0.0f);
+}
+
+// Return the coarsest level whose mean error, seen from distance, covers
+// no more than pixels on the screen. So pixels is how far a vertex the
+// level moved is drawn from its place on average, some are farther, up to
+// GetError. projection is the height of the viewport in pixels divided
+// by 2 tan(fovy / 2).
+int CMd2Lod::SelectLevel(float distance, float projection, float pixels)
+{
+	int i;
+
+	for (i = level_count - 1; i > 0; i--)
+		if (mean_error[i] * projection <= pixels * distance) break;
+
+	return i;
+}
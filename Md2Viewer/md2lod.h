@@ -0,0 +1,49 @@
+/*
+   Class Name:
+
+	  CMd2Lod
+
+   Description:
+
+	  simplified versions of the welded mesh of an md2 model, one
+	  triangle list that is used for every frame of the animation
+
+*/
+
+#pragma once
+
+#include "md2file.h"
+
+// most levels of detail a model can have, level 0 is the model itself
+const int MD2_LOD_MAX_LEVELS = 4;
+
+class CMd2Lod
+{
+private:
+	int level_count;
+
+	// every level is a triangle list of 3 mesh vertices per face, see
+	// CMd2File::GetMeshIndices, with about half the faces of the level before
+	// error      - the farthest a vertex is from the level, in any frame
+	// mean_error - the mean distance of the vertices it moved, in every frame
+	int index_count[MD2_LOD_MAX_LEVELS];
+	unsigned short* indices[MD2_LOD_MAX_LEVELS];
+	float error[MD2_LOD_MAX_LEVELS];
+	float mean_error[MD2_LOD_MAX_LEVELS];
+
+public:
+
+	CMd2Lod();
+	~CMd2Lod();
+
+	bool Create(CMd2File* file, int level_count);
+	void Free();
+
+	int GetLevelCount();
+	int GetIndexCount(int level);
+	const unsigned short* GetIndices(int level);
+	float GetError(int level);
+	float GetMeanError(int level);
+
+	int SelectLevel(float distance, float projection, float pixels);
+};
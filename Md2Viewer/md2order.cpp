@@ -0,0 +1,376 @@
+/*
+   Function Name:
+
+	  OptimizeVertexCache, OptimizeOverdraw, OptimizeTriangleOrder,
+	  GetVertexCacheStats
+
+   Description:
+
+	  reorder an indexed triangle list so the vertices the gpu has just
+	  transformed are used again, then so faces in front are drawn first,
+	  and measure how well a list uses the vertex cache
+
+*/
+
+#include "platform.h"
+#include "md2order.h"
+
+// a run of triangles drawn together by OptimizeOverdraw
+typedef struct
+{
+	int first, last;        // triangles first to last - 1
+	float key;              // how far out the run faces, larger first
+}CLUSTER_STRUCT;
+
+// Score a vertex as in Forsyth's paper: vertices near the front of the
+// cache score high, the 3 of the last triangle a little less so that the
+// next triangle does not just turn around it, and vertices with few
+// triangles left score high so they are finished off.
+static float GetVertexScore(int position, int remaining)
+{
+	float score;
+
+	if (remaining == 0) return -1.0f;
+
+	if (position < 0) score = 0.0f;
+	else if (position < 3) score = 0.75f;
+	else score = powf(1.0f - (float)(position - 3) / (VERTEX_CACHE_SIZE - 3), 1.5f);
+
+	return score + 2.0f / sqrtf((float)remaining);
+}
+
+//
+void OptimizeVertexCache(unsigned short* indices, int index_count, int vertex_count)
+{
+	int cache[VERTEX_CACHE_SIZE + 3], next[VERTEX_CACHE_SIZE + 3];
+	int* remaining, * first, * triangles, * position;
+	float* vertex_score, * triangle_score;
+	bool* drawn;
+	unsigned short* out;
+	float score;
+	int i, j, k, n, t, v, best, count, cache_count;
+
+	count = index_count / 3;
+	if (count == 0 || vertex_count == 0) return;
+
+	remaining = new int[vertex_count];
+	first = new int[vertex_count + 1];
+	triangles = new int[3 * count];
+	position = new int[vertex_count];
+	vertex_score = new float[vertex_count];
+	triangle_score = new float[count];
+	drawn = new bool[count];
+	out = new unsigned short[3 * count];
+
+	// the triangles of every vertex, the ones drawn are moved past remaining
+	for (v = 0; v < vertex_count; v++) remaining[v] = 0;
+	for (i = 0; i < 3 * count; i++) remaining[indices[i]]++;
+
+	for (v = 0, first[0] = 0; v < vertex_count; v++) {
+		first[v + 1] = first[v] + remaining[v];
+		position[v] = first[v];
+	}
+
+	for (i = 0; i < 3 * count; i++) triangles[position[indices[i]]++] = i / 3;
+
+	for (v = 0; v < vertex_count; v++) {
+		position[v] = -1;
+		vertex_score[v] = GetVertexScore(-1, remaining[v]);
+	}
+
+	best = 0;
+
+	for (t = 0; t < count; t++) {
+		drawn[t] = false;
+		triangle_score[t] = vertex_score[indices[3 * t]] + vertex_score[indices[3 * t + 1]] + vertex_score[indices[3 * t + 2]];
+		if (triangle_score[t] > triangle_score[best]) best = t;
+	}
+
+	cache_count = 0;
+
+	for (n = 0; n < count; n++) {
+
+		// nothing in the cache has triangles left, start somewhere new
+		if (best < 0) {
+			for (t = 0; t < count; t++)
+				if (!drawn[t] && (best < 0 || triangle_score[t] > triangle_score[best])) best = t;
+		}
+
+		t = best;
+		drawn[t] = true;
+
+		out[3 * n] = indices[3 * t];
+		out[3 * n + 1] = indices[3 * t + 1];
+		out[3 * n + 2] = indices[3 * t + 2];
+
+		// the triangle is done for its vertices
+		for (j = 0; j < 3; j++) {
+
+			v = indices[3 * t + j];
+
+			for (i = first[v]; i < first[v] + remaining[v]; i++) {
+				if (triangles[i] == t) {
+					triangles[i] = triangles[first[v] + remaining[v] - 1];
+					triangles[first[v] + remaining[v] - 1] = t;
+					remaining[v]--;
+					break;
+				}
+			}
+		}
+
+		// its vertices go to the front of the cache
+		k = 0;
+
+		for (j = 0; j < 3; j++) {
+			v = indices[3 * t + j];
+			for (i = 0; i < k && next[i] != v; i++);
+			if (i == k) next[k++] = v;
+		}
+
+		for (i = 0; i < cache_count; i++) {
+			v = cache[i];
+			if (v != indices[3 * t] && v != indices[3 * t + 1] && v != indices[3 * t + 2]) next[k++] = v;
+		}
+
+		// and the last ones fall out
+		for (i = VERTEX_CACHE_SIZE; i < k; i++) {
+			v = next[i];
+			position[v] = -1;
+			vertex_score[v] = GetVertexScore(-1, remaining[v]);
+		}
+
+		cache_count = (k < VERTEX_CACHE_SIZE ? k : VERTEX_CACHE_SIZE);
+
+		for (i = 0; i < cache_count; i++) {
+			v = cache[i] = next[i];
+			position[v] = i;
+			vertex_score[v] = GetVertexScore(i, remaining[v]);
+		}
+
+		// score the triangles around the vertices that moved
+		best = -1;
+
+		for (i = 0; i < k; i++) {
+
+			v = next[i];
+
+			for (j = first[v]; j < first[v] + remaining[v]; j++) {
+
+				t = triangles[j];
+				score = vertex_score[indices[3 * t]] + vertex_score[indices[3 * t + 1]] + vertex_score[indices[3 * t + 2]];
+				triangle_score[t] = score;
+
+				if (i < cache_count && (best < 0 || score > triangle_score[best])) best = t;
+			}
+		}
+	}
+
+	memcpy(indices, out, 3 * count * sizeof(unsigned short));
+
+	delete[] remaining;
+	delete[] first;
+	delete[] triangles;
+	delete[] position;
+	delete[] vertex_score;
+	delete[] triangle_score;
+	delete[] drawn;
+	delete[] out;
+}
+
+// Return how many vertices of a triangle miss a first in first out cache.
+// A vertex is in the cache if fewer than cache_size misses came after it,
+// stamp holds the miss count when each vertex went in.
+static int CountMisses(const unsigned short* t, int* stamp, int* time, int cache_size)
+{
+	int j, misses;
+
+	misses = 0;
+
+	for (j = 0; j < 3; j++) {
+		if (*time - stamp[t[j]] > cache_size) {
+			stamp[t[j]] = ++*time;
+			misses++;
+		}
+	}
+
+	return misses;
+}
+
+//
+static int CompareCluster(const void* a, const void* b)
+{
+	const CLUSTER_STRUCT* p = (const CLUSTER_STRUCT*)a;
+	const CLUSTER_STRUCT* q = (const CLUSTER_STRUCT*)b;
+
+	if (p->key != q->key) return (p->key > q->key ? -1 : 1);
+	return p->first - q->first;
+}
+
+//
+void OptimizeOverdraw(unsigned short* indices, int index_count, const float* positions, int vertex_count, float threshold)
+{
+	CLUSTER_STRUCT* clusters;
+	unsigned short* out;
+	int* stamp, * hard;
+	const float* a, * b, * c;
+	double center[3], sum[3], normal[3], u[3], w[3], n[3], area, total, len;
+	float limit;
+	int i, j, k, t, count, time, misses, cluster_misses, hard_count, cluster_count;
+
+	count = index_count / 3;
+	if (count == 0 || vertex_count == 0) return;
+
+	stamp = new int[vertex_count];
+	hard = new int[count + 1];
+	clusters = new CLUSTER_STRUCT[count];
+	out = new unsigned short[3 * count];
+
+	for (i = 0; i < vertex_count; i++) stamp[i] = 0;
+
+	// a triangle that misses with all 3 vertices starts a cluster, the
+	// list jumped somewhere new there
+	time = VERTEX_CACHE_SIZE + 1;
+	hard_count = 0;
+
+	for (t = 0; t < count; t++)
+		if (CountMisses(&indices[3 * t], stamp, &time, VERTEX_CACHE_SIZE) == 3 || t == 0) hard[hard_count++] = t;
+
+	hard[hard_count] = count;
+
+	// cut a cluster again where what it has used the cache for so far is
+	// within threshold of the whole cluster, starting with an empty cache
+	cluster_count = 0;
+
+	for (i = 0; i < hard_count; i++) {
+
+		time += VERTEX_CACHE_SIZE + 1;
+		misses = 0;
+
+		for (t = hard[i]; t < hard[i + 1]; t++) misses += CountMisses(&indices[3 * t], stamp, &time, VERTEX_CACHE_SIZE);
+
+		limit = threshold * misses / (hard[i + 1] - hard[i]);
+
+		time += VERTEX_CACHE_SIZE + 1;
+		cluster_misses = 0;
+		clusters[cluster_count].first = hard[i];
+
+		for (t = hard[i]; t < hard[i + 1]; t++) {
+
+			cluster_misses += CountMisses(&indices[3 * t], stamp, &time, VERTEX_CACHE_SIZE);
+
+			if (t + 1 < hard[i + 1] && cluster_misses <= limit * (t + 1 - clusters[cluster_count].first)) {
+				clusters[cluster_count++].last = t + 1;
+				clusters[cluster_count].first = t + 1;
+				time += VERTEX_CACHE_SIZE + 1;
+				cluster_misses = 0;
+			}
+		}
+
+		clusters[cluster_count++].last = hard[i + 1];
+	}
+
+	// the center of the model
+	center[0] = center[1] = center[2] = 0.0;
+
+	for (i = 0; i < 3 * count; i++)
+		for (k = 0; k < 3; k++) center[k] += positions[3 * indices[i] + k];
+
+	for (k = 0; k < 3; k++) center[k] /= 3 * count;
+
+	// a cluster facing away from the center hides what is behind it
+	for (i = 0; i < cluster_count; i++) {
+
+		sum[0] = sum[1] = sum[2] = 0.0;
+		normal[0] = normal[1] = normal[2] = 0.0;
+		total = 0.0;
+
+		for (t = clusters[i].first; t < clusters[i].last; t++) {
+
+			a = &positions[3 * indices[3 * t]];
+			b = &positions[3 * indices[3 * t + 1]];
+			c = &positions[3 * indices[3 * t + 2]];
+
+			for (k = 0; k < 3; k++) {
+				u[k] = b[k] - a[k];
+				w[k] = c[k] - a[k];
+			}
+
+			n[0] = u[1] * w[2] - u[2] * w[1];
+			n[1] = u[2] * w[0] - u[0] * w[2];
+			n[2] = u[0] * w[1] - u[1] * w[0];
+
+			area = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+			for (k = 0; k < 3; k++) {
+				sum[k] += area * (a[k] + b[k] + c[k]) / 3.0;
+				normal[k] += n[k];
+			}
+
+			total += area;
+		}
+
+		len = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+		if (total > 0.0 && len > 0.0) {
+			clusters[i].key = (float)(((sum[0] / total - center[0]) * normal[0] +
+				(sum[1] / total - center[1]) * normal[1] +
+				(sum[2] / total - center[2]) * normal[2]) / len);
+		}
+		else clusters[i].key = 0.0f;
+	}
+
+	qsort(clusters, cluster_count, sizeof(CLUSTER_STRUCT), CompareCluster);
+
+	for (i = 0, j = 0; i < cluster_count; i++) {
+		k = 3 * (clusters[i].last - clusters[i].first);
+		memcpy(&out[j], &indices[3 * clusters[i].first], k * sizeof(unsigned short));
+		j += k;
+	}
+
+	memcpy(indices, out, 3 * count * sizeof(unsigned short));
+
+	delete[] stamp;
+	delete[] hard;
+	delete[] clusters;
+	delete[] out;
+}
+
+//
+void OptimizeTriangleOrder(unsigned short* indices, int index_count, const float* positions, int vertex_count)
+{
+	OptimizeVertexCache(indices, index_count, vertex_count);
+	OptimizeOverdraw(indices, index_count, positions, vertex_count, OVERDRAW_THRESHOLD);
+}
+
+//
+void GetVertexCacheStats(const unsigned short* indices, int index_count, int vertex_count, int cache_size, float* acmr, float* atvr)
+{
+	int* stamp;
+	int i, t, count, time, misses, used;
+
+	count = index_count / 3;
+
+	*acmr = 0.0f;
+	*atvr = 0.0f;
+
+	if (count == 0 || vertex_count == 0) return;
+
+	stamp = new int[vertex_count];
+
+	for (i = 0; i < vertex_count; i++) stamp[i] = 0;
+
+	time = cache_size + 1;
+	misses = 0;
+
+	for (t = 0; t < count; t++) misses += CountMisses(&indices[3 * t], stamp, &time, cache_size);
+
+	// a vertex that was never used still has its first stamp
+	used = 0;
+	for (i = 0; i < vertex_count; i++)
+		if (stamp[i] != 0) used++;
+
+	*acmr = (float)misses / count;
+	*atvr = (float)misses / used;
+
+	delete[] stamp;
+}
@@ -0,0 +1,44 @@
+/*
+   Function Name:
+
+	  OptimizeVertexCache, OptimizeOverdraw, OptimizeTriangleOrder,
+	  GetVertexCacheStats
+
+   Description:
+
+	  reorder an indexed triangle list so the vertices the gpu has just
+	  transformed are used again, then so faces in front are drawn first,
+	  and measure how well a list uses the vertex cache
+
+*/
+
+#pragma once
+
+// size of the post-transform cache OptimizeVertexCache orders for
+const int VERTEX_CACHE_SIZE = 32;
+
+// how much worse than the whole list a cluster of OptimizeOverdraw may use
+// the vertex cache
+const float OVERDRAW_THRESHOLD = 1.05f;
+
+// Order the triangles of a list of 3 indices per triangle so that each
+// triangle reuses the vertices in a cache of VERTEX_CACHE_SIZE as much
+// as it can (Tom Forsyth, Linear-Speed Vertex Cache Optimisation).
+void OptimizeVertexCache(unsigned short* indices, int index_count, int vertex_count);
+
+// Cut a list ordered by OptimizeVertexCache into clusters that use the
+// cache almost as well as the whole list and put the clusters that face
+// away from the center of the model first, so they hide what is behind
+// them (Sander et al., Fast Triangle Reordering for Vertex Locality and
+// Reduced Overdraw). positions holds x, y, z for every vertex.
+void OptimizeOverdraw(unsigned short* indices, int index_count, const float* positions, int vertex_count, float threshold);
+
+// both of the above
+void OptimizeTriangleOrder(unsigned short* indices, int index_count, const float* positions, int vertex_count);
+
+// Run a list through a first in first out cache of cache_size vertices.
+// acmr - average cache miss ratio, vertices transformed per triangle,
+//        0.5 at best for a large mesh and 3 at worst
+// atvr - average transform to vertex ratio, vertices transformed per
+//        vertex used, 1 at best
+void GetVertexCacheStats(const unsigned short* indices, int index_count, int vertex_count, int cache_size, float* acmr, float* atvr);
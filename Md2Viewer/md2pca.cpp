@@ -0,0 +1,455 @@
+/*
+   Class Name:
+
+	  CMd2Pca
+
+   Description:
+
+	  store the frames of an md2 model as a mean shape, a few basis
+	  shapes and the weights of the basis shapes in every frame
+
+*/
+
+#include "platform.h"
+#include "md2pca.h"
+#include "md2decode.h"
+
+// constructor
+CMd2Pca::CMd2Pca()
+{
+	file = NULL;
+	vertex_count = 0;
+	frame_count = 0;
+	component_count = 0;
+	face_count = 0;
+	mean = NULL;
+	basis = NULL;
+	weights = NULL;
+	scales = NULL;
+	corners = NULL;
+	error = 0.0f;
+}
+
+// destructor
+CMd2Pca::~CMd2Pca()
+{
+	Free();
+}
+
+//
+void CMd2Pca::Free()
+{
+	if (mean != NULL) {
+		delete[] mean;
+		mean = NULL;
+	}
+
+	if (basis != NULL) {
+		delete[] basis;
+		basis = NULL;
+	}
+
+	if (weights != NULL) {
+		delete[] weights;
+		weights = NULL;
+	}
+
+	if (scales != NULL) {
+		delete[] scales;
+		scales = NULL;
+	}
+
+	file = NULL;
+	corners = NULL;
+	vertex_count = 0;
+	frame_count = 0;
+	component_count = 0;
+	face_count = 0;
+	error = 0.0f;
+}
+
+// Find the eigenvalues and eigenvectors of a symmetric n x n matrix with
+// Jacobi rotations. The eigenvalues are left on the diagonal of a and the
+// eigenvectors in the columns of v.
+static void Jacobi(double* a, double* v, int n)
+{
+	double off, norm, theta, t, c, s, g, h;
+	int sweep, p, q, k;
+
+	norm = 0.0;
+
+	for (p = 0; p < n; p++)
+		for (q = 0; q < n; q++) {
+			v[p * n + q] = (p == q ? 1.0 : 0.0);
+			norm += a[p * n + q] * a[p * n + q];
+		}
+
+	for (sweep = 0; sweep < 50; sweep++) {
+
+		// stop when the matrix is diagonal as far as doubles can tell
+		off = 0.0;
+		for (p = 0; p < n; p++)
+			for (q = p + 1; q < n; q++)
+				off += a[p * n + q] * a[p * n + q];
+
+		if (off <= 1e-30 * norm) break;
+
+		for (p = 0; p < n; p++) {
+			for (q = p + 1; q < n; q++) {
+
+				if (fabs(a[p * n + q]) < 1e-300) continue;
+
+				// the rotation that makes a[p][q] zero
+				theta = (a[q * n + q] - a[p * n + p]) / (2.0 * a[p * n + q]);
+				t = (theta >= 0.0 ? 1.0 : -1.0) / (fabs(theta) + sqrt(theta * theta + 1.0));
+				c = 1.0 / sqrt(t * t + 1.0);
+				s = t * c;
+
+				for (k = 0; k < n; k++) {
+					g = a[k * n + p];
+					h = a[k * n + q];
+					a[k * n + p] = c * g - s * h;
+					a[k * n + q] = s * g + c * h;
+				}
+
+				for (k = 0; k < n; k++) {
+					g = a[p * n + k];
+					h = a[q * n + k];
+					a[p * n + k] = c * g - s * h;
+					a[q * n + k] = s * g + c * h;
+				}
+
+				for (k = 0; k < n; k++) {
+					g = v[k * n + p];
+					h = v[k * n + q];
+					v[k * n + p] = c * g - s * h;
+					v[k * n + q] = s * g + c * h;
+				}
+			}
+		}
+	}
+}
+
+// return the largest distance of a vertex from zero, the vertices are
+// an array of x then y then z
+static double MaxDistance(const double* r, int vc)
+{
+	double d, max;
+	int i;
+
+	max = 0.0;
+
+	for (i = 0; i < vc; i++) {
+		d = r[i] * r[i] + r[vc + i] * r[vc + i] + r[2 * vc + i] * r[2 * vc + i];
+		if (d > max) max = d;
+	}
+
+	return sqrt(max);
+}
+
+// Build the basis shapes from the frames of file. The fewest basis shapes
+// are used that rebuild every vertex of every frame within tolerance, but
+// never more than max_components. The frames are kept by file, which must
+// stay open while this object is used. A model reduced by
+// CMd2File::Reduce does not store every frame and is not supported.
+// return false if max_components are not enough for tolerance, or if the
+// result is not smaller than the frames in an md2 file
+//
+// The frames minus their mean are the rows of a matrix X. The basis shapes
+// are the eigenvectors of X^T X with the largest eigenvalues. There are
+// far fewer frames than floats in a frame, so they are found from the
+// small matrix X X^T instead: if X X^T v = e v, then X^T v is an
+// eigenvector of X^T X.
+//
+// Every basis shape is kept as shorts, scaled so that its largest float
+// is 32767. The weights of it are then fitted to what the basis shapes
+// before it left of every frame, and kept as shorts as well, so the
+// tolerance is met by what is stored and not by the doubles.
+bool CMd2Pca::Create(CMd2File* file, float tolerance, int max_components)
+{
+	double* x, * gram, * v, * row, * w;
+	const float* p;
+	float* rebuilt;
+	int* order;
+	double sum, e, d, step;
+	int i, j, k, f, g, n, vc, fc, tmp;
+
+	Free();
+
+	vc = file->GetVertexCount();
+	fc = file->GetFrameCount();
+	n = 3 * vc;
+
+	if (vc == 0 || fc == 0 || file->GetKeyCount() != fc || file->GetCorners() == NULL) return false;
+
+	if (max_components > MD2_PCA_MAX_COMPONENTS) max_components = MD2_PCA_MAX_COMPONENTS;
+	if (max_components > fc) max_components = fc;
+	if (max_components < 0) max_components = 0;
+
+	this->file = file;
+	vertex_count = vc;
+	frame_count = fc;
+	face_count = file->GetFaceCount();
+	corners = file->GetCorners();
+
+	// the mean shape
+	mean = new float[n];
+	x = new double[(size_t)fc * n];
+
+	for (j = 0; j < n; j++) {
+		sum = 0.0;
+		for (f = 0; f < fc; f++) sum += file->GetFrameVertices(f)[j];
+		mean[j] = (float)(sum / fc);
+	}
+
+	// the frames minus the mean
+	for (f = 0; f < fc; f++) {
+		p = file->GetFrameVertices(f);
+		for (j = 0; j < n; j++) x[(size_t)f * n + j] = (double)p[j] - mean[j];
+	}
+
+	// X X^T and its eigenvectors
+	gram = new double[(size_t)fc * fc];
+	v = new double[(size_t)fc * fc];
+
+	for (f = 0; f < fc; f++) {
+		for (g = f; g < fc; g++) {
+			sum = 0.0;
+			for (j = 0; j < n; j++) sum += x[(size_t)f * n + j] * x[(size_t)g * n + j];
+			gram[f * fc + g] = gram[g * fc + f] = sum;
+		}
+	}
+
+	Jacobi(gram, v, fc);
+
+	// largest eigenvalues first
+	order = new int[fc];
+	for (f = 0; f < fc; f++) order[f] = f;
+
+	for (f = 1; f < fc; f++)
+		for (g = f; g > 0 && gram[order[g] * fc + order[g]] > gram[order[g - 1] * fc + order[g - 1]]; g--) {
+			tmp = order[g]; order[g] = order[g - 1]; order[g - 1] = tmp;
+		}
+
+	basis = new short[(size_t)max_components * n + 1];
+	weights = new short[(size_t)fc * max_components + 1];
+	scales = new float[max_components + 1];
+	row = new double[n];
+	w = new double[fc];
+
+	// add basis shapes until the frames minus what the stored basis shapes
+	// rebuild are all within tolerance, x keeps what is left
+	for (k = 0; ; k++) {
+
+		d = 0.0;
+		for (f = 0; f < fc; f++) {
+			e = MaxDistance(&x[(size_t)f * n], vc);
+			if (e > d) d = e;
+		}
+
+		if (d <= tolerance || k == max_components) break;
+
+		e = gram[order[k] * fc + order[k]];
+		if (e <= 0.0) break;
+
+		// the basis shape, in steps of its largest float / 32767
+		for (j = 0; j < n; j++) row[j] = 0.0;
+
+		for (f = 0; f < fc; f++) {
+			e = v[f * fc + order[k]];
+			p = file->GetFrameVertices(f);
+			for (j = 0; j < n; j++) row[j] += e * ((double)p[j] - mean[j]);
+		}
+
+		step = 0.0;
+		for (j = 0; j < n; j++)
+			if (fabs(row[j]) > step) step = fabs(row[j]);
+
+		if (step <= 0.0) break;
+
+		for (j = 0; j < n; j++) {
+			basis[(size_t)k * n + j] = (short)floor(row[j] * 32767.0 / step + 0.5);
+			row[j] = basis[(size_t)k * n + j];
+		}
+
+		// the weight that fits what is left of every frame best
+		sum = 0.0;
+		for (j = 0; j < n; j++) sum += row[j] * row[j];
+
+		step = 0.0;
+
+		for (f = 0; f < fc; f++) {
+			e = 0.0;
+			for (j = 0; j < n; j++) e += x[(size_t)f * n + j] * row[j];
+			w[f] = e / sum;
+			if (fabs(w[f]) > step) step = fabs(w[f]);
+		}
+
+		if (step <= 0.0) break;
+
+		// the weights in steps of the largest / 32767, and what is left
+		step /= 32767.0;
+		scales[k] = (float)step;
+
+		for (f = 0; f < fc; f++) {
+
+			weights[(size_t)f * max_components + k] = (short)floor(w[f] / step + 0.5);
+			e = weights[(size_t)f * max_components + k] * (double)scales[k];
+
+			for (j = 0; j < n; j++) x[(size_t)f * n + j] -= e * row[j];
+		}
+	}
+
+	component_count = k;
+
+	// pack the weights, one frame after another
+	for (f = 0; f < fc; f++)
+		for (k = 0; k < component_count; k++)
+			weights[(size_t)f * component_count + k] = weights[(size_t)f * max_components + k];
+
+	delete[] x;
+	delete[] gram;
+	delete[] v;
+	delete[] order;
+	delete[] row;
+	delete[] w;
+
+	// a frame of an md2 file is a header and 4 bytes for every vertex
+	if (d > tolerance || GetSize() >= ((long long)offsetof(FRAME_STRUCT, data) + 4LL * vc) * fc) {
+		Free();
+		return false;
+	}
+
+	// measure the error of what is stored, not of the doubles above
+	rebuilt = new float[6 * vc];
+	error = 0.0f;
+
+	for (f = 0; f < fc; f++) {
+
+		GetFrame(f, rebuilt);
+		p = file->GetFrameVertices(f);
+
+		for (i = 0; i < vc; i++) {
+			d = 0.0;
+			for (j = 0; j < 3; j++) d += ((double)rebuilt[j * vc + i] - p[j * vc + i]) * ((double)rebuilt[j * vc + i] - p[j * vc + i]);
+			if ((float)sqrt(d) > error) error = (float)sqrt(d);
+		}
+	}
+
+	delete[] rebuilt;
+
+	return true;
+}
+
+// return the number of basis shapes
+int CMd2Pca::GetComponentCount()
+{
+	return component_count;
+}
+
+// Return the largest distance between a vertex of a frame and the same
+// vertex rebuilt by GetFrame. A pose from Evaluate is a blend of two
+// rebuilt frames, so its error is not larger.
+float CMd2Pca::GetError()
+{
+	return error;
+}
+
+// return the number of bytes used
+long long CMd2Pca::GetSize()
+{
+	long long n = 3LL * vertex_count;
+
+	return 4LL * n + 2LL * component_count * n + 2LL * frame_count * component_count + 4LL * component_count;
+}
+
+// Find the normals of a pose from its faces. The normal of a vertex is
+// the sum of the normals of the faces around it, which are as long as
+// the faces are large, scaled to unit length.
+void CMd2Pca::GetNormals(float* pose)
+{
+	const float* x, * y, * z;
+	float* nx, * ny, * nz;
+	float ux, uy, uz, vx, vy, vz, fx, fy, fz, len;
+	int i, a, b, c, vc;
+
+	vc = vertex_count;
+
+	x = pose;
+	y = x + vc;
+	z = y + vc;
+	nx = pose + 3 * vc;
+	ny = nx + vc;
+	nz = ny + vc;
+
+	for (i = 0; i < vc; i++) nx[i] = ny[i] = nz[i] = 0.0f;
+
+	for (i = 0; i < face_count; i++) {
+
+		a = corners[i];
+		b = corners[face_count + i];
+		c = corners[2 * face_count + i];
+
+		ux = x[b] - x[a];  uy = y[b] - y[a];  uz = z[b] - z[a];
+		vx = x[c] - x[a];  vy = y[c] - y[a];  vz = z[c] - z[a];
+
+		// the faces of the file go clockwise seen from the front, y and z
+		// swapped as in DecodeFrame they go counterclockwise
+		fx = uy * vz - uz * vy;
+		fy = uz * vx - ux * vz;
+		fz = ux * vy - uy * vx;
+
+		nx[a] += fx;  ny[a] += fy;  nz[a] += fz;
+		nx[b] += fx;  ny[b] += fy;  nz[b] += fz;
+		nx[c] += fx;  ny[c] += fy;  nz[c] += fz;
+	}
+
+	for (i = 0; i < vc; i++) {
+
+		len = sqrtf(nx[i] * nx[i] + ny[i] * ny[i] + nz[i] * nz[i]);
+		len = (len > 0.0f ? 1.0f / len : 0.0f);
+
+		nx[i] *= len;
+		ny[i] *= len;
+		nz[i] *= len;
+	}
+}
+
+// Rebuild a frame into a pose, see CMd2File::GetPoseSize.
+void CMd2Pca::GetFrame(int index, float* pose)
+{
+	float c[MD2_PCA_MAX_COMPONENTS];
+	const short* a;
+	int k;
+
+	a = &weights[(size_t)index * component_count];
+
+	for (k = 0; k < component_count; k++)
+		c[k] = scales[k] * a[k];
+
+	Reconstruct(mean, basis, c, component_count, 3 * vertex_count, pose);
+	GetNormals(pose);
+}
+
+// Compute the pose of the model at a time in seconds into a clip, as
+// CMd2File::Evaluate does. The weights of the two frames are blended
+// and the pose is rebuilt once, which is the same as blending the two
+// rebuilt frames.
+void CMd2Pca::Evaluate(const CLIP_STRUCT* clip, double time, float* pose)
+{
+	float c[MD2_PCA_MAX_COMPONENTS];
+	const short* a, * b;
+	float t;
+	int i0, i1, k;
+
+	file->GetClipFrames(clip, time, &i0, &i1, &t);
+
+	a = &weights[(size_t)i0 * component_count];
+	b = &weights[(size_t)i1 * component_count];
+
+	for (k = 0; k < component_count; k++)
+		c[k] = scales[k] * (a[k] + t * (b[k] - a[k]));
+
+	Reconstruct(mean, basis, c, component_count, 3 * vertex_count, pose);
+	GetNormals(pose);
+}
@@ -0,0 +1,58 @@
+/*
+   Class Name:
+
+	  CMd2Pca
+
+   Description:
+
+	  store the frames of an md2 model as a mean shape, a few basis
+	  shapes and the weights of the basis shapes in every frame, the
+	  basis shapes and the weights as 16 bit steps
+
+*/
+
+#pragma once
+
+#include "md2file.h"
+
+// most basis shapes a model can have
+const int MD2_PCA_MAX_COMPONENTS = 64;
+
+class CMd2Pca
+{
+private:
+	CMd2File* file;
+	int vertex_count, frame_count, component_count, face_count;
+
+	// a frame is mean + scales[0] * weights[0] * basis[0] + ...
+	// mean    - 3 * vertex_count floats, x then y then z
+	// basis   - component_count rows of 3 * vertex_count shorts
+	// weights - component_count shorts for every frame
+	// scales  - the size of a step of the weights of every basis shape
+	// corners - the faces of the file, the normals are found from them
+	float* mean;
+	short* basis;
+	short* weights;
+	float* scales;
+	const int* corners;
+
+	// largest distance between a vertex and its rebuilt position
+	float error;
+
+	void GetNormals(float* pose);
+	void Free();
+
+public:
+
+	CMd2Pca();
+	~CMd2Pca();
+
+	bool Create(CMd2File* file, float tolerance, int max_components);
+
+	int GetComponentCount();
+	float GetError();
+	long long GetSize();
+
+	void GetFrame(int index, float* pose);
+	void Evaluate(const CLIP_STRUCT* clip, double time, float* pose);
+};
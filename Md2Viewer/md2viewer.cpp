@@ -2,6 +2,7 @@
 //   This program will load an md2 file and perform animation.
 //   To start the animation select menu Tools -> Control.
 //   On the dialog box, slide the scroll bar to do animation.
+//   Or select menu Tools -> Play to play it smoothly in real time.
 // 
 //   Up Arrow Key     - move forward
 //   Down Arrow Key   - move backward
@@ -9,13 +10,14 @@
 //   Left Arrow Key   - rotate left
 //   S                - strafe left
 //   D                - strafe right
+//   Left Button      - pick the triangle under the cursor
 
 #include "framework.h"
 #include "md2viewer.h"
 #include "camera.h"
-#include "terrain.h"
-#include "md2file.h"
-#include "pngfile.h"
+#include "scene.h"
+#include "glrender.h"
+#include "texturecache.h"
 #include "messagedialog.h"
 #include "framedialog.h"
 
@@ -27,12 +29,11 @@ WCHAR szTitle[MAX_LOADSTRING];                  // The title bar text
 WCHAR szWindowClass[MAX_LOADSTRING];            // the main window class name
 
 CCamera camera;
-CTerrain terrain;
-CMd2File file1;
-CPngFile file2;
+CScene scene1;
+CGlRender render1;
+CTextureCache cache1;
 CMessageDialog dlg1;
 CFrameDialog dlg2;
-GLuint textures;
 
 // Forward declarations of functions included in this code module:
 LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
@@ -43,12 +44,11 @@ void OnFrameIndex(HWND hWnd, WPARAM wParam, LPARAM lParam);
 
 void MoveCamera(double t);
 
-void DrawAxis();
-
 void OnPaint(HDC hDC);
 void OnCreate(HWND hWnd, HDC* hDC);
 void OnDestroy(HWND hWnd, HDC hDC);
 void OnSize(HWND hWnd, int cx, int cy);
+void OnLButtonDown(HWND hWnd, int x, int y);
 
 void OnFileOpen(HWND hWnd);
 void OnFileExit(HWND hWnd);
@@ -56,8 +56,12 @@ void OnFileExit(HWND hWnd);
 void OnViewPoint(HWND hWnd);
 void OnViewWireframe(HWND hWnd);
 void OnViewSolid(HWND hWnd);
+void OnViewTriangles(HWND hWnd);
+void OnViewStrips(HWND hWnd);
+void OnViewNextSkin(HWND hWnd);
 
 void OnToolsControl(HWND hWnd);
+void OnToolsPlay(HWND hWnd);
 
 int APIENTRY wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine, _In_ int nCmdShow)
 {
@@ -150,7 +154,11 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 		case IDM_POINT:		OnViewPoint(hWnd);		break;
 		case IDM_WIREFRAME:	OnViewWireframe(hWnd);	break;
 		case IDM_SOLID:		OnViewSolid(hWnd);		break;
+		case IDM_TRIANGLES:	OnViewTriangles(hWnd);	break;
+		case IDM_STRIPS:	OnViewStrips(hWnd);		break;
+		case IDM_NEXT_SKIN:	OnViewNextSkin(hWnd);	break;
 		case IDM_CONTROL:	OnToolsControl(hWnd);   break;
+		case IDM_PLAY:		OnToolsPlay(hWnd);		break;
 		default:
 			return DefWindowProc(hWnd, message, wParam, lParam);
 		}
@@ -160,6 +168,7 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 	case WM_CREATE:  OnCreate(hWnd, &hDC);							break;
 	case WM_DESTROY: OnDestroy(hWnd, hDC);							break;
 	case WM_SIZE:    OnSize(hWnd, LOWORD(lParam), HIWORD(lParam)); break;
+	case WM_LBUTTONDOWN: OnLButtonDown(hWnd, GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam)); break;
 	default:
 		return DefWindowProc(hWnd, message, wParam, lParam);
 	}
@@ -182,7 +191,9 @@ INT_PTR CALLBACK DlgProc2(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 void OnFrameIndex(HWND hWnd, WPARAM wParam, LPARAM lParam)
 {
 	int index = (int)lParam;
-	file1.SetFrame(index);
+
+	// the scroll bar stops the animation at that frame
+	scene1.SetFrame(index);
 }
 
 // Move the camera based on time rather than frame rate.
@@ -202,33 +213,12 @@ void MoveCamera(double t)
 	if (GetKeyState('D') & 0x80)      camera.StrafeRight(a * t);
 }
 
-// draw x, y and z axis
-void DrawAxis()
-{
-	glBegin(GL_LINES);
-
-	glColor3f(1.0f, 0.0f, 0.0f);
-	glVertex3d(0.0, 0.05, 0.0);
-	glVertex3d(500.0, 0.05, 0.0);
-
-	glColor3f(0.0f, 1.0f, 0.0f);
-	glVertex3d(0.0, 0.05, 0.0);
-	glVertex3d(0.0, 500.0, 0.0);
-
-	glColor3f(0.0f, 0.0f, 1.0f);
-	glVertex3d(0.0, 0.05, 0.0);
-	glVertex3d(0.0, 0.05, 500.0);
-
-	glEnd();
-}
-
 //
 void OnPaint(HDC hDC)
 {
 	static DWORD t1 = GetTickCount();
 	DWORD t2;
 	double t;
-	int i, params[4];
 
 	// move camera based on time
 	t2 = GetTickCount();
@@ -237,45 +227,10 @@ void OnPaint(HDC hDC)
 
 	MoveCamera(t);
 
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-	glLoadIdentity();
-	gluLookAt(camera.eyex, camera.eyey, camera.eyez, camera.centerx, camera.centery, camera.centerz, camera.upx, camera.upy, camera.upz);
-
-	// save
-	glGetIntegerv(GL_POLYGON_MODE, params);
-	glDisable(GL_TEXTURE_2D);
+	// animate the model based on time
+	scene1.Update(t);
 
-	// draw terrain
-	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-	glColor3f(0.8f, 0.8f, 0.8f);
-	terrain.Draw();
-
-	// draw axis
-	DrawAxis();
-
-	// restore
-	glPolygonMode(GL_FRONT_AND_BACK, params[0]);
-	glEnable(GL_TEXTURE_2D);
-
-	// draw model
-	glBegin(GL_TRIANGLES);
-	glColor3f(1.0f, 1.0f, 1.0f);
-
-	for (i = 0; i < file1.GetFaceCount(); ++i) {
-
-		glNormal3f(file1[i].nx, file1[i].ny, file1[i].nz);
-
-		glTexCoord2f(file1[i].s1, file1[i].t1);
-		glVertex3f(file1[i].x1, file1[i].y1, file1[i].z1);
-
-		glTexCoord2f(file1[i].s2, file1[i].t2);;
-		glVertex3f(file1[i].x2, file1[i].y2, file1[i].z2);
-
-		glTexCoord2f(file1[i].s3, file1[i].t3);
-		glVertex3f(file1[i].x3, file1[i].y3, file1[i].z3);
-	}
-	glEnd();
+	scene1.Draw(&render1, &camera);
 
 	SwapBuffers(hDC);
 }
@@ -316,23 +271,13 @@ void OnCreate(HWND hWnd, HDC* hDC)
 	// set camera inital position
 	camera.SetPosition(108.19099, 1.6, 99.08579, 107.52732, 1.6, 98.33775, 0.0, 1.0, 0.0);
 
-	// create terrain
-	terrain.Create(500.0f, 500);
-
-	// clear window
-	glClearColor(1.0f, 1.0f, 1.0f, 0.0f);
-	glEnable(GL_DEPTH_TEST);
+	// create terrain, the skins of the models go in cache1
+	scene1.Create(&cache1);
 
 	// set blending parameter
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	// set up texture parameter
-	glGenTextures(1, &textures);
-	glBindTexture(GL_TEXTURE_2D, textures);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
 	char str[100];
 	OutputDebugStringA("-----------------------------------------------------------------------------\n");
 	sprintf_s(str, 100, "OpenGL Version :%s\n", glGetString(GL_VERSION));   OutputDebugStringA(str);
@@ -347,7 +292,7 @@ void OnCreate(HWND hWnd, HDC* hDC)
 //
 void OnDestroy(HWND hWnd, HDC hDC)
 {
-	glDeleteTextures(1, &textures);
+	cache1.Clear(&render1);
 
 	HGLRC hglRC;					// rendering context
 
@@ -362,29 +307,20 @@ void OnDestroy(HWND hWnd, HDC hDC)
 //
 void OnSize(HWND hWnd, int cx, int cy)
 {
-	double fovy, aspect, zNear, zFar;
-
-	fovy = 45.0;
-	aspect = (double)cx / (double)cy;
-	zNear = 0.1;
-	zFar = 1000.0;
-
-	glViewport(0, 0, cx, cy);
-
-	glMatrixMode(GL_PROJECTION);
-	glLoadIdentity();
-	gluPerspective(fovy, aspect, zNear, zFar);
+	scene1.SetViewport(cx, cy);
+}
 
-	glMatrixMode(GL_MODELVIEW);
-	glLoadIdentity();
+// pick the triangle under the cursor
+void OnLButtonDown(HWND hWnd, int x, int y)
+{
+	scene1.Pick(&camera, x, y);
 }
 
 //
 void OnFileOpen(HWND hWnd)
 {
 	OPENFILENAME fn;
-	TCHAR szFile1[MAX_PATH] = L"", szFile2[MAX_PATH], str[MAX_PATH];
-	char name[100];
+	TCHAR szFile1[MAX_PATH] = L"", str[MAX_PATH];
 
 	ZeroMemory(&fn, sizeof(OPENFILENAME));
 
@@ -399,27 +335,16 @@ void OnFileOpen(HWND hWnd)
 
 	if (!GetOpenFileName(&fn)) return;
 
-	if (!file1.Open(szFile1)) {
+	if (!scene1.Open(szFile1)) {
 		dlg1.Show(hWnd, hInst, DlgProc1, L"Cannot open file: Not md2 file.");
 		return;
 	}
 
-	// get texture filename
-	file1.GetTextureName(name, 100);
-	MultiByteToWideChar(CP_UTF8, 0, name, -1, szFile2, MAX_PATH);
-
-	if (!file2.Open(szFile2)) {
+	if (!scene1.IsSkinLoaded()) {
 		dlg1.Show(hWnd, hInst, DlgProc1, L"Cannot open file: Not png file.");
 		return;
 	}
 
-	// set up texture image
-	switch (file2.color_type)
-	{
-	case PNG_COLOR_TYPE_RGB:       gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGB, file2.width, file2.height, GL_RGB, GL_UNSIGNED_BYTE, file2.buffer); break;
-	case PNG_COLOR_TYPE_RGB_ALPHA: gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGBA, file2.width, file2.height, GL_RGBA, GL_UNSIGNED_BYTE, file2.buffer); break;
-	}
-
 	// set window title to include filename
 	swprintf_s(str, MAX_PATH, L"%s - %s", szTitle, szFile1);
 	SetWindowText(hWnd, str);
@@ -434,23 +359,47 @@ void OnFileExit(HWND hWnd)
 //
 void OnViewPoint(HWND hWnd)
 {
-	glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
+	scene1.SetPolygonMode(RENDER_POINT);
 }
 
 //
 void OnViewWireframe(HWND hWnd)
 {
-	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	scene1.SetPolygonMode(RENDER_LINE);
 }
 
 //
 void OnViewSolid(HWND hWnd)
 {
-	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	scene1.SetPolygonMode(RENDER_FILL);
+}
+
+// draw the model as a list of triangles
+void OnViewTriangles(HWND hWnd)
+{
+	scene1.SetStrips(false);
+}
+
+// draw the model with triangle strips and fans
+void OnViewStrips(HWND hWnd)
+{
+	scene1.SetStrips(true);
+}
+
+// draw the model with its next skin, one whose file was not read is skipped
+void OnViewNextSkin(HWND hWnd)
+{
+	scene1.NextSkin();
 }
 
 //
 void OnToolsControl(HWND hWnd)
 {
-	dlg2.Show(hWnd, hInst, DlgProc2, 0, file1.GetFrameCount());
+	dlg2.Show(hWnd, hInst, DlgProc2, 0, scene1.GetFile()->GetFrameCount());
+}
+
+// start or stop the animation
+void OnToolsPlay(HWND hWnd)
+{
+	scene1.TogglePlay();
 }
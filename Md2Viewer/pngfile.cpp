@@ -5,11 +5,11 @@
 
    Description:
 
-	  open png file
+	  open and save png file
 
 */
 
-#include "framework.h"
+#include "platform.h"
 #include "pngfile.h"
 
 // constructor
@@ -162,3 +162,79 @@ Close_File:
 
 	return result;
 }
+
+// Write buffer into a png file, with width, height and color_type set
+// the same way Open sets them: 8 bits a channel, RGB or RGBA, and every
+// row 4-byte aligned
+bool CPngFile::Save(wchar_t* szFile)
+{
+	FILE* fp;
+	bool result;
+	int channels, rowbytes;
+	png_bytep* row_pointers;
+	png_structp png_ptr;
+	png_infop info_ptr;
+	unsigned int i;
+
+	if (buffer == NULL || width == 0 || height == 0) return false;
+	if (color_type != PNG_COLOR_TYPE_RGB && color_type != PNG_COLOR_TYPE_RGB_ALPHA) return false;
+
+	channels = (color_type == PNG_COLOR_TYPE_RGB_ALPHA ? 4 : 3);
+	rowbytes = (width * channels + 3) & ~3;
+
+	// open file for writing
+	if (_wfopen_s(&fp, szFile, L"wb") != 0) return false;
+
+	result = true;
+	row_pointers = NULL;
+
+	// allocate and initialize png_struct
+	png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+	if (!png_ptr) {
+		result = false;
+		goto Close_File;
+	}
+
+	// allocate and initialize png_info
+	info_ptr = png_create_info_struct(png_ptr);
+	if (!info_ptr) {
+		png_destroy_write_struct(&png_ptr, (png_infopp)NULL);
+		result = false;
+		goto Close_File;
+	}
+
+	row_pointers = new png_bytep[height];
+
+	for (i = 0; i < height; i++)
+		row_pointers[i] = buffer + i * rowbytes;
+
+	// set up error handling
+	if (setjmp(png_jmpbuf(png_ptr))) {
+		png_destroy_write_struct(&png_ptr, &info_ptr);
+		result = false;
+		goto Close_File;
+	}
+
+	// set up the output code
+	png_init_io(png_ptr, fp);
+
+	png_set_IHDR(png_ptr, info_ptr, width, height, 8, color_type, PNG_INTERLACE_NONE,
+		PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+
+	// write the header, the whole image and the end of the file
+	png_write_info(png_ptr, info_ptr);
+	png_write_image(png_ptr, row_pointers);
+	png_write_end(png_ptr, NULL);
+
+	// free all memory
+	png_destroy_write_struct(&png_ptr, &info_ptr);
+
+Close_File:
+
+	if (row_pointers != NULL) delete[] row_pointers;
+
+	// close file
+	if (fclose(fp) != 0) result = false;
+
+	return result;
+}
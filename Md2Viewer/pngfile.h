@@ -5,12 +5,14 @@
 
    Description:
 
-	  open png file
+	  open and save png file
 
 */
 
 #pragma once
 
+#include <png.h>
+
 class CPngFile
 {
 	// variable
@@ -25,4 +27,5 @@ public:
 	~CPngFile();
 
 	bool Open(wchar_t* filename);
+	bool Save(wchar_t* filename);
 };
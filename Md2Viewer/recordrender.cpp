@@ -0,0 +1,130 @@
+/*
+   Class Name:
+
+	  CRecordRender
+
+   Description:
+
+	  draw nothing, only count what would have been sent to the graphics
+	  library, to measure a frame with no window
+
+*/
+
+#include "platform.h"
+#include "recordrender.h"
+
+// constructor
+CRecordRender::CRecordRender()
+{
+	memset(&stats, 0, sizeof(stats));
+	next_texture = 1;
+}
+
+// destructor
+CRecordRender::~CRecordRender()
+{
+}
+
+// the textures are kept, only the counts start again
+void CRecordRender::ResetStats()
+{
+	int textures = stats.textures;
+
+	memset(&stats, 0, sizeof(stats));
+	stats.textures = textures;
+}
+
+//
+const RENDER_STATS_STRUCT* CRecordRender::GetStats()
+{
+	return &stats;
+}
+
+//
+void CRecordRender::BeginFrame(int /* width */, int /* height */, const float* /* color */)
+{
+	stats.frames++;
+}
+
+//
+void CRecordRender::EndFrame()
+{
+}
+
+//
+void CRecordRender::SetMatrices(const float* /* projection */, const float* /* modelview */)
+{
+	stats.state_changes++;
+}
+
+//
+void CRecordRender::SetPolygonMode(int /* mode */)
+{
+	stats.state_changes++;
+}
+
+//
+void CRecordRender::SetDepthTest(bool /* enable */)
+{
+	stats.state_changes++;
+}
+
+//
+void CRecordRender::SetColor(float /* r */, float /* g */, float /* b */)
+{
+	stats.state_changes++;
+}
+
+//
+void CRecordRender::SetTexture(int /* texture */)
+{
+	stats.state_changes++;
+}
+
+// hand out numbers as OpenGL hands out texture names
+int CRecordRender::CreateTexture(int width, int height, int channels, const unsigned char* /* pixels */)
+{
+	int row;
+
+	if (channels != 3 && channels != 4) return 0;
+
+	row = (width * channels + 3) & ~3;
+
+	stats.bytes += (long long)row * height;
+	stats.textures++;
+
+	return next_texture++;
+}
+
+//
+void CRecordRender::DeleteTexture(int texture)
+{
+	if (texture != 0) stats.textures--;
+}
+
+// one draw call of vertex_count vertices, read through index_count
+// indices of index_size bytes, or in order if there are none
+void CRecordRender::Count(int format, int vertex_count, int index_count, int index_size)
+{
+	stats.draw_calls++;
+	stats.vertices += (index_count > 0 ? index_count : vertex_count);
+	stats.bytes += (long long)vertex_count * GetVertexSize(format) * sizeof(float) + (long long)index_count * index_size;
+}
+
+//
+void CRecordRender::Draw(int /* primitive */, int format, const float* /* vertices */, int vertex_count)
+{
+	Count(format, vertex_count, 0, 0);
+}
+
+//
+void CRecordRender::DrawIndexed(int /* primitive */, int format, const float* /* vertices */, int vertex_count, const unsigned short* /* indices */, int index_count)
+{
+	Count(format, vertex_count, index_count, sizeof(unsigned short));
+}
+
+//
+void CRecordRender::DrawIndexed(int /* primitive */, int format, const float* /* vertices */, int vertex_count, const unsigned int* /* indices */, int index_count)
+{
+	Count(format, vertex_count, index_count, sizeof(unsigned int));
+}
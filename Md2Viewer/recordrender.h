@@ -0,0 +1,58 @@
+/*
+   Class Name:
+
+	  CRecordRender
+
+   Description:
+
+	  draw nothing, only count what would have been sent to the graphics
+	  library, to measure a frame with no window
+
+*/
+
+#pragma once
+
+#include "render.h"
+
+// data structure for what a CRecordRender was asked to do
+typedef struct
+{
+	int frames;
+	int draw_calls;
+	long long vertices;     // vertices drawn, an indexed vertex once for every index
+	long long bytes;        // bytes of vertices, indices and textures handed over
+	int state_changes;      // calls that set a matrix, mode, color or texture
+	int textures;           // textures made and not deleted
+}RENDER_STATS_STRUCT;
+
+class CRecordRender : public CRender
+{
+private:
+	RENDER_STATS_STRUCT stats;
+	int next_texture;
+
+	void Count(int format, int vertex_count, int index_count, int index_size);
+
+public:
+	CRecordRender();
+	~CRecordRender();
+
+	void BeginFrame(int width, int height, const float* color);
+	void EndFrame();
+
+	void SetMatrices(const float* projection, const float* modelview);
+	void SetPolygonMode(int mode);
+	void SetDepthTest(bool enable);
+	void SetColor(float r, float g, float b);
+	void SetTexture(int texture);
+
+	int CreateTexture(int width, int height, int channels, const unsigned char* pixels);
+	void DeleteTexture(int texture);
+
+	void Draw(int primitive, int format, const float* vertices, int vertex_count);
+	void DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned short* indices, int index_count);
+	void DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned int* indices, int index_count);
+
+	const RENDER_STATS_STRUCT* GetStats();
+	void ResetStats();
+};
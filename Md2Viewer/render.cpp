@@ -0,0 +1,89 @@
+/*
+   Function Name:
+
+	  GetVertexSize, GetPerspective, GetLookAt, MultiplyMatrix
+
+   Description:
+
+	  the vertex layouts and matrices shared by every CRender
+
+*/
+
+#include "platform.h"
+#include "render.h"
+
+//
+int GetVertexSize(int format)
+{
+	return (format == RENDER_T2F_N3F_V3F ? 8 : 3);
+}
+
+// the matrix gluPerspective makes
+void GetPerspective(float* m, double fovy, double aspect, double z_near, double z_far)
+{
+	double f = 1.0 / tan(fovy / 2.0 * M_PI / 180.0);
+	int i;
+
+	for (i = 0; i < 16; i++) m[i] = 0.0f;
+
+	m[0] = (float)(f / aspect);
+	m[5] = (float)f;
+	m[10] = (float)((z_far + z_near) / (z_near - z_far));
+	m[11] = -1.0f;
+	m[14] = (float)(2.0 * z_far * z_near / (z_near - z_far));
+}
+
+// the matrix gluLookAt makes
+void GetLookAt(float* m, double ex, double ey, double ez, double cx, double cy, double cz, double ux, double uy, double uz)
+{
+	double f[3], s[3], u[3], len;
+	int i;
+
+	// line of sight
+	f[0] = cx - ex;
+	f[1] = cy - ey;
+	f[2] = cz - ez;
+
+	len = sqrt(f[0] * f[0] + f[1] * f[1] + f[2] * f[2]);
+	if (len > 0.0) { f[0] /= len;  f[1] /= len;  f[2] /= len; }
+
+	// side = sight x up
+	s[0] = f[1] * uz - f[2] * uy;
+	s[1] = f[2] * ux - f[0] * uz;
+	s[2] = f[0] * uy - f[1] * ux;
+
+	len = sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+	if (len > 0.0) { s[0] /= len;  s[1] /= len;  s[2] /= len; }
+
+	// up = side x sight
+	u[0] = s[1] * f[2] - s[2] * f[1];
+	u[1] = s[2] * f[0] - s[0] * f[2];
+	u[2] = s[0] * f[1] - s[1] * f[0];
+
+	for (i = 0; i < 3; i++) {
+		m[4 * i] = (float)s[i];
+		m[4 * i + 1] = (float)u[i];
+		m[4 * i + 2] = (float)-f[i];
+		m[4 * i + 3] = 0.0f;
+	}
+
+	m[12] = (float)-(s[0] * ex + s[1] * ey + s[2] * ez);
+	m[13] = (float)-(u[0] * ex + u[1] * ey + u[2] * ez);
+	m[14] = (float)(f[0] * ex + f[1] * ey + f[2] * ez);
+	m[15] = 1.0f;
+}
+
+// m = a b, m may not be a or b
+void MultiplyMatrix(float* m, const float* a, const float* b)
+{
+	int i, j, k;
+	float sum;
+
+	for (j = 0; j < 4; j++) {
+		for (i = 0; i < 4; i++) {
+			sum = 0.0f;
+			for (k = 0; k < 4; k++) sum += a[4 * k + i] * b[4 * j + k];
+			m[4 * j + i] = sum;
+		}
+	}
+}
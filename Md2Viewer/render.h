@@ -0,0 +1,74 @@
+/*
+   Class Name:
+
+	  CRender
+
+   Description:
+
+	  what drawing a frame needs from a graphics library, so the same
+	  scene can be drawn with OpenGL or with no window at all
+
+*/
+
+#pragma once
+
+// kinds of primitive
+enum
+{
+	RENDER_LINES,           // 2 vertices per line
+	RENDER_TRIANGLES,       // 3 vertices per triangle
+	RENDER_QUADS            // 4 vertices per quad, drawn as 2 triangles
+};
+
+// layouts of a vertex
+enum
+{
+	RENDER_V3F,             // x, y, z
+	RENDER_T2F_N3F_V3F      // s, t, nx, ny, nz, x, y, z, see MD2_STREAM_SIZE
+};
+
+// how polygons are drawn
+enum
+{
+	RENDER_POINT,           // the corners
+	RENDER_LINE,            // the edges
+	RENDER_FILL             // the inside
+};
+
+// return the number of floats of a vertex of a layout
+int GetVertexSize(int format);
+
+// 4 x 4 matrices of 16 floats, column after column as OpenGL keeps them
+void GetPerspective(float* m, double fovy, double aspect, double z_near, double z_far);
+void GetLookAt(float* m, double ex, double ey, double ez, double cx, double cy, double cz, double ux, double uy, double uz);
+void MultiplyMatrix(float* m, const float* a, const float* b);
+
+class CRender
+{
+public:
+	virtual ~CRender() {}
+
+	// start a frame of width x height pixels cleared to color (r, g, b, a)
+	// and the far plane, and finish it
+	virtual void BeginFrame(int width, int height, const float* color) = 0;
+	virtual void EndFrame() = 0;
+
+	// state, kept until it is set again
+	// a texture of 0 draws without a texture
+	virtual void SetMatrices(const float* projection, const float* modelview) = 0;
+	virtual void SetPolygonMode(int mode) = 0;
+	virtual void SetDepthTest(bool enable) = 0;
+	virtual void SetColor(float r, float g, float b) = 0;
+	virtual void SetTexture(int texture) = 0;
+
+	// Textures of 3 or 4 bytes per pixel, RGB or RGBA, with every row
+	// starting on a 4 byte boundary as CPngFile reads them.
+	// return the texture, 0 if it cannot be made
+	virtual int CreateTexture(int width, int height, int channels, const unsigned char* pixels) = 0;
+	virtual void DeleteTexture(int texture) = 0;
+
+	// draw vertices in order, or the vertices the indices point to
+	virtual void Draw(int primitive, int format, const float* vertices, int vertex_count) = 0;
+	virtual void DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned short* indices, int index_count) = 0;
+	virtual void DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned int* indices, int index_count) = 0;
+};
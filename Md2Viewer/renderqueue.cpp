@@ -0,0 +1,402 @@
+/*
+   Class Name:
+
+	  CRenderQueue
+
+   Description:
+
+	  keep the draws of a frame with the state each one was asked with,
+	  sort them by a 64 bit key when the frame ends and send them to
+	  another CRender with only the state changes that are needed
+
+*/
+
+#include "platform.h"
+#include "renderqueue.h"
+
+// return true if two states draw the same way
+static bool IsSameState(const QUEUE_STATE_STRUCT* a, const QUEUE_STATE_STRUCT* b)
+{
+	return (a->matrices == b->matrices && a->polygon_mode == b->polygon_mode && a->depth_test == b->depth_test &&
+		a->color[0] == b->color[0] && a->color[1] == b->color[1] && a->color[2] == b->color[2] &&
+		a->texture == b->texture);
+}
+
+// constructor
+CRenderQueue::CRenderQueue()
+{
+	target = NULL;
+	sorted = true;
+
+	width = 1;
+	height = 1;
+	clear_color[0] = clear_color[1] = clear_color[2] = clear_color[3] = 0.0f;
+
+	memset(&current, 0, sizeof(current));
+	current.matrices = -1;
+	current.polygon_mode = RENDER_FILL;
+	current.color[0] = current.color[1] = current.color[2] = 1.0f;
+	depth = 0.0f;
+
+	matrices = NULL;
+	matrix_count = 0;
+	matrix_capacity = 0;
+
+	states = NULL;
+	state_count = 0;
+	state_capacity = 0;
+
+	items = NULL;
+	item_count = 0;
+	item_capacity = 0;
+
+	keys = NULL;
+	scratch = NULL;
+	key_capacity = 0;
+
+	memset(&stats, 0, sizeof(stats));
+}
+
+// destructor
+CRenderQueue::~CRenderQueue()
+{
+	if (matrices != NULL) delete[] matrices;
+	if (states != NULL) delete[] states;
+	if (items != NULL) delete[] items;
+	if (keys != NULL) delete[] keys;
+	if (scratch != NULL) delete[] scratch;
+}
+
+// the render the frame is sent to when it ends
+void CRenderQueue::SetTarget(CRender* target)
+{
+	this->target = target;
+}
+
+// sort the draws, or send them in the order they were asked for with
+// only the state changes taken out that set what is already set
+void CRenderQueue::SetSorted(bool enable)
+{
+	sorted = enable;
+}
+
+// distance from the eye of what is drawn next, the opaque pass draws the
+// near things first so the far ones fail the depth test
+void CRenderQueue::SetDepth(float depth)
+{
+	this->depth = depth;
+}
+
+//
+const QUEUE_STATS_STRUCT* CRenderQueue::GetStats()
+{
+	return &stats;
+}
+
+//
+void CRenderQueue::ResetStats()
+{
+	memset(&stats, 0, sizeof(stats));
+}
+
+// the frame is started on the target when it ends
+void CRenderQueue::BeginFrame(int width, int height, const float* color)
+{
+	int i;
+
+	this->width = width;
+	this->height = height;
+	for (i = 0; i < 4; i++) clear_color[i] = color[i];
+
+	matrix_count = 0;
+	state_count = 0;
+	item_count = 0;
+
+	current.matrices = -1;
+	depth = 0.0f;
+
+	stats.frames++;
+}
+
+// sort the draws and send the whole frame
+void CRenderQueue::EndFrame()
+{
+	if (target == NULL) return;
+
+	Sort();
+	Submit();
+}
+
+// the matrices are kept until the frame is sent, the same ones set again
+// are kept once so the draws with them have the same state
+void CRenderQueue::SetMatrices(const float* projection, const float* modelview)
+{
+	float* p;
+	int i;
+
+	stats.state_calls++;
+
+	for (i = matrix_count - 1; i >= 0; i--) {
+		p = &matrices[32 * i];
+
+		if (memcmp(p, projection, 16 * sizeof(float)) == 0 && memcmp(p + 16, modelview, 16 * sizeof(float)) == 0) {
+			current.matrices = i;
+			return;
+		}
+	}
+
+	if (matrix_count == matrix_capacity) {
+		matrix_capacity = (matrix_capacity == 0 ? 4 : 2 * matrix_capacity);
+		p = new float[32 * matrix_capacity];
+		if (matrix_count > 0) memcpy(p, matrices, 32 * matrix_count * sizeof(float));
+		if (matrices != NULL) delete[] matrices;
+		matrices = p;
+	}
+
+	p = &matrices[32 * matrix_count];
+	memcpy(p, projection, 16 * sizeof(float));
+	memcpy(p + 16, modelview, 16 * sizeof(float));
+
+	current.matrices = matrix_count++;
+}
+
+//
+void CRenderQueue::SetPolygonMode(int mode)
+{
+	stats.state_calls++;
+	current.polygon_mode = mode;
+}
+
+//
+void CRenderQueue::SetDepthTest(bool enable)
+{
+	stats.state_calls++;
+	current.depth_test = enable;
+}
+
+//
+void CRenderQueue::SetColor(float r, float g, float b)
+{
+	stats.state_calls++;
+	current.color[0] = r;
+	current.color[1] = g;
+	current.color[2] = b;
+}
+
+//
+void CRenderQueue::SetTexture(int texture)
+{
+	stats.state_calls++;
+	current.texture = texture;
+}
+
+// textures belong to the target, they are made and deleted right away
+int CRenderQueue::CreateTexture(int width, int height, int channels, const unsigned char* pixels)
+{
+	return (target != NULL ? target->CreateTexture(width, height, channels, pixels) : 0);
+}
+
+//
+void CRenderQueue::DeleteTexture(int texture)
+{
+	if (target != NULL) target->DeleteTexture(texture);
+}
+
+// Find the current state among the states of the frame, or add it.
+// A frame has few different states, so they are searched from the last.
+// return the index of the state
+int CRenderQueue::UseState()
+{
+	QUEUE_STATE_STRUCT* p;
+	int i;
+
+	for (i = state_count - 1; i >= 0; i--)
+		if (IsSameState(&states[i], &current)) return i;
+
+	if (state_count == state_capacity) {
+		state_capacity = (state_capacity == 0 ? 16 : 2 * state_capacity);
+		p = new QUEUE_STATE_STRUCT[state_capacity];
+		if (state_count > 0) memcpy(p, states, state_count * sizeof(QUEUE_STATE_STRUCT));
+		if (states != NULL) delete[] states;
+		states = p;
+	}
+
+	states[state_count++] = current;
+
+	return state_count - 1;
+}
+
+// keep a draw with the current state and depth
+void CRenderQueue::AddItem(int primitive, int format, const float* vertices, int vertex_count, const void* indices, int index_size, int index_count)
+{
+	QUEUE_ITEM_STRUCT* p;
+
+	if (vertex_count <= 0) return;
+
+	if (item_count == item_capacity) {
+		item_capacity = (item_capacity == 0 ? 64 : 2 * item_capacity);
+		p = new QUEUE_ITEM_STRUCT[item_capacity];
+		if (item_count > 0) memcpy(p, items, item_count * sizeof(QUEUE_ITEM_STRUCT));
+		if (items != NULL) delete[] items;
+		items = p;
+	}
+
+	p = &items[item_count++];
+	p->primitive = primitive;
+	p->format = format;
+	p->vertices = vertices;
+	p->vertex_count = vertex_count;
+	p->indices = indices;
+	p->index_size = index_size;
+	p->index_count = index_count;
+	p->state = UseState();
+	p->depth = depth;
+
+	stats.draws++;
+}
+
+// the vertices and indices must be kept until the frame ends
+void CRenderQueue::Draw(int primitive, int format, const float* vertices, int vertex_count)
+{
+	AddItem(primitive, format, vertices, vertex_count, NULL, 0, 0);
+}
+
+//
+void CRenderQueue::DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned short* indices, int index_count)
+{
+	if (index_count > 0) AddItem(primitive, format, vertices, vertex_count, indices, sizeof(unsigned short), index_count);
+}
+
+//
+void CRenderQueue::DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned int* indices, int index_count)
+{
+	if (index_count > 0) AddItem(primitive, format, vertices, vertex_count, indices, sizeof(unsigned int), index_count);
+}
+
+// Make the key of every draw and sort them with a radix sort, 8 bits at
+// a time from the lowest. The sort is stable, so draws with the same key
+// stay in the order they were asked for. A byte that is the same in every
+// key is skipped.
+void CRenderQueue::Sort()
+{
+	const QUEUE_STATE_STRUCT* s;
+	QUEUE_KEY_STRUCT* t;
+	unsigned long long key;
+	unsigned int bits;
+	int count[256];
+	int i, shift, n, sum;
+	float d;
+
+	if (item_count > key_capacity) {
+		if (keys != NULL) delete[] keys;
+		if (scratch != NULL) delete[] scratch;
+
+		key_capacity = item_capacity;
+		keys = new QUEUE_KEY_STRUCT[key_capacity];
+		scratch = new QUEUE_KEY_STRUCT[key_capacity];
+	}
+
+	for (i = 0; i < item_count; i++) {
+		s = &states[items[i].state];
+
+		if (!sorted) {
+			key = (unsigned long long)i;
+		}
+		else if (s->depth_test) {
+			// a float that is not negative sorts the same as its bits
+			d = (items[i].depth > 0.0f ? items[i].depth : 0.0f);
+			memcpy(&bits, &d, sizeof(bits));
+
+			key = ((unsigned long long)QUEUE_PASS_OPAQUE << 62) |
+				((unsigned long long)(s->texture & 0x3fff) << 48) |
+				((unsigned long long)(items[i].state & 0xffff) << 32) | bits;
+		}
+		else {
+			key = ((unsigned long long)QUEUE_PASS_OVERLAY << 62) | (unsigned long long)i;
+		}
+
+		keys[i].key = key;
+		keys[i].item = i;
+	}
+
+	for (shift = 0; shift < 64; shift += 8) {
+		memset(count, 0, sizeof(count));
+
+		for (i = 0; i < item_count; i++)
+			count[(keys[i].key >> shift) & 0xff]++;
+
+		if (item_count == 0 || count[(keys[0].key >> shift) & 0xff] == item_count) continue;
+
+		for (i = 0, sum = 0; i < 256; i++) {
+			n = count[i];
+			count[i] = sum;
+			sum += n;
+		}
+
+		for (i = 0; i < item_count; i++)
+			scratch[count[(keys[i].key >> shift) & 0xff]++] = keys[i];
+
+		t = keys;
+		keys = scratch;
+		scratch = t;
+	}
+}
+
+// send the frame in the order of the keys, a state is set only when it
+// is not what the target has already
+void CRenderQueue::Submit()
+{
+	const QUEUE_ITEM_STRUCT* item;
+	const QUEUE_STATE_STRUCT* s;
+	const QUEUE_STATE_STRUCT* last;
+	int i;
+
+	target->BeginFrame(width, height, clear_color);
+
+	last = NULL;
+
+	for (i = 0; i < item_count; i++) {
+		item = &items[keys[i].item];
+		s = &states[item->state];
+
+		if (last != s) {
+			if (last == NULL || last->matrices != s->matrices) {
+				if (s->matrices >= 0) {
+					target->SetMatrices(&matrices[32 * s->matrices], &matrices[32 * s->matrices + 16]);
+					stats.state_changes++;
+				}
+			}
+
+			if (last == NULL || last->polygon_mode != s->polygon_mode) {
+				target->SetPolygonMode(s->polygon_mode);
+				stats.state_changes++;
+			}
+
+			if (last == NULL || last->depth_test != s->depth_test) {
+				target->SetDepthTest(s->depth_test);
+				stats.state_changes++;
+			}
+
+			if (last == NULL || last->color[0] != s->color[0] || last->color[1] != s->color[1] || last->color[2] != s->color[2]) {
+				target->SetColor(s->color[0], s->color[1], s->color[2]);
+				stats.state_changes++;
+			}
+
+			if (last == NULL || last->texture != s->texture) {
+				target->SetTexture(s->texture);
+				stats.state_changes++;
+			}
+
+			last = s;
+		}
+
+		if (item->index_size == 0)
+			target->Draw(item->primitive, item->format, item->vertices, item->vertex_count);
+		else if (item->index_size == sizeof(unsigned short))
+			target->DrawIndexed(item->primitive, item->format, item->vertices, item->vertex_count, (const unsigned short*)item->indices, item->index_count);
+		else
+			target->DrawIndexed(item->primitive, item->format, item->vertices, item->vertex_count, (const unsigned int*)item->indices, item->index_count);
+	}
+
+	target->EndFrame();
+}
@@ -0,0 +1,127 @@
+/*
+   Class Name:
+
+	  CRenderQueue
+
+   Description:
+
+	  keep the draws of a frame with the state each one was asked with,
+	  sort them by a 64 bit key when the frame ends and send them to
+	  another CRender with only the state changes that are needed
+
+*/
+
+#pragma once
+
+#include "render.h"
+
+// passes of a frame, drawn one after the other
+enum
+{
+	QUEUE_PASS_OPAQUE,      // depth tested, by texture, then state, then front to back
+	QUEUE_PASS_OVERLAY      // not depth tested, in the order they were asked for
+};
+
+// data structure for the state of a draw
+typedef struct
+{
+	int matrices;           // index into the matrices of the frame
+	int polygon_mode;
+	bool depth_test;
+	float color[3];
+	int texture;
+}QUEUE_STATE_STRUCT;
+
+// data structure for a draw, the vertices and indices are not copied
+typedef struct
+{
+	int primitive, format;
+	const float* vertices;
+	int vertex_count;
+	const void* indices;    // NULL, or index_count unsigned short or unsigned int
+	int index_size;         // 0, 2 or 4 bytes
+	int index_count;
+	int state;
+	float depth;
+}QUEUE_ITEM_STRUCT;
+
+// data structure for a sort key and the draw it belongs to
+// key is pass in bits 62 and 63, then for the opaque pass the texture in
+// bits 48 to 61, the state in bits 32 to 47 and the depth in bits 0 to 31,
+// and for the overlay pass the draw in bits 0 to 31
+typedef struct
+{
+	unsigned long long key;
+	int item;
+}QUEUE_KEY_STRUCT;
+
+// data structure for what a CRenderQueue was asked for and what it sent
+typedef struct
+{
+	int frames;
+	int draws;
+	int state_calls;        // calls that set a matrix, mode, color or texture
+	int state_changes;      // of them, the ones sent to the render
+}QUEUE_STATS_STRUCT;
+
+class CRenderQueue : public CRender
+{
+private:
+	CRender* target;
+	bool sorted;
+
+	int width, height;
+	float clear_color[4];
+
+	// state asked for since the last draw
+	QUEUE_STATE_STRUCT current;
+	float depth;
+
+	// every projection and modelview of the frame, 32 floats each
+	float* matrices;
+	int matrix_count, matrix_capacity;
+
+	// the different states of the frame and the draws
+	QUEUE_STATE_STRUCT* states;
+	int state_count, state_capacity;
+	QUEUE_ITEM_STRUCT* items;
+	int item_count, item_capacity;
+
+	QUEUE_KEY_STRUCT* keys;
+	QUEUE_KEY_STRUCT* scratch;
+	int key_capacity;
+
+	QUEUE_STATS_STRUCT stats;
+
+	int UseState();
+	void AddItem(int primitive, int format, const float* vertices, int vertex_count, const void* indices, int index_size, int index_count);
+	void Sort();
+	void Submit();
+
+public:
+	CRenderQueue();
+	~CRenderQueue();
+
+	void SetTarget(CRender* target);
+	void SetSorted(bool enable);
+	void SetDepth(float depth);
+
+	void BeginFrame(int width, int height, const float* color);
+	void EndFrame();
+
+	void SetMatrices(const float* projection, const float* modelview);
+	void SetPolygonMode(int mode);
+	void SetDepthTest(bool enable);
+	void SetColor(float r, float g, float b);
+	void SetTexture(int texture);
+
+	int CreateTexture(int width, int height, int channels, const unsigned char* pixels);
+	void DeleteTexture(int texture);
+
+	void Draw(int primitive, int format, const float* vertices, int vertex_count);
+	void DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned short* indices, int index_count);
+	void DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned int* indices, int index_count);
+
+	const QUEUE_STATS_STRUCT* GetStats();
+	void ResetStats();
+};
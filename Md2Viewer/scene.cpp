@@ -0,0 +1,473 @@
+/*
+   Class Name:
+
+	  CScene
+
+   Description:
+
+	  the terrain, the axes and one animated md2 model, drawn through a
+	  CRender so the viewer and the headless tools share the same frame
+
+*/
+
+#include "platform.h"
+#include "scene.h"
+#include "camera.h"
+#include "render.h"
+#include "texturecache.h"
+
+// constructor
+CScene::CScene()
+{
+	cache = NULL;
+	skins = NULL;
+	skin_count = 0;
+	skin = 0;
+	stream = NULL;
+	command_indices = NULL;
+	command_index_count = 0;
+	pose = NULL;
+	memset(&clip, 0, sizeof(clip));
+	anim_time = 0.0;
+	playing = false;
+	strips = true;
+	ground = true;
+	polygon_mode = RENDER_FILL;
+	picked.face = -1;
+	lod_made = false;
+	lod_pixels = 1.0f;
+
+	width = 1;
+	height = 1;
+	fovy = 45.0;
+	z_near = 0.1;
+	z_far = 1000.0;
+	projection = 1.0;
+}
+
+// destructor
+CScene::~CScene()
+{
+	Free();
+}
+
+// release what was made for the model
+void CScene::Free()
+{
+	if (stream != NULL) {
+		delete[] stream;
+		stream = NULL;
+	}
+
+	if (command_indices != NULL) {
+		delete[] command_indices;
+		command_indices = NULL;
+	}
+
+	if (pose != NULL) {
+		delete[] pose;
+		pose = NULL;
+	}
+
+	if (skins != NULL) {
+		delete[] skins;
+		skins = NULL;
+	}
+
+	command_index_count = 0;
+	skin_count = 0;
+	skin = 0;
+
+	lod.Free();
+	lod_made = false;
+	bvh.Free();
+	picked.face = -1;
+}
+
+// make the terrain, the skins are read into cache
+void CScene::Create(CTextureCache* cache)
+{
+	this->cache = cache;
+
+	terrain.Create(500.0f, 500);
+}
+
+// the file named by the skin, in the folder of the md2 file instead of
+// where the skin name says
+// return false if the path is too long
+static bool GetSkinPath(const wchar_t* filename, const wchar_t* skin, wchar_t* path)
+{
+	const wchar_t* p;
+	size_t i, n;
+
+	n = 0;
+	for (i = 0; filename[i] != L'\0'; i++)
+		if (filename[i] == L'/' || filename[i] == L'\\') n = i + 1;
+
+	p = skin;
+	for (i = 0; skin[i] != L'\0'; i++)
+		if (skin[i] == L'/' || skin[i] == L'\\') p = skin + i + 1;
+
+	if (n + wcslen(p) + 1 > MAX_PATH) return false;
+
+	wcsncpy_s(path, MAX_PATH, filename, n);
+	wcscpy_s(path + n, MAX_PATH - n, p);
+
+	return true;
+}
+
+// Open an md2 file and get it ready to draw, play and pick, then read
+// its skins. A skin is looked for where its name says, then next to the
+// md2 file. A png file that an earlier model used is not read again.
+// return false if it is not an md2 file, the scene then has no model
+bool CScene::Open(wchar_t* filename)
+{
+	wchar_t path[MAX_PATH], other[MAX_PATH];
+	char name[MD2_SKIN_NAME_SIZE];
+	int i, n;
+
+	Free();
+
+	if (!file.Open(filename)) return false;
+
+	// room for the vertices of one frame for either the mesh or the
+	// command list
+	n = file.GetMeshVertexCount();
+	if (n < file.GetCommandVertexCount()) n = file.GetCommandVertexCount();
+
+	stream = new float[MD2_STREAM_SIZE * n];
+
+	command_indices = new unsigned int[3 * file.GetCommandVertexCount() + 1];
+	command_index_count = file.GetCommandIndices(command_indices);
+
+	// draw order for the vertex cache and overdraw, the simpler meshes for
+	// when the model is far away take much longer and are made when they
+	// are first needed
+	file.OptimizeMesh();
+
+	// the faces in a tree, to pick them
+	bvh.Create(&file);
+
+	// play all frames
+	pose = new float[file.GetPoseSize()];
+
+	strcpy_s(clip.name, 16, "all");
+	clip.first = 0;
+	clip.count = file.GetFrameCount();
+	clip.fps = MD2_FPS;
+	anim_time = 0.0;
+
+	skin_count = file.GetSkinCount();
+	skins = new int[skin_count + 1];
+
+	for (i = 0; i < skin_count; i++) {
+		file.GetSkinName(i, name, MD2_SKIN_NAME_SIZE);
+		PlatformUtf8ToWide(name, path, MAX_PATH);
+		skins[i] = (cache != NULL ? cache->Load(path) : -1);
+
+		if (skins[i] < 0 && cache != NULL && GetSkinPath(filename, path, other))
+			skins[i] = cache->Load(other);
+	}
+
+	return true;
+}
+
+// return true if the first skin of the model was read
+bool CScene::IsSkinLoaded()
+{
+	return (skin_count > 0 && skins[0] >= 0);
+}
+
+// look at the model where it is now, just far enough to see all of it
+// angle is in degrees around the y axis, 0 looks at the front
+void CScene::LookAtModel(CCamera* camera, double angle)
+{
+	BOUNDS_STRUCT b;
+	double d, a;
+
+	if (pose == NULL) return;
+
+	file.GetBounds(&clip, anim_time, &b);
+	d = b.radius / sin(fovy / 2.0 * M_PI / 180.0);
+	a = angle * M_PI / 180.0;
+
+	camera->SetPosition(b.center[0] + d * sin(a), b.center[1], b.center[2] + d * cos(a), b.center[0], b.center[1], b.center[2], 0.0, 1.0, 0.0);
+}
+
+//
+void CScene::SetViewport(int cx, int cy)
+{
+	width = (cx > 0 ? cx : 1);
+	height = (cy > 0 ? cy : 1);
+
+	projection = height / (2.0 * tan(fovy / 2.0 * M_PI / 180.0));
+}
+
+// play the animation t seconds further
+void CScene::Update(double t)
+{
+	if (!playing || pose == NULL) return;
+
+	anim_time += t;
+	file.Evaluate(&clip, anim_time, pose);
+	file.SetPose(pose);
+}
+
+// stop the animation at a frame
+void CScene::SetFrame(int index)
+{
+	if (pose == NULL) return;
+
+	playing = false;
+	anim_time = (index - clip.first) / clip.fps;
+
+	file.SetFrame(index);
+}
+
+// start or stop the animation
+void CScene::TogglePlay()
+{
+	playing = !playing;
+}
+
+// draw the model with the strips and fans, or as a list of triangles
+void CScene::SetStrips(bool enable)
+{
+	strips = enable;
+}
+
+// how the model is drawn, the terrain is always drawn with lines
+void CScene::SetPolygonMode(int mode)
+{
+	polygon_mode = mode;
+}
+
+// draw the model with its next skin, one whose file was not read is skipped
+void CScene::NextSkin()
+{
+	int i;
+
+	for (i = 1; i <= skin_count; i++) {
+		if (skins[(skin + i) % skin_count] >= 0) {
+			skin = (skin + i) % skin_count;
+			break;
+		}
+	}
+}
+
+// sort the draws of a frame before they are sent to the render, or send
+// them in the order they are made
+void CScene::SetSorted(bool enable)
+{
+	queue.SetSorted(enable);
+}
+
+// how many pixels on the screen the vertices a level moved may be drawn
+// from their place on average, see CMd2Lod::SelectLevel, 1 if not set
+// a level with fewer faces is drawn from nearer when it is larger
+void CScene::SetLodPixels(float pixels)
+{
+	lod_pixels = pixels;
+}
+
+// draw the terrain and the axes under the model, or only the model
+void CScene::SetGround(bool enable)
+{
+	ground = enable;
+}
+
+// return the distance from the eye to the center of the model where it is now
+double CScene::GetModelDistance(CCamera* camera)
+{
+	BOUNDS_STRUCT b;
+	double dx, dy, dz;
+
+	file.GetBounds(&clip, anim_time, &b);
+
+	dx = camera->eyex - b.center[0];
+	dy = camera->eyey - b.center[1];
+	dz = camera->eyez - b.center[2];
+
+	return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// draw x, y and z axis
+void CScene::DrawAxis(CRender* render)
+{
+	static const float axes[3][6] = {
+		{ 0.0f, 0.05f, 0.0f,  500.0f, 0.05f,   0.0f },
+		{ 0.0f, 0.05f, 0.0f,    0.0f, 500.0f,  0.0f },
+		{ 0.0f, 0.05f, 0.0f,    0.0f, 0.05f, 500.0f } };
+
+	render->SetColor(1.0f, 0.0f, 0.0f);
+	render->Draw(RENDER_LINES, RENDER_V3F, axes[0], 2);
+
+	render->SetColor(0.0f, 1.0f, 0.0f);
+	render->Draw(RENDER_LINES, RENDER_V3F, axes[1], 2);
+
+	render->SetColor(0.0f, 0.0f, 1.0f);
+	render->Draw(RENDER_LINES, RENDER_V3F, axes[2], 2);
+}
+
+// draw the model as an indexed triangle list, with the level of detail
+// whose mean error covers at most lod_pixels from where the camera is
+// the vertices of the frame are written into one interleaved array every
+// frame and drawn with a single call
+void CScene::DrawMesh(CRender* render, CCamera* camera)
+{
+	int level;
+
+	if (!lod_made) {
+		lod.Create(&file, MD2_LOD_MAX_LEVELS);
+		lod_made = true;
+	}
+
+	level = lod.SelectLevel((float)GetModelDistance(camera), (float)projection, lod_pixels);
+
+	file.GetMeshStream(stream);
+
+	render->DrawIndexed(RENDER_TRIANGLES, RENDER_T2F_N3F_V3F, stream, file.GetMeshVertexCount(),
+		lod.GetIndices(level), lod.GetIndexCount(level));
+}
+
+// draw the model with the triangle strips and fans of the command list
+// they share vertices between triangles, so fewer vertices are written,
+// and are drawn as one triangle list made when the file was opened
+void CScene::DrawCommands(CRender* render)
+{
+	file.GetCommandStream(stream);
+
+	render->DrawIndexed(RENDER_TRIANGLES, RENDER_T2F_N3F_V3F, stream, file.GetCommandVertexCount(),
+		command_indices, command_index_count);
+}
+
+// outline the picked triangle where it is in the current frame
+void CScene::DrawPicked(CRender* render)
+{
+	MD2_STRUCT t;
+	float* lines = picked_lines;
+
+	if (picked.face < 0 || file.GetTriangles(picked.face, 1, &t) == 0) return;
+
+	lines[0] = t.x1;  lines[1] = t.y1;  lines[2] = t.z1;
+	lines[3] = t.x2;  lines[4] = t.y2;  lines[5] = t.z2;
+	lines[6] = t.x2;  lines[7] = t.y2;  lines[8] = t.z2;
+	lines[9] = t.x3;  lines[10] = t.y3; lines[11] = t.z3;
+	lines[12] = t.x3; lines[13] = t.y3; lines[14] = t.z3;
+	lines[15] = t.x1; lines[16] = t.y1; lines[17] = t.z1;
+
+	render->SetTexture(0);
+	render->SetDepthTest(false);
+	render->SetColor(1.0f, 0.0f, 0.0f);
+	render->Draw(RENDER_LINES, RENDER_V3F, lines, 6);
+	render->SetDepthTest(true);
+}
+
+// Draw a frame as the camera sees it. It is made in the queue, which
+// sends it to render sorted by texture and state, the model before what
+// is behind it, and the picked triangle last.
+void CScene::Draw(CRender* render, CCamera* camera)
+{
+	static const float white[4] = { 1.0f, 1.0f, 1.0f, 0.0f };
+	float p[16], m[16];
+
+	GetPerspective(p, fovy, (double)width / (double)height, z_near, z_far);
+	GetLookAt(m, camera->eyex, camera->eyey, camera->eyez, camera->centerx, camera->centery, camera->centerz, camera->upx, camera->upy, camera->upz);
+
+	queue.SetTarget(render);
+	queue.BeginFrame(width, height, white);
+	queue.SetMatrices(p, m);
+	queue.SetDepthTest(true);
+
+	if (ground) {
+		// draw terrain, it is under everything
+		queue.SetDepth((float)z_far);
+		queue.SetTexture(0);
+		queue.SetPolygonMode(RENDER_LINE);
+		queue.SetColor(0.8f, 0.8f, 0.8f);
+		terrain.Draw(&queue);
+
+		// draw axis
+		queue.SetDepth((float)sqrt(camera->eyex * camera->eyex + camera->eyey * camera->eyey + camera->eyez * camera->eyez));
+		DrawAxis(&queue);
+	}
+
+	// draw model
+	if (stream != NULL) {
+		queue.SetDepth((float)GetModelDistance(camera));
+		queue.SetPolygonMode(polygon_mode);
+		queue.SetColor(1.0f, 1.0f, 1.0f);
+		queue.SetTexture(skin_count > 0 && cache != NULL ? cache->GetTexture(skins[skin], render) : 0);
+
+		if (strips && file.GetCommandCount() > 0)
+			DrawCommands(&queue);
+		else
+			DrawMesh(&queue, camera);
+
+		DrawPicked(&queue);
+	}
+
+	queue.EndFrame();
+}
+
+// Cast a ray from the eye through the pixel (x, y), y going down, and
+// find the nearest triangle of the model where it is now. The tree is
+// fitted to the pose only when a pick is asked for.
+// return true if a triangle was hit
+bool CScene::Pick(CCamera* camera, int x, int y)
+{
+	double f[3], s[3], u[3], len, h, sx, sy;
+	float origin[3], direction[3];
+	int i;
+
+	if (pose == NULL) return false;
+
+	// the camera frame as GetLookAt makes it
+	f[0] = camera->centerx - camera->eyex;
+	f[1] = camera->centery - camera->eyey;
+	f[2] = camera->centerz - camera->eyez;
+
+	len = sqrt(f[0] * f[0] + f[1] * f[1] + f[2] * f[2]);
+	if (len > 0.0) { f[0] /= len;  f[1] /= len;  f[2] /= len; }
+
+	s[0] = f[1] * camera->upz - f[2] * camera->upy;
+	s[1] = f[2] * camera->upx - f[0] * camera->upz;
+	s[2] = f[0] * camera->upy - f[1] * camera->upx;
+
+	len = sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+	if (len > 0.0) { s[0] /= len;  s[1] /= len;  s[2] /= len; }
+
+	u[0] = s[1] * f[2] - s[2] * f[1];
+	u[1] = s[2] * f[0] - s[0] * f[2];
+	u[2] = s[0] * f[1] - s[1] * f[0];
+
+	// the center of the pixel on the plane one unit in front of the eye
+	h = tan(fovy / 2.0 * M_PI / 180.0);
+	sx = (2.0 * (x + 0.5) / width - 1.0) * h * width / height;
+	sy = (1.0 - 2.0 * (y + 0.5) / height) * h;
+
+	// the ray reaches the far plane at t = 1
+	origin[0] = (float)camera->eyex;
+	origin[1] = (float)camera->eyey;
+	origin[2] = (float)camera->eyez;
+
+	for (i = 0; i < 3; i++)
+		direction[i] = (float)((f[i] + sx * s[i] + sy * u[i]) * z_far);
+
+	file.Evaluate(&clip, anim_time, pose);
+	bvh.Refit(pose);
+
+	return bvh.Intersect(origin, direction, 1.0f, &picked);
+}
+
+//
+CMd2File* CScene::GetFile()
+{
+	return &file;
+}
+
+//
+CRenderQueue* CScene::GetQueue()
+{
+	return &queue;
+}
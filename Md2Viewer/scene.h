@@ -0,0 +1,98 @@
+/*
+   Class Name:
+
+	  CScene
+
+   Description:
+
+	  the terrain, the axes and one animated md2 model, drawn through a
+	  CRender so the viewer and the headless tools share the same frame
+
+*/
+
+#pragma once
+
+#include "terrain.h"
+#include "md2file.h"
+#include "md2lod.h"
+#include "md2bvh.h"
+#include "renderqueue.h"
+
+class CCamera;
+class CRender;
+class CTextureCache;
+
+class CScene
+{
+private:
+	CTerrain terrain;
+	CMd2File file;
+	CMd2Lod lod;                        // made the first time the model is drawn as a list of triangles
+	bool lod_made;
+	float lod_pixels;                   // mean error of the level drawn, in pixels on the screen
+	CMd2Bvh bvh;
+
+	// the images of the skins are kept in a cache that may be shared with
+	// other scenes, skins holds the image of every skin, -1 if not read
+	CTextureCache* cache;
+	int* skins;
+	int skin_count;
+	int skin;
+
+	float* stream;                      // s, t, normal and position of every vertex of the current frame
+	unsigned int* command_indices;      // the strips and fans as one triangle list
+	int command_index_count;
+
+	float* pose;                        // the model at anim_time
+	CLIP_STRUCT clip;                   // the clip being played
+	double anim_time;                   // time into the clip in seconds
+	bool playing;
+	bool strips;                        // draw the model with the strips and fans
+	bool ground;                        // draw the terrain and the axes
+	int polygon_mode;                   // RENDER_POINT, RENDER_LINE or RENDER_FILL
+	HIT_STRUCT picked;                  // the triangle found by Pick
+	float picked_lines[18];             // its edges, kept until the frame is sent
+
+	// the frame is drawn into the queue, which sorts it and sends it to
+	// the render
+	CRenderQueue queue;
+
+	// viewport in pixels and perspective, projection is
+	// height / (2 tan(fovy / 2)) to pick a level of detail
+	int width, height;
+	double fovy, z_near, z_far, projection;
+
+	double GetModelDistance(CCamera* camera);
+	void DrawAxis(CRender* render);
+	void DrawMesh(CRender* render, CCamera* camera);
+	void DrawCommands(CRender* render);
+	void DrawPicked(CRender* render);
+	void Free();
+
+public:
+	CScene();
+	~CScene();
+
+	void Create(CTextureCache* cache);
+	bool Open(wchar_t* filename);
+	bool IsSkinLoaded();
+
+	void LookAtModel(CCamera* camera, double angle);
+	void SetViewport(int cx, int cy);
+
+	void Update(double t);
+	void SetFrame(int index);
+	void TogglePlay();
+	void SetStrips(bool enable);
+	void SetPolygonMode(int mode);
+	void SetGround(bool enable);
+	void SetSorted(bool enable);
+	void SetLodPixels(float pixels);
+	void NextSkin();
+
+	void Draw(CRender* render, CCamera* camera);
+	bool Pick(CCamera* camera, int x, int y);
+
+	CMd2File* GetFile();
+	CRenderQueue* GetQueue();
+};
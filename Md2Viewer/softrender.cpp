@@ -0,0 +1,1081 @@
+/*
+   Class Name:
+
+	  CSoftRender
+
+   Description:
+
+	  draw into an RGBA image in memory with no graphics library, the
+	  primitives are sorted into tiles of the screen and the tiles are
+	  drawn at the same time on many threads
+
+*/
+
+#include "platform.h"
+#include "softrender.h"
+#include "md2decode.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SOFT_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#define TARGET_SSE2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#endif
+#endif
+
+// vertices transformed per block of the thread pool
+const int SOFT_TRANSFORM_BLOCK = 8192;
+
+// indices converted at a time by DrawIndexed, whole lines, triangles and quads
+const int SOFT_INDEX_BLOCK = 1200;
+
+// data structure for the vertices of a draw going through the matrices
+typedef struct
+{
+	const float* matrix;
+	const float* vertices;
+	int format;
+	CLIP_VERTEX_STRUCT* out;
+}TRANSFORM_STRUCT;
+
+// Write the color of pixel (x, y): the texel at (s, t) times the color,
+// or the color alone if there is no texture. The texture repeats and the
+// nearest texel is taken.
+static inline void ShadePixel(const SOFT_TARGET_STRUCT* target, int x, int y, const SOFT_STATE_STRUCT* state, float s, float t)
+{
+	unsigned char* p = target->pixels + 4 * ((size_t)y * target->width + x);
+	const SOFT_TEXTURE_STRUCT* texture;
+	const unsigned char* texel;
+	int u, v;
+
+	if (state->texture == 0 || (texture = &target->textures[state->texture - 1])->pixels == NULL) {
+		p[0] = (unsigned char)(state->color[0] > 255 ? 255 : state->color[0]);
+		p[1] = (unsigned char)(state->color[1] > 255 ? 255 : state->color[1]);
+		p[2] = (unsigned char)(state->color[2] > 255 ? 255 : state->color[2]);
+		p[3] = 255;
+		return;
+	}
+
+	s -= floorf(s);
+	t -= floorf(t);
+
+	u = (int)(s * texture->width);
+	v = (int)(t * texture->height);
+	if (u >= texture->width || u < 0) u = texture->width - 1;
+	if (v >= texture->height || v < 0) v = texture->height - 1;
+
+	texel = texture->pixels + 4 * ((size_t)v * texture->width + u);
+
+	p[0] = (unsigned char)((texel[0] * state->color[0]) >> 8);
+	p[1] = (unsigned char)((texel[1] * state->color[1]) >> 8);
+	p[2] = (unsigned char)((texel[2] * state->color[2]) >> 8);
+	p[3] = 255;
+}
+
+// triangle, one pixel at a time
+// the planes are added up in the same order as the other instruction sets
+// so they all draw the same pixels
+static void DrawTriangleScalar(const SOFT_TARGET_STRUCT* target, const SOFT_TRIANGLE_STRUCT* t, int x0, int y0, int x1, int y1)
+{
+	const SOFT_STATE_STRUCT* state = &target->states[t->state];
+	float* d;
+	float fx, fy, r0, r1, r2, rz, z, iw;
+	int x, y;
+
+	for (y = y0; y < y1; y++) {
+
+		fy = (float)y;
+		d = target->depth + (size_t)y * target->depth_pitch;
+
+		r0 = t->edge[0][1] * fy + t->edge[0][2];
+		r1 = t->edge[1][1] * fy + t->edge[1][2];
+		r2 = t->edge[2][1] * fy + t->edge[2][2];
+		rz = t->z[1] * fy + t->z[2];
+
+		for (x = x0; x < x1; x++) {
+
+			fx = (float)x;
+
+			if (t->edge[0][0] * fx + r0 < 0.0f || t->edge[1][0] * fx + r1 < 0.0f || t->edge[2][0] * fx + r2 < 0.0f) continue;
+
+			if (state->depth_test) {
+				z = t->z[0] * fx + rz;
+				if (z >= d[x]) continue;
+				d[x] = z;
+			}
+
+			iw = t->iw[0] * fx + (t->iw[1] * fy + t->iw[2]);
+
+			ShadePixel(target, x, y, state,
+				(t->sw[0] * fx + (t->sw[1] * fy + t->sw[2])) / iw,
+				(t->tw[0] * fx + (t->tw[1] * fy + t->tw[2])) / iw);
+		}
+	}
+}
+
+#ifdef SOFT_X86
+
+// Triangle, 4 pixels of a row at a time. The blocks start on a multiple
+// of 4 so they never cross into the next tile.
+TARGET_SSE2 static void DrawTriangleSSE2(const SOFT_TARGET_STRUCT* target, const SOFT_TRIANGLE_STRUCT* t, int x0, int y0, int x1, int y1)
+{
+	const SOFT_STATE_STRUCT* state = &target->states[t->state];
+	__m128 lane, zero, left, right, a0, a1, a2, az, aiw, asw, atw;
+	__m128 r0, r1, r2, rz, riw, rsw, rtw, px, m, z, dz, iw;
+	float* d, fy, s[4], tt[4];
+	int x, y, j, mask;
+
+	lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+	zero = _mm_setzero_ps();
+	left = _mm_set1_ps((float)x0);
+	right = _mm_set1_ps((float)x1);
+
+	a0 = _mm_set1_ps(t->edge[0][0]);
+	a1 = _mm_set1_ps(t->edge[1][0]);
+	a2 = _mm_set1_ps(t->edge[2][0]);
+	az = _mm_set1_ps(t->z[0]);
+	aiw = _mm_set1_ps(t->iw[0]);
+	asw = _mm_set1_ps(t->sw[0]);
+	atw = _mm_set1_ps(t->tw[0]);
+
+	for (y = y0; y < y1; y++) {
+
+		fy = (float)y;
+		d = target->depth + (size_t)y * target->depth_pitch;
+
+		r0 = _mm_set1_ps(t->edge[0][1] * fy + t->edge[0][2]);
+		r1 = _mm_set1_ps(t->edge[1][1] * fy + t->edge[1][2]);
+		r2 = _mm_set1_ps(t->edge[2][1] * fy + t->edge[2][2]);
+		rz = _mm_set1_ps(t->z[1] * fy + t->z[2]);
+
+		for (x = x0 & ~3; x < x1; x += 4) {
+
+			px = _mm_add_ps(_mm_set1_ps((float)x), lane);
+
+			m = _mm_and_ps(_mm_cmpge_ps(px, left), _mm_cmplt_ps(px, right));
+			m = _mm_and_ps(m, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), r0), zero));
+			m = _mm_and_ps(m, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), r1), zero));
+			m = _mm_and_ps(m, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), r2), zero));
+
+			if (_mm_movemask_ps(m) == 0) continue;
+
+			if (state->depth_test) {
+				z = _mm_add_ps(_mm_mul_ps(az, px), rz);
+				dz = _mm_loadu_ps(d + x);
+				m = _mm_and_ps(m, _mm_cmplt_ps(z, dz));
+				_mm_storeu_ps(d + x, _mm_or_ps(_mm_and_ps(m, z), _mm_andnot_ps(m, dz)));
+			}
+
+			if ((mask = _mm_movemask_ps(m)) == 0) continue;
+
+			riw = _mm_set1_ps(t->iw[1] * fy + t->iw[2]);
+			rsw = _mm_set1_ps(t->sw[1] * fy + t->sw[2]);
+			rtw = _mm_set1_ps(t->tw[1] * fy + t->tw[2]);
+
+			iw = _mm_add_ps(_mm_mul_ps(aiw, px), riw);
+			_mm_storeu_ps(s, _mm_div_ps(_mm_add_ps(_mm_mul_ps(asw, px), rsw), iw));
+			_mm_storeu_ps(tt, _mm_div_ps(_mm_add_ps(_mm_mul_ps(atw, px), rtw), iw));
+
+			for (j = 0; j < 4; j++)
+				if (mask & (1 << j)) ShadePixel(target, x + j, y, state, s[j], tt[j]);
+		}
+	}
+}
+
+// Triangle, 8 pixels of a row at a time. The blocks start on a multiple
+// of 8 so they never cross into the next tile.
+TARGET_AVX2 static void DrawTriangleAVX2(const SOFT_TARGET_STRUCT* target, const SOFT_TRIANGLE_STRUCT* t, int x0, int y0, int x1, int y1)
+{
+	const SOFT_STATE_STRUCT* state = &target->states[t->state];
+	__m256 lane, zero, left, right, a0, a1, a2, az, aiw, asw, atw;
+	__m256 r0, r1, r2, rz, riw, rsw, rtw, px, m, z, dz, iw;
+	float* d, fy, s[8], tt[8];
+	int x, y, j, mask;
+
+	lane = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+	zero = _mm256_setzero_ps();
+	left = _mm256_set1_ps((float)x0);
+	right = _mm256_set1_ps((float)x1);
+
+	a0 = _mm256_set1_ps(t->edge[0][0]);
+	a1 = _mm256_set1_ps(t->edge[1][0]);
+	a2 = _mm256_set1_ps(t->edge[2][0]);
+	az = _mm256_set1_ps(t->z[0]);
+	aiw = _mm256_set1_ps(t->iw[0]);
+	asw = _mm256_set1_ps(t->sw[0]);
+	atw = _mm256_set1_ps(t->tw[0]);
+
+	for (y = y0; y < y1; y++) {
+
+		fy = (float)y;
+		d = target->depth + (size_t)y * target->depth_pitch;
+
+		r0 = _mm256_set1_ps(t->edge[0][1] * fy + t->edge[0][2]);
+		r1 = _mm256_set1_ps(t->edge[1][1] * fy + t->edge[1][2]);
+		r2 = _mm256_set1_ps(t->edge[2][1] * fy + t->edge[2][2]);
+		rz = _mm256_set1_ps(t->z[1] * fy + t->z[2]);
+
+		for (x = x0 & ~7; x < x1; x += 8) {
+
+			px = _mm256_add_ps(_mm256_set1_ps((float)x), lane);
+
+			m = _mm256_and_ps(_mm256_cmp_ps(px, left, _CMP_GE_OQ), _mm256_cmp_ps(px, right, _CMP_LT_OQ));
+			m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a0, px), r0), zero, _CMP_GE_OQ));
+			m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a1, px), r1), zero, _CMP_GE_OQ));
+			m = _mm256_and_ps(m, _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(a2, px), r2), zero, _CMP_GE_OQ));
+
+			if (_mm256_movemask_ps(m) == 0) continue;
+
+			if (state->depth_test) {
+				z = _mm256_add_ps(_mm256_mul_ps(az, px), rz);
+				dz = _mm256_loadu_ps(d + x);
+				m = _mm256_and_ps(m, _mm256_cmp_ps(z, dz, _CMP_LT_OQ));
+				_mm256_storeu_ps(d + x, _mm256_blendv_ps(dz, z, m));
+			}
+
+			if ((mask = _mm256_movemask_ps(m)) == 0) continue;
+
+			riw = _mm256_set1_ps(t->iw[1] * fy + t->iw[2]);
+			rsw = _mm256_set1_ps(t->sw[1] * fy + t->sw[2]);
+			rtw = _mm256_set1_ps(t->tw[1] * fy + t->tw[2]);
+
+			iw = _mm256_add_ps(_mm256_mul_ps(aiw, px), riw);
+			_mm256_storeu_ps(s, _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(asw, px), rsw), iw));
+			_mm256_storeu_ps(tt, _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(atw, px), rtw), iw));
+
+			for (j = 0; j < 8; j++)
+				if (mask & (1 << j)) ShadePixel(target, x + j, y, state, s[j], tt[j]);
+		}
+	}
+}
+
+#endif
+
+// return the code for an instruction set, or NULL if this cpu does not have it
+static SOFTTRIANGLEPROC GetTriangleProc(int kind)
+{
+	// the decoder knows which instruction sets the cpu has
+	if (kind != DECODE_SCALAR && GetDecodeFrameProc(kind) == NULL) return NULL;
+
+	switch (kind)
+	{
+	case DECODE_SCALAR: return DrawTriangleScalar;
+#ifdef SOFT_X86
+	case DECODE_SSE2: return DrawTriangleSSE2;
+	case DECODE_AVX2: return DrawTriangleAVX2;
+#endif
+	}
+
+	return NULL;
+}
+
+// Line, one pixel for every column it crosses, or every row if it is
+// steep. Only the pixels in x0 to x1 - 1, y0 to y1 - 1 are drawn.
+static void DrawLine(const SOFT_TARGET_STRUCT* target, const SOFT_LINE_STRUCT* l, int x0, int y0, int x1, int y1)
+{
+	const SOFT_STATE_STRUCT* state = &target->states[l->state];
+	float dx, dy, a, t, z, iw;
+	float* d;
+	int i, first, last, x, y;
+	bool steep;
+
+	dx = l->x[1] - l->x[0];
+	dy = l->y[1] - l->y[0];
+
+	// a point
+	if (fabsf(dx) < 1e-6f && fabsf(dy) < 1e-6f) {
+		first = 0;
+		last = 0;
+		steep = false;
+	}
+	else {
+		// the pixel centers along the longer side
+		steep = (fabsf(dy) > fabsf(dx));
+		a = (steep ? fminf(l->y[0], l->y[1]) : fminf(l->x[0], l->x[1]));
+		first = (int)ceilf(a - 0.5f);
+		a = (steep ? fmaxf(l->y[0], l->y[1]) : fmaxf(l->x[0], l->x[1]));
+		last = (int)floorf(a - 0.5f);
+
+		if (steep) {
+			if (first < y0) first = y0;
+			if (last > y1 - 1) last = y1 - 1;
+		}
+		else {
+			if (first < x0) first = x0;
+			if (last > x1 - 1) last = x1 - 1;
+		}
+	}
+
+	for (i = first; i <= last; i++) {
+
+		if (fabsf(dx) < 1e-6f && fabsf(dy) < 1e-6f) {
+			t = 0.0f;
+			x = (int)floorf(l->x[0]);
+			y = (int)floorf(l->y[0]);
+		}
+		else if (steep) {
+			t = (i + 0.5f - l->y[0]) / dy;
+			x = (int)floorf(l->x[0] + t * dx);
+			y = i;
+		}
+		else {
+			t = (i + 0.5f - l->x[0]) / dx;
+			x = i;
+			y = (int)floorf(l->y[0] + t * dy);
+		}
+
+		if (x < x0 || x >= x1 || y < y0 || y >= y1) continue;
+
+		z = l->z[0] + t * (l->z[1] - l->z[0]);
+
+		if (state->depth_test) {
+			d = target->depth + (size_t)y * target->depth_pitch + x;
+			if (z >= *d) continue;
+			*d = z;
+		}
+
+		iw = l->iw[0] + t * (l->iw[1] - l->iw[0]);
+
+		ShadePixel(target, x, y, state,
+			(l->sw[0] + t * (l->sw[1] - l->sw[0])) / iw,
+			(l->tw[0] + t * (l->tw[1] - l->tw[0])) / iw);
+	}
+}
+
+// constructor
+CSoftRender::CSoftRender()
+{
+	width = 0;
+	height = 0;
+	depth_pitch = 0;
+	pixels = NULL;
+	depth = NULL;
+	pixel_capacity = 0;
+	depth_capacity = 0;
+	clear_color[0] = clear_color[1] = clear_color[2] = clear_color[3] = 0.0f;
+
+	tile_x = 0;
+	tile_y = 0;
+	bins = NULL;
+	bin_capacity = 0;
+
+	memset(matrix, 0, sizeof(matrix));
+	matrix[0] = matrix[5] = matrix[10] = matrix[15] = 1.0f;
+	polygon_mode = RENDER_FILL;
+	current.texture = 0;
+	current.color[0] = current.color[1] = current.color[2] = 256;
+	current.depth_test = false;
+	current_used = false;
+	states = NULL;
+	state_count = 0;
+	state_capacity = 0;
+
+	triangles = NULL;
+	triangle_count = 0;
+	triangle_capacity = 0;
+	lines = NULL;
+	line_count = 0;
+	line_capacity = 0;
+
+	clip = NULL;
+	clip_capacity = 0;
+
+	textures = NULL;
+	texture_count = 0;
+
+	kind = GetDecodeFrameKind();
+	triangle_proc = GetTriangleProc(kind);
+}
+
+// destructor
+CSoftRender::~CSoftRender()
+{
+	int i;
+
+	pool.Destroy();
+
+	if (pixels != NULL) delete[] pixels;
+	if (depth != NULL) delete[] depth;
+
+	for (i = 0; i < bin_capacity; i++)
+		if (bins[i].items != NULL) delete[] bins[i].items;
+
+	if (bins != NULL) delete[] bins;
+	if (states != NULL) delete[] states;
+	if (triangles != NULL) delete[] triangles;
+	if (lines != NULL) delete[] lines;
+	if (clip != NULL) delete[] clip;
+
+	for (i = 0; i < texture_count; i++)
+		if (textures[i].pixels != NULL) delete[] textures[i].pixels;
+
+	if (textures != NULL) delete[] textures;
+}
+
+// draw the tiles on thread_count threads, 0 for one per processor
+// without it the tiles are drawn on the calling thread
+bool CSoftRender::Create(int thread_count)
+{
+	return pool.Create(thread_count);
+}
+
+//
+int CSoftRender::GetThreadCount()
+{
+	return pool.GetThreadCount();
+}
+
+// draw the triangles with an instruction set
+// return false if this cpu does not have it
+bool CSoftRender::SetKind(int kind)
+{
+	SOFTTRIANGLEPROC proc = GetTriangleProc(kind);
+
+	if (proc == NULL) return false;
+
+	this->kind = kind;
+	triangle_proc = proc;
+
+	return true;
+}
+
+//
+int CSoftRender::GetKind()
+{
+	return kind;
+}
+
+// Get the image ready for a frame of width x height pixels and forget the
+// primitives of the last one. The image is cleared when the tiles are
+// drawn.
+void CSoftRender::BeginFrame(int width, int height, const float* color)
+{
+	int i, n;
+
+	if (width < 1) width = 1;
+	if (height < 1) height = 1;
+
+	this->width = width;
+	this->height = height;
+	depth_pitch = ((width + 7) & ~7) + 8;
+
+	n = 4 * width * height;
+	if (n > pixel_capacity) {
+		if (pixels != NULL) delete[] pixels;
+		pixels = new unsigned char[n];
+		pixel_capacity = n;
+	}
+
+	n = depth_pitch * height;
+	if (n > depth_capacity) {
+		if (depth != NULL) delete[] depth;
+		depth = new float[n];
+		depth_capacity = n;
+		for (i = 0; i < n; i++) depth[i] = 1.0f;
+	}
+
+	tile_x = (width + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+	tile_y = (height + SOFT_TILE_SIZE - 1) / SOFT_TILE_SIZE;
+
+	n = tile_x * tile_y;
+	if (n > bin_capacity) {
+		SOFT_BIN_STRUCT* p = new SOFT_BIN_STRUCT[n];
+
+		if (bin_capacity > 0) memcpy(p, bins, bin_capacity * sizeof(SOFT_BIN_STRUCT));
+		memset(&p[bin_capacity], 0, (n - bin_capacity) * sizeof(SOFT_BIN_STRUCT));
+		if (bins != NULL) delete[] bins;
+
+		bins = p;
+		bin_capacity = n;
+	}
+
+	for (i = 0; i < n; i++) bins[i].count = 0;
+
+	for (i = 0; i < 4; i++) clear_color[i] = color[i];
+
+	state_count = 0;
+	current_used = false;
+	triangle_count = 0;
+	line_count = 0;
+}
+
+// draw every tile, each on whichever thread is free
+void CSoftRender::EndFrame()
+{
+	if (pixels == NULL) return;
+
+	pool.ParallelFor(tile_x * tile_y, 1, DrawTiles, this);
+}
+
+//
+void CSoftRender::GetTarget(SOFT_TARGET_STRUCT* target)
+{
+	target->pixels = pixels;
+	target->depth = depth;
+	target->width = width;
+	target->depth_pitch = depth_pitch;
+	target->states = states;
+	target->textures = textures;
+}
+
+// clear tiles first to last - 1 and draw what was binned into them, in
+// the order it was drawn
+void CSoftRender::DrawTiles(void* param, int first, int last)
+{
+	CSoftRender* render = (CSoftRender*)param;
+	SOFT_TARGET_STRUCT target;
+	const SOFT_BIN_STRUCT* bin;
+	const SOFT_TRIANGLE_STRUCT* t;
+	unsigned char c[4];
+	unsigned char* p;
+	float* d;
+	int i, j, k, x, y, x0, y0, x1, y1;
+
+	render->GetTarget(&target);
+
+	for (k = 0; k < 4; k++) {
+		x = (int)(render->clear_color[k] * 255.0f + 0.5f);
+		c[k] = (unsigned char)(x < 0 ? 0 : x > 255 ? 255 : x);
+	}
+
+	for (i = first; i < last; i++) {
+
+		x0 = (i % render->tile_x) * SOFT_TILE_SIZE;
+		y0 = (i / render->tile_x) * SOFT_TILE_SIZE;
+		x1 = (x0 + SOFT_TILE_SIZE < render->width ? x0 + SOFT_TILE_SIZE : render->width);
+		y1 = (y0 + SOFT_TILE_SIZE < render->height ? y0 + SOFT_TILE_SIZE : render->height);
+
+		for (y = y0; y < y1; y++) {
+			p = render->pixels + 4 * ((size_t)y * render->width + x0);
+			d = render->depth + (size_t)y * render->depth_pitch;
+
+			for (x = x0; x < x1; x++, p += 4) {
+				p[0] = c[0];  p[1] = c[1];  p[2] = c[2];  p[3] = c[3];
+				d[x] = 1.0f;
+			}
+		}
+
+		bin = &render->bins[i];
+
+		for (j = 0; j < bin->count; j++) {
+
+			k = bin->items[j];
+
+			if (k & 1) {
+				DrawLine(&target, &render->lines[k >> 1], x0, y0, x1, y1);
+				continue;
+			}
+
+			t = &render->triangles[k >> 1];
+
+			render->triangle_proc(&target, t,
+				t->min_x > x0 ? t->min_x : x0, t->min_y > y0 ? t->min_y : y0,
+				t->max_x < x1 ? t->max_x : x1, t->max_y < y1 ? t->max_y : y1);
+		}
+	}
+}
+
+//
+void CSoftRender::SetMatrices(const float* projection, const float* modelview)
+{
+	MultiplyMatrix(matrix, projection, modelview);
+}
+
+// how the triangles and quads of the next draws are drawn
+void CSoftRender::SetPolygonMode(int mode)
+{
+	polygon_mode = mode;
+}
+
+//
+void CSoftRender::SetDepthTest(bool enable)
+{
+	current.depth_test = enable;
+	current_used = false;
+}
+
+//
+void CSoftRender::SetColor(float r, float g, float b)
+{
+	current.color[0] = (int)(r * 256.0f + 0.5f);
+	current.color[1] = (int)(g * 256.0f + 0.5f);
+	current.color[2] = (int)(b * 256.0f + 0.5f);
+	current_used = false;
+}
+
+//
+void CSoftRender::SetTexture(int texture)
+{
+	current.texture = (texture > 0 && texture <= texture_count ? texture : 0);
+	current_used = false;
+}
+
+// copy the pixels as RGBA, the texture is a number from 1 up
+int CSoftRender::CreateTexture(int width, int height, int channels, const unsigned char* pixels)
+{
+	const unsigned char* src;
+	unsigned char* dst;
+	int i, x, y, row;
+
+	if ((channels != 3 && channels != 4) || width < 1 || height < 1 || pixels == NULL) return 0;
+
+	// the place of a deleted texture, or one more
+	for (i = 0; i < texture_count; i++)
+		if (textures[i].pixels == NULL) break;
+
+	if (i == texture_count) {
+		SOFT_TEXTURE_STRUCT* p = new SOFT_TEXTURE_STRUCT[texture_count + 1];
+
+		if (texture_count > 0) memcpy(p, textures, texture_count * sizeof(SOFT_TEXTURE_STRUCT));
+		if (textures != NULL) delete[] textures;
+
+		textures = p;
+		texture_count++;
+	}
+
+	textures[i].width = width;
+	textures[i].height = height;
+	textures[i].pixels = new unsigned char[4 * width * height];
+
+	row = (width * channels + 3) & ~3;
+	dst = textures[i].pixels;
+
+	for (y = 0; y < height; y++) {
+		src = pixels + (size_t)y * row;
+
+		for (x = 0; x < width; x++, src += channels, dst += 4) {
+			dst[0] = src[0];
+			dst[1] = src[1];
+			dst[2] = src[2];
+			dst[3] = (channels == 4 ? src[3] : 255);
+		}
+	}
+
+	return i + 1;
+}
+
+//
+void CSoftRender::DeleteTexture(int texture)
+{
+	if (texture < 1 || texture > texture_count || textures[texture - 1].pixels == NULL) return;
+
+	delete[] textures[texture - 1].pixels;
+	textures[texture - 1].pixels = NULL;
+
+	if (current.texture == texture) SetTexture(0);
+}
+
+// return the state the next primitive is drawn with, kept for this frame
+int CSoftRender::UseState()
+{
+	if (current_used) return state_count - 1;
+
+	if (state_count == state_capacity) {
+		SOFT_STATE_STRUCT* p;
+
+		state_capacity = (state_capacity == 0 ? 16 : 2 * state_capacity);
+		p = new SOFT_STATE_STRUCT[state_capacity];
+		if (state_count > 0) memcpy(p, states, state_count * sizeof(SOFT_STATE_STRUCT));
+		if (states != NULL) delete[] states;
+		states = p;
+	}
+
+	states[state_count++] = current;
+	current_used = true;
+
+	return state_count - 1;
+}
+
+// vertices first to last - 1 through the matrix
+static void TransformBlock(void* param, int first, int last)
+{
+	TRANSFORM_STRUCT* p = (TRANSFORM_STRUCT*)param;
+	const float* m = p->matrix;
+	const float* v;
+	CLIP_VERTEX_STRUCT* c;
+	int i, size;
+
+	size = GetVertexSize(p->format);
+
+	for (i = first; i < last; i++) {
+
+		v = p->vertices + (size_t)size * i;
+		c = &p->out[i];
+
+		if (p->format == RENDER_T2F_N3F_V3F) {
+			c->s = v[0];
+			c->t = v[1];
+			v += 5;
+		}
+		else {
+			c->s = 0.0f;
+			c->t = 0.0f;
+		}
+
+		c->x = m[0] * v[0] + m[4] * v[1] + m[8] * v[2] + m[12];
+		c->y = m[1] * v[0] + m[5] * v[1] + m[9] * v[2] + m[13];
+		c->z = m[2] * v[0] + m[6] * v[1] + m[10] * v[2] + m[14];
+		c->w = m[3] * v[0] + m[7] * v[1] + m[11] * v[2] + m[15];
+	}
+}
+
+// put the vertices of a draw through the matrix, on all threads if there
+// are many
+void CSoftRender::Transform(int format, const float* vertices, int vertex_count)
+{
+	TRANSFORM_STRUCT p;
+
+	if (vertex_count > clip_capacity) {
+		if (clip != NULL) delete[] clip;
+		clip = new CLIP_VERTEX_STRUCT[vertex_count];
+		clip_capacity = vertex_count;
+	}
+
+	p.matrix = matrix;
+	p.vertices = vertices;
+	p.format = format;
+	p.out = clip;
+
+	pool.ParallelFor(vertex_count, SOFT_TRANSFORM_BLOCK, TransformBlock, &p);
+}
+
+// add an item to the bins of the tiles that pixels min to max - 1 touch
+void CSoftRender::Bin(int item, int min_x, int min_y, int max_x, int max_y)
+{
+	SOFT_BIN_STRUCT* bin;
+	int tx, ty, tx0, tx1, ty1;
+
+	tx0 = min_x / SOFT_TILE_SIZE;
+	tx1 = (max_x - 1) / SOFT_TILE_SIZE;
+	ty1 = (max_y - 1) / SOFT_TILE_SIZE;
+
+	for (ty = min_y / SOFT_TILE_SIZE; ty <= ty1; ty++) {
+		for (tx = tx0; tx <= tx1; tx++) {
+
+			bin = &bins[ty * tile_x + tx];
+
+			if (bin->count == bin->capacity) {
+				int* p;
+
+				bin->capacity = (bin->capacity == 0 ? 256 : 2 * bin->capacity);
+				p = new int[bin->capacity];
+				if (bin->count > 0) memcpy(p, bin->items, bin->count * sizeof(int));
+				if (bin->items != NULL) delete[] bin->items;
+				bin->items = p;
+			}
+
+			bin->items[bin->count++] = item;
+		}
+	}
+}
+
+// which sides of the view volume a vertex is out of
+static int GetOutCode(const CLIP_VERTEX_STRUCT* v)
+{
+	int code = 0;
+
+	if (v->x < -v->w) code |= 1;
+	if (v->x > v->w)  code |= 2;
+	if (v->y < -v->w) code |= 4;
+	if (v->y > v->w)  code |= 8;
+	if (v->z < -v->w) code |= 16;
+	if (v->z > v->w)  code |= 32;
+
+	return code;
+}
+
+// the vertex a fraction t of the way from a to b
+static void LerpVertex(const CLIP_VERTEX_STRUCT* a, const CLIP_VERTEX_STRUCT* b, float t, CLIP_VERTEX_STRUCT* out)
+{
+	out->x = a->x + t * (b->x - a->x);
+	out->y = a->y + t * (b->y - a->y);
+	out->z = a->z + t * (b->z - a->z);
+	out->w = a->w + t * (b->w - a->w);
+	out->s = a->s + t * (b->s - a->s);
+	out->t = a->t + t * (b->t - a->t);
+}
+
+// Cut a triangle by the near plane, z >= -w, the other planes are left to
+// the tiles. What is left is a triangle or a quad, set up as triangles.
+void CSoftRender::AddTriangle(const CLIP_VERTEX_STRUCT* a, const CLIP_VERTEX_STRUCT* b, const CLIP_VERTEX_STRUCT* c)
+{
+	const CLIP_VERTEX_STRUCT* in[3] = { a, b, c };
+	CLIP_VERTEX_STRUCT out[4];
+	float d0, d1;
+	int i, n, code;
+
+	code = GetOutCode(a);
+	if ((code & GetOutCode(b) & GetOutCode(c)) != 0) return;
+
+	if (((code | GetOutCode(b) | GetOutCode(c)) & 16) == 0) {
+		SetupTriangle(a, b, c);
+		return;
+	}
+
+	n = 0;
+
+	for (i = 0; i < 3; i++) {
+		a = in[i];
+		b = in[(i + 1) % 3];
+		d0 = a->z + a->w;
+		d1 = b->z + b->w;
+
+		if (d0 >= 0.0f) out[n++] = *a;
+		if ((d0 >= 0.0f) != (d1 >= 0.0f)) LerpVertex(a, b, d0 / (d0 - d1), &out[n++]);
+	}
+
+	if (n >= 3) SetupTriangle(&out[0], &out[1], &out[2]);
+	if (n == 4) SetupTriangle(&out[0], &out[2], &out[3]);
+}
+
+// Turn a triangle on the screen into the planes the tiles draw it with
+// and bin it. Both sides are drawn.
+void CSoftRender::SetupTriangle(const CLIP_VERTEX_STRUCT* a, const CLIP_VERTEX_STRUCT* b, const CLIP_VERTEX_STRUCT* c)
+{
+	const CLIP_VERTEX_STRUCT* v[3] = { a, b, c };
+	SOFT_TRIANGLE_STRUCT* t;
+	double x[3], y[3], z[3], iw[3], sw[3], tw[3], e[3][3], area, min_x, min_y, max_x, max_y;
+	int i, j, k;
+
+	for (i = 0; i < 3; i++) {
+		iw[i] = 1.0 / v[i]->w;
+		x[i] = (v[i]->x * iw[i] * 0.5 + 0.5) * width;
+		y[i] = (0.5 - v[i]->y * iw[i] * 0.5) * height;
+		z[i] = v[i]->z * iw[i] * 0.5 + 0.5;
+		sw[i] = v[i]->s * iw[i];
+		tw[i] = v[i]->t * iw[i];
+	}
+
+	min_x = fmin(x[0], fmin(x[1], x[2]));
+	max_x = fmax(x[0], fmax(x[1], x[2]));
+	min_y = fmin(y[0], fmin(y[1], y[2]));
+	max_y = fmax(y[0], fmax(y[1], y[2]));
+
+	if (min_x < 0.0) min_x = 0.0;
+	if (min_y < 0.0) min_y = 0.0;
+	if (max_x > width) max_x = width;
+	if (max_y > height) max_y = height;
+
+	if (min_x >= max_x || min_y >= max_y) return;
+
+	// edge i is across from corner i, a x + b y + c is 0 on it
+	for (i = 0; i < 3; i++) {
+		j = (i + 1) % 3;
+		k = (i + 2) % 3;
+		e[i][0] = y[j] - y[k];
+		e[i][1] = x[k] - x[j];
+		e[i][2] = x[j] * y[k] - y[j] * x[k];
+	}
+
+	area = e[0][0] * x[0] + e[0][1] * y[0] + e[0][2];
+	if (area == 0.0) return;
+
+	if (triangle_count == triangle_capacity) {
+		SOFT_TRIANGLE_STRUCT* p;
+
+		triangle_capacity = (triangle_capacity == 0 ? 1024 : 2 * triangle_capacity);
+		p = new SOFT_TRIANGLE_STRUCT[triangle_capacity];
+		if (triangle_count > 0) memcpy(p, triangles, triangle_count * sizeof(SOFT_TRIANGLE_STRUCT));
+		if (triangles != NULL) delete[] triangles;
+		triangles = p;
+	}
+
+	t = &triangles[triangle_count];
+
+	// the edges divided by the area are the weights of the corners, and
+	// positive inside whichever way the triangle turns, then every plane
+	// is moved to the center of the pixels
+	for (k = 0; k < 3; k++) {
+		for (i = 0; i < 3; i++) e[i][k] /= area;
+
+		t->z[k] = (float)(z[0] * e[0][k] + z[1] * e[1][k] + z[2] * e[2][k]);
+		t->iw[k] = (float)(iw[0] * e[0][k] + iw[1] * e[1][k] + iw[2] * e[2][k]);
+		t->sw[k] = (float)(sw[0] * e[0][k] + sw[1] * e[1][k] + sw[2] * e[2][k]);
+		t->tw[k] = (float)(tw[0] * e[0][k] + tw[1] * e[1][k] + tw[2] * e[2][k]);
+	}
+
+	for (i = 0; i < 3; i++) {
+		t->edge[i][0] = (float)e[i][0];
+		t->edge[i][1] = (float)e[i][1];
+		t->edge[i][2] = (float)(e[i][2] + 0.5 * (e[i][0] + e[i][1]));
+	}
+
+	t->z[2] += 0.5f * (t->z[0] + t->z[1]);
+	t->iw[2] += 0.5f * (t->iw[0] + t->iw[1]);
+	t->sw[2] += 0.5f * (t->sw[0] + t->sw[1]);
+	t->tw[2] += 0.5f * (t->tw[0] + t->tw[1]);
+
+	t->min_x = (int)floor(min_x);
+	t->min_y = (int)floor(min_y);
+	t->max_x = (int)ceil(max_x);
+	t->max_y = (int)ceil(max_y);
+	t->state = UseState();
+
+	Bin(2 * triangle_count, t->min_x, t->min_y, t->max_x, t->max_y);
+	triangle_count++;
+}
+
+// cut a line by the near plane, then put it on the screen and bin it
+void CSoftRender::AddLine(const CLIP_VERTEX_STRUCT* a, const CLIP_VERTEX_STRUCT* b)
+{
+	CLIP_VERTEX_STRUCT v[2];
+	SOFT_LINE_STRUCT* l;
+	float d0, d1, iw;
+	int i, min_x, min_y, max_x, max_y;
+
+	if ((GetOutCode(a) & GetOutCode(b)) != 0) return;
+
+	v[0] = *a;
+	v[1] = *b;
+
+	d0 = a->z + a->w;
+	d1 = b->z + b->w;
+
+	if (d0 < 0.0f) LerpVertex(a, b, d0 / (d0 - d1), &v[0]);
+	if (d1 < 0.0f) LerpVertex(b, a, d1 / (d1 - d0), &v[1]);
+
+	if (line_count == line_capacity) {
+		SOFT_LINE_STRUCT* p;
+
+		line_capacity = (line_capacity == 0 ? 1024 : 2 * line_capacity);
+		p = new SOFT_LINE_STRUCT[line_capacity];
+		if (line_count > 0) memcpy(p, lines, line_count * sizeof(SOFT_LINE_STRUCT));
+		if (lines != NULL) delete[] lines;
+		lines = p;
+	}
+
+	l = &lines[line_count];
+
+	for (i = 0; i < 2; i++) {
+		iw = 1.0f / v[i].w;
+		l->x[i] = (v[i].x * iw * 0.5f + 0.5f) * width;
+		l->y[i] = (0.5f - v[i].y * iw * 0.5f) * height;
+		l->z[i] = v[i].z * iw * 0.5f + 0.5f;
+		l->iw[i] = iw;
+		l->sw[i] = v[i].s * iw;
+		l->tw[i] = v[i].t * iw;
+	}
+
+	min_x = (int)floorf(fminf(l->x[0], l->x[1]));
+	max_x = (int)floorf(fmaxf(l->x[0], l->x[1])) + 1;
+	min_y = (int)floorf(fminf(l->y[0], l->y[1]));
+	max_y = (int)floorf(fmaxf(l->y[0], l->y[1])) + 1;
+
+	if (min_x < 0) min_x = 0;
+	if (min_y < 0) min_y = 0;
+	if (max_x > width) max_x = width;
+	if (max_y > height) max_y = height;
+
+	if (min_x >= max_x || min_y >= max_y) return;
+
+	l->state = UseState();
+
+	Bin(2 * line_count + 1, min_x, min_y, max_x, max_y);
+	line_count++;
+}
+
+// a triangle or a quad as the polygon mode says, filled, its edges or its
+// corners
+void CSoftRender::DrawPolygon(const CLIP_VERTEX_STRUCT** v, int count)
+{
+	int i;
+
+	switch (polygon_mode)
+	{
+	case RENDER_FILL:
+		for (i = 1; i + 1 < count; i++) AddTriangle(v[0], v[i], v[i + 1]);
+		break;
+	case RENDER_LINE:
+		for (i = 0; i < count; i++) AddLine(v[i], v[(i + 1) % count]);
+		break;
+	case RENDER_POINT:
+		for (i = 0; i < count; i++) AddLine(v[i], v[i]);
+		break;
+	}
+}
+
+// the primitives made by count corners of the transformed vertices
+void CSoftRender::DrawPrimitives(int primitive, const int* corners, int count)
+{
+	const CLIP_VERTEX_STRUCT* v[4];
+	int i, j, n;
+
+	if (primitive == RENDER_LINES) {
+		for (i = 0; i + 1 < count; i += 2) AddLine(&clip[corners[i]], &clip[corners[i + 1]]);
+		return;
+	}
+
+	n = (primitive == RENDER_QUADS ? 4 : 3);
+
+	for (i = 0; i + n <= count; i += n) {
+		for (j = 0; j < n; j++) v[j] = &clip[corners[i + j]];
+		DrawPolygon(v, n);
+	}
+}
+
+//
+void CSoftRender::Draw(int primitive, int format, const float* vertices, int vertex_count)
+{
+	int corners[SOFT_INDEX_BLOCK];
+	int i, j, n;
+
+	Transform(format, vertices, vertex_count);
+
+	for (i = 0; i < vertex_count; i += n) {
+		n = (vertex_count - i < SOFT_INDEX_BLOCK ? vertex_count - i : SOFT_INDEX_BLOCK);
+		for (j = 0; j < n; j++) corners[j] = i + j;
+		DrawPrimitives(primitive, corners, n);
+	}
+}
+
+//
+void CSoftRender::DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned short* indices, int index_count)
+{
+	int corners[SOFT_INDEX_BLOCK];
+	int i, j, n;
+
+	Transform(format, vertices, vertex_count);
+
+	for (i = 0; i < index_count; i += n) {
+		n = (index_count - i < SOFT_INDEX_BLOCK ? index_count - i : SOFT_INDEX_BLOCK);
+		for (j = 0; j < n; j++) corners[j] = indices[i + j];
+		DrawPrimitives(primitive, corners, n);
+	}
+}
+
+//
+void CSoftRender::DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned int* indices, int index_count)
+{
+	int corners[SOFT_INDEX_BLOCK];
+	int i, j, n;
+
+	Transform(format, vertices, vertex_count);
+
+	for (i = 0; i < index_count; i += n) {
+		n = (index_count - i < SOFT_INDEX_BLOCK ? index_count - i : SOFT_INDEX_BLOCK);
+		for (j = 0; j < n; j++) corners[j] = (int)indices[i + j];
+		DrawPrimitives(primitive, corners, n);
+	}
+}
+
+//
+int CSoftRender::GetWidth()
+{
+	return width;
+}
+
+//
+int CSoftRender::GetHeight()
+{
+	return height;
+}
+
+// the image of the last frame, RGBA, top row first
+const unsigned char* CSoftRender::GetPixels()
+{
+	return pixels;
+}
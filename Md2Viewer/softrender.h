@@ -0,0 +1,167 @@
+/*
+   Class Name:
+
+	  CSoftRender
+
+   Description:
+
+	  draw into an RGBA image in memory with no graphics library, the
+	  primitives are sorted into tiles of the screen and the tiles are
+	  drawn at the same time on many threads
+
+*/
+
+#pragma once
+
+#include "render.h"
+#include "threadpool.h"
+
+// tiles are SOFT_TILE_SIZE x SOFT_TILE_SIZE pixels
+const int SOFT_TILE_SIZE = 64;
+
+// data structure for a vertex after the matrices, before the divide by w
+typedef struct
+{
+	float x, y, z, w;
+	float s, t;
+}CLIP_VERTEX_STRUCT;
+
+// data structure for the state a primitive is drawn with
+typedef struct
+{
+	int texture;            // 0 for none
+	int color[3];           // r, g, b from 0 to 256
+	bool depth_test;
+}SOFT_STATE_STRUCT;
+
+// data structure for a triangle ready to be drawn
+// every plane is a * x + b * y + c at the center of pixel (x, y), y down
+typedef struct
+{
+	float edge[3][3];       // inside where all three are >= 0
+	float z[3];             // depth from 0 to 1
+	float iw[3];            // 1 / w
+	float sw[3], tw[3];     // s / w, t / w
+	int min_x, min_y, max_x, max_y;   // pixels covered, max is not
+	int state;
+}SOFT_TRIANGLE_STRUCT;
+
+// data structure for a line ready to be drawn, a point if both ends are
+// the same
+typedef struct
+{
+	float x[2], y[2];       // ends in pixels, y down
+	float z[2], iw[2], sw[2], tw[2];
+	int state;
+}SOFT_LINE_STRUCT;
+
+// data structure for an RGBA texture
+typedef struct
+{
+	int width, height;
+	unsigned char* pixels;  // NULL if the texture was deleted
+}SOFT_TEXTURE_STRUCT;
+
+// data structure for the primitives that touch a tile, in the order they
+// were drawn, a triangle i is 2 * i and a line i is 2 * i + 1
+typedef struct
+{
+	int count, capacity;
+	int* items;
+}SOFT_BIN_STRUCT;
+
+// data structure for what a triangle is drawn into and with
+typedef struct
+{
+	unsigned char* pixels;
+	float* depth;
+	int width, depth_pitch;
+	const SOFT_STATE_STRUCT* states;
+	const SOFT_TEXTURE_STRUCT* textures;
+}SOFT_TARGET_STRUCT;
+
+// draw the part of a triangle in pixels x0 to x1 - 1, y0 to y1 - 1
+typedef void (*SOFTTRIANGLEPROC)(const SOFT_TARGET_STRUCT* target, const SOFT_TRIANGLE_STRUCT* t, int x0, int y0, int x1, int y1);
+
+class CSoftRender : public CRender
+{
+private:
+	// the image, every row width RGBA pixels
+	// the rows of depth are depth_pitch floats, a little longer than
+	// width so a whole block of pixels can be read at the right edge
+	int width, height, depth_pitch;
+	unsigned char* pixels;
+	float* depth;
+	int pixel_capacity, depth_capacity;
+	float clear_color[4];
+
+	int tile_x, tile_y;
+	SOFT_BIN_STRUCT* bins;
+	int bin_capacity;
+
+	// state set since the last draw, and the states of this frame
+	float matrix[16];               // projection x modelview
+	int polygon_mode;
+	SOFT_STATE_STRUCT current;
+	bool current_used;
+	SOFT_STATE_STRUCT* states;
+	int state_count, state_capacity;
+
+	// the primitives of this frame
+	SOFT_TRIANGLE_STRUCT* triangles;
+	int triangle_count, triangle_capacity;
+	SOFT_LINE_STRUCT* lines;
+	int line_count, line_capacity;
+
+	// the vertices of the last draw after the matrices
+	CLIP_VERTEX_STRUCT* clip;
+	int clip_capacity;
+
+	SOFT_TEXTURE_STRUCT* textures;
+	int texture_count;
+
+	int kind;
+	SOFTTRIANGLEPROC triangle_proc;
+	CThreadPool pool;
+
+	int UseState();
+	void Transform(int format, const float* vertices, int vertex_count);
+	void AddTriangle(const CLIP_VERTEX_STRUCT* a, const CLIP_VERTEX_STRUCT* b, const CLIP_VERTEX_STRUCT* c);
+	void AddLine(const CLIP_VERTEX_STRUCT* a, const CLIP_VERTEX_STRUCT* b);
+	void SetupTriangle(const CLIP_VERTEX_STRUCT* a, const CLIP_VERTEX_STRUCT* b, const CLIP_VERTEX_STRUCT* c);
+	void Bin(int item, int min_x, int min_y, int max_x, int max_y);
+	void DrawPolygon(const CLIP_VERTEX_STRUCT** v, int count);
+	void DrawPrimitives(int primitive, const int* corners, int count);
+	void GetTarget(SOFT_TARGET_STRUCT* target);
+
+	static void DrawTiles(void* param, int first, int last);
+
+public:
+	CSoftRender();
+	~CSoftRender();
+
+	bool Create(int thread_count);
+	int GetThreadCount();
+	bool SetKind(int kind);
+	int GetKind();
+
+	void BeginFrame(int width, int height, const float* color);
+	void EndFrame();
+
+	void SetMatrices(const float* projection, const float* modelview);
+	void SetPolygonMode(int mode);
+	void SetDepthTest(bool enable);
+	void SetColor(float r, float g, float b);
+	void SetTexture(int texture);
+
+	int CreateTexture(int width, int height, int channels, const unsigned char* pixels);
+	void DeleteTexture(int texture);
+
+	void Draw(int primitive, int format, const float* vertices, int vertex_count);
+	void DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned short* indices, int index_count);
+	void DrawIndexed(int primitive, int format, const float* vertices, int vertex_count, const unsigned int* indices, int index_count);
+
+	int GetWidth();
+	int GetHeight();
+	const unsigned char* GetPixels();
+};
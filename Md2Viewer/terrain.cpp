@@ -8,8 +8,9 @@
 	  create horizontal plane
 */
 
-#include "framework.h"
+#include "platform.h"
 #include "terrain.h"
+#include "render.h"
 
 // constructor
 CTerrain::CTerrain()
@@ -116,12 +117,9 @@ void CTerrain::Create(float len, int div)
 }
 
 //
-void CTerrain::Draw()
+void CTerrain::Draw(CRender* render)
 {
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glVertexPointer(coord_per_vertex, GL_FLOAT, stride, (GLvoid*)vertices);
-	glDrawElements(GL_QUADS, index_count, GL_UNSIGNED_INT, (GLvoid*)indices);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	render->DrawIndexed(RENDER_QUADS, RENDER_V3F, vertices, vertex_count, indices, index_count);
 }
 
 //
@@ -10,6 +10,8 @@
 
 #pragma once
 
+class CRender;
+
 class CTerrain
 {
 private:
@@ -22,5 +24,5 @@ public:
 	~CTerrain();
 
 	void Create(float len, int div);
-	void Draw();
+	void Draw(CRender* render);
 };
@@ -0,0 +1,207 @@
+/*
+   Class Name:
+
+	  CTextureCache
+
+   Description:
+
+	  png images found by the path of their file, each one decoded and
+	  made into a texture once however many models use it
+
+*/
+
+#include "platform.h"
+#include "texturecache.h"
+#include "pngfile.h"
+#include "render.h"
+
+// constructor
+CTextureCache::CTextureCache()
+{
+	image_count = 0;
+	image_capacity = 0;
+	table_size = 0;
+	images = NULL;
+	table = NULL;
+}
+
+// destructor
+// the textures are not deleted, the CRender that made them may be gone
+// by now, call Clear before it goes
+CTextureCache::~CTextureCache()
+{
+	Free();
+}
+
+// release the images and the table, not the textures
+void CTextureCache::Free()
+{
+	int i;
+
+	for (i = 0; i < image_count; i++) {
+		delete[] images[i].path;
+		if (images[i].image != NULL) delete images[i].image;
+	}
+
+	if (images != NULL) {
+		delete[] images;
+		images = NULL;
+	}
+
+	if (table != NULL) {
+		delete[] table;
+		table = NULL;
+	}
+
+	image_count = 0;
+	image_capacity = 0;
+	table_size = 0;
+}
+
+// delete the textures and forget every image
+void CTextureCache::Clear(CRender* render)
+{
+	int i;
+
+	for (i = 0; i < image_count; i++)
+		if (images[i].texture != 0) render->DeleteTexture(images[i].texture);
+
+	Free();
+}
+
+//
+static unsigned int GetPathHash(const wchar_t* path)
+{
+	unsigned int h = 2166136261u;
+
+	while (*path != L'\0')
+		h = (h ^ (unsigned int)*path++) * 16777619u;
+
+	return h;
+}
+
+// return the image of a path, or -1 with *slot set to the empty place
+// in the table where it goes, -1 if there is no table yet
+int CTextureCache::Lookup(const wchar_t* path, int* slot)
+{
+	unsigned int h, mask;
+	int k;
+
+	*slot = -1;
+
+	if (table_size == 0) return -1;
+
+	mask = table_size - 1;
+	h = GetPathHash(path) & mask;
+
+	while ((k = table[h]) != -1 && wcscmp(images[k].path, path) != 0)
+		h = (h + 1) & mask;
+
+	*slot = (int)h;
+
+	return k;
+}
+
+// make room for twice as many images, the table stays at most half full
+void CTextureCache::Grow()
+{
+	IMAGE_STRUCT* p;
+	unsigned int h, mask;
+	int i;
+
+	image_capacity = (image_capacity == 0 ? 16 : 2 * image_capacity);
+
+	p = new IMAGE_STRUCT[image_capacity];
+	if (image_count > 0) memcpy(p, images, image_count * sizeof(IMAGE_STRUCT));
+	if (images != NULL) delete[] images;
+	images = p;
+
+	if (table != NULL) delete[] table;
+	table_size = 2 * image_capacity;
+	table = new int[table_size];
+	mask = table_size - 1;
+
+	for (h = 0; h < (unsigned int)table_size; h++) table[h] = -1;
+
+	for (i = 0; i < image_count; i++) {
+		h = GetPathHash(images[i].path) & mask;
+		while (table[h] != -1) h = (h + 1) & mask;
+		table[h] = i;
+	}
+}
+
+// Decode a png file the first time its path is asked for. The same path
+// again returns the same image without reading the file.
+// return the index of the image, or -1 if the file is not a png file
+int CTextureCache::Load(const wchar_t* path)
+{
+	size_t n;
+	int k, slot = -1;
+
+	if ((k = Lookup(path, &slot)) != -1)
+		return (images[k].image != NULL ? k : -1);
+
+	if (image_count == image_capacity) {
+		Grow();
+		Lookup(path, &slot);
+	}
+
+	if (slot < 0) return -1;
+
+	k = image_count++;
+	table[slot] = k;
+
+	n = wcslen(path) + 1;
+	images[k].path = new wchar_t[n];
+	wcscpy_s(images[k].path, n, path);
+
+	images[k].texture = 0;
+	images[k].image = new CPngFile;
+
+	if (!images[k].image->Open(images[k].path)) {
+		delete images[k].image;
+		images[k].image = NULL;
+		return -1;
+	}
+
+	return k;
+}
+
+// return the index of an image already loaded, or -1
+int CTextureCache::Find(const wchar_t* path)
+{
+	int k, slot;
+
+	k = Lookup(path, &slot);
+
+	return (k != -1 && images[k].image != NULL ? k : -1);
+}
+
+// return the number of paths asked for, read or not
+int CTextureCache::GetImageCount()
+{
+	return image_count;
+}
+
+// return the decoded pixels of an image
+const CPngFile* CTextureCache::GetImage(int index)
+{
+	return (index < 0 || index >= image_count ? NULL : images[index].image);
+}
+
+// Return the texture of an image, made by render the first time it is
+// asked for. Every texture of the cache must come from the same render.
+// return 0 for no image
+int CTextureCache::GetTexture(int index, CRender* render)
+{
+	CPngFile* image;
+
+	if (index < 0 || index >= image_count || (image = images[index].image) == NULL) return 0;
+
+	if (images[index].texture == 0) {
+		images[index].texture = render->CreateTexture(image->width, image->height,
+			image->color_type == PNG_COLOR_TYPE_RGB_ALPHA ? 4 : 3, image->buffer);
+	}
+
+	return images[index].texture;
+}
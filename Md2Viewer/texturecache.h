@@ -0,0 +1,52 @@
+/*
+   Class Name:
+
+	  CTextureCache
+
+   Description:
+
+	  png images found by the path of their file, each one decoded and
+	  made into a texture once however many models use it
+
+*/
+
+#pragma once
+
+class CPngFile;
+class CRender;
+
+// data structure for an image in the cache
+typedef struct
+{
+	wchar_t* path;          // the file, as it was asked for
+	CPngFile* image;        // the decoded pixels, NULL if the file is not a png file
+	int texture;            // texture of the CRender, 0 until GetTexture makes it
+}IMAGE_STRUCT;
+
+class CTextureCache
+{
+private:
+	// the images in the order they were asked for, a file that could not
+	// be read is kept too so it is not read again
+	// table is an open addressing hash table of indices into images
+	int image_count, image_capacity, table_size;
+	IMAGE_STRUCT* images;
+	int* table;
+
+	int Lookup(const wchar_t* path, int* slot);
+	void Grow();
+	void Free();
+
+public:
+	CTextureCache();
+	~CTextureCache();
+
+	int Load(const wchar_t* path);
+	int Find(const wchar_t* path);
+
+	int GetImageCount();
+	const CPngFile* GetImage(int index);
+	int GetTexture(int index, CRender* render);
+
+	void Clear(CRender* render);
+};
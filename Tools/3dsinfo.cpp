@@ -0,0 +1,97 @@
+// A 3ds file is a collection of chunks arrange in hierarchical order.
+// This program will open a 3ds file and print the chunk tree,
+// the same tree the 3dsReader shows in its tree view control.
+//
+//   3dsinfo file.3ds
+//
+
+#include "platform.h"
+#include "3dsfile.h"
+
+C3dsFile file;
+
+void PrintChunk(unsigned char* buffer, int depth);
+
+int main(int argc, char* argv[])
+{
+	wchar_t filename[MAX_PATH], str[MAX_PATH];
+	unsigned short id;
+	unsigned int size;
+	unsigned char* buffer;
+
+	if (argc != 2) {
+		fprintf(stderr, "usage: 3dsinfo file.3ds\n");
+		return 1;
+	}
+
+	PlatformUtf8ToWide(argv[1], filename, MAX_PATH);
+
+	if (!file.Open(filename)) {
+		fprintf(stderr, "%s: cannot open file.\n", argv[1]);
+		return 1;
+	}
+
+	// read the main chunk
+	buffer = file.ReadMainChunk(&id, &size);
+	file.GetChunkName(id, str, MAX_PATH);
+
+	printf("%ls %u bytes\n", str, size);
+
+	PrintChunk(buffer, 1);
+
+	return 0;
+}
+
+// Print all sub-chunks of a chunk.
+// C3dsFile only remembers one chunk at a time, so the children are
+// collected first and then expanded one by one.
+void PrintChunk(unsigned char* buffer, int depth)
+{
+	wchar_t str[200];
+	wchar_t* name;
+	unsigned short id;
+	unsigned int size;
+	unsigned char* child;
+	unsigned char** children;
+	int i, n, max;
+
+	file.Reset(buffer, &name);
+
+	// If it has string data, print it with no sub-chunk.
+	if (name != NULL) {
+		printf("%*s\"%ls\"\n", 2 * depth, "", name);
+		delete[] name;
+	}
+
+	n = 0;
+	max = 16;
+	children = new unsigned char* [max];
+
+	while (!file.IsEnd()) {
+
+		if (n == max) {
+			unsigned char** tmp = new unsigned char* [2 * max];
+			memcpy(tmp, children, max * sizeof(unsigned char*));
+			delete[] children;
+			children = tmp;
+			max *= 2;
+		}
+
+		children[n++] = file.Read(&id);
+	}
+
+	for (i = 0; i < n; i++) {
+
+		child = children[i];
+		id = *((unsigned short*)&child[0]);
+		size = *((unsigned int*)&child[sizeof(unsigned short)]);
+
+		file.GetChunkName(id, str, 200);
+		printf("%*s%ls %u bytes\n", 2 * depth, "", str, size);
+
+		if (file.GetSubChunkCount(id) > 0)
+			PrintChunk(child, depth + 1);
+	}
+
+	delete[] children;
+}
@@ -0,0 +1,116 @@
+// 
+//   This program cooks md2 files into .md2c files, which hold the decoded
+//   frames, the welded mesh in the order OptimizeMesh gives it, the strips
+//   and fans, the animations and the faces across every edge, so that
+//   opening them needs no work. It prints how long opening the md2 file
+//   and the cooked file take.
+// 
+//   md2cook [-q] [-r tolerance] file.md2 [file.md2 ...]
+//
+//   -q   keep the compressed frames, the file is smaller but the frames
+//        are decoded when it is opened
+//   -r   drop the frames that blending the frames around them rebuilds
+//        with no vertex moving more than tolerance, see CMd2File::Reduce
+//
+
+#include "platform.h"
+#include "md2file.h"
+
+bool Cook(const char* name, bool quantized, float tolerance);
+double OpenTime(wchar_t* filename);
+
+int main(int argc, char* argv[])
+{
+	bool quantized;
+	float tolerance;
+	int i, result;
+
+	quantized = false;
+	tolerance = -1.0f;
+	result = 0;
+
+	for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+		if (strcmp(argv[i], "-q") == 0) quantized = true;
+		else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) tolerance = (float)atof(argv[++i]);
+		else break;
+	}
+
+	if (i == argc || (quantized && tolerance >= 0.0f)) {
+		fprintf(stderr, "usage: md2cook [-q] [-r tolerance] file.md2 [file.md2 ...]\n");
+		fprintf(stderr, "       -q and -r cannot be used together\n");
+		return 1;
+	}
+
+	for (; i < argc; i++)
+		if (!Cook(argv[i], quantized, tolerance)) result = 1;
+
+	return result;
+}
+
+// write name with the extension changed to .md2c
+// frames are dropped first if tolerance is not negative
+bool Cook(const char* name, bool quantized, float tolerance)
+{
+	CMd2File file;
+	wchar_t filename[MAX_PATH], cooked[MAX_PATH];
+	char out[MAX_PATH];
+	char* p;
+
+	strcpy_s(out, MAX_PATH, name);
+	p = strrchr(out, '.');
+	if (p == NULL || strchr(p, '/') != NULL || strchr(p, '\\') != NULL) p = out + strlen(out);
+	if (p - out + 6 > MAX_PATH) {
+		fprintf(stderr, "%s: name too long.\n", name);
+		return false;
+	}
+	strcpy_s(p, MAX_PATH - (p - out), ".md2c");
+
+	PlatformUtf8ToWide(name, filename, MAX_PATH);
+	PlatformUtf8ToWide(out, cooked, MAX_PATH);
+
+	if (!file.Open(filename)) {
+		fprintf(stderr, "%s: cannot open file: not md2 file.\n", name);
+		return false;
+	}
+
+	if (tolerance >= 0.0f && !file.Reduce(tolerance)) {
+		fprintf(stderr, "%s: cannot reduce frames.\n", name);
+		return false;
+	}
+
+	// draw order for the vertex cache and overdraw
+	file.OptimizeMesh();
+
+	if (!file.Cook(cooked, quantized)) {
+		fprintf(stderr, "%s: cannot write file.\n", out);
+		return false;
+	}
+
+	printf("%s -> %s\n", name, out);
+	if (tolerance >= 0.0f)
+		printf("  frames : %10d -> %10d kept\n", file.GetFrameCount(), file.GetKeyCount());
+	printf("  size : %10lld -> %10lld bytes\n", PlatformGetFileSize(filename), PlatformGetFileSize(cooked));
+	printf("  open : %10.3f -> %10.3f ms\n", 1000.0 * OpenTime(filename), 1000.0 * OpenTime(cooked));
+
+	return true;
+}
+
+// return the average time to open a file
+double OpenTime(wchar_t* filename)
+{
+	CMd2File file;
+	double t0, t;
+	int rounds;
+
+	rounds = 0;
+	t0 = PlatformGetTime();
+
+	do {
+		file.Open(filename);
+		rounds++;
+		t = PlatformGetTime() - t0;
+
+	} while (t < 0.25);
+
+	return t / rounds;
+}
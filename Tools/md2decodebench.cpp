@@ -0,0 +1,246 @@
+// 
+//   This program measures how fast the compressed md2 frames are
+//   expanded into floats, how fast two decoded frames are blended, how
+//   fast the bounds of a frame are found and how fast the faces that face
+//   a light are found, once for every instruction set the cpu has, and
+//   how fast the silhouette of a frame is found.
+// 
+//   md2decodebench file.md2 [seconds]
+//
+
+#include "platform.h"
+#include "md2file.h"
+#include "md2decode.h"
+
+int main(int argc, char* argv[])
+{
+	CMd2File file;
+	wchar_t filename[MAX_PATH];
+	DECODEFRAMEPROC proc;
+	LERPFRAMEPROC lerp1, lerp2;
+	MINMAXPROC minmax;
+	FACINGPROC facing;
+	float min, max;
+	float light[4] = { 100.0f, 200.0f, 300.0f, 1.0f };
+	unsigned char* front, * front_ref;
+	unsigned short* edges;
+	CLIP_STRUCT clip;
+	float* x, * ref, * a, * b;
+	double seconds, t0, t;
+	long long vertices, faces;
+	int i, kind, vc, fc, rounds;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: md2decodebench file.md2 [seconds]\n");
+		return 1;
+	}
+
+	seconds = (argc > 2 ? atof(argv[2]) : 1.0);
+
+	PlatformUtf8ToWide(argv[1], filename, MAX_PATH);
+
+	if (!file.Open(filename)) {
+		fprintf(stderr, "%s: cannot open file: not md2 file.\n", argv[1]);
+		return 1;
+	}
+
+	// a cooked file may have no compressed frames to decode
+	if (file.GetFrame(0) == NULL) {
+		fprintf(stderr, "%s: no compressed frames.\n", argv[1]);
+		return 1;
+	}
+
+	vc = file.GetVertexCount();
+	fc = file.GetFrameCount();
+
+	// x, y, z, nx, ny, nz
+	x = new float[6 * vc];
+	ref = new float[6 * vc];
+
+	printf("%s: %d vertices, %d frames\n", argv[1], vc, fc);
+	printf("decode\n");
+
+	for (kind = DECODE_SCALAR; kind < DECODE_COUNT; kind++) {
+
+		proc = GetDecodeFrameProc(kind);
+
+		if (proc == NULL) {
+			printf("  %-8s not supported\n", GetDecodeFrameName(kind));
+			continue;
+		}
+
+		// check against the scalar decoder on the last frame
+		GetDecodeFrameProc(DECODE_SCALAR)(file.GetFrame(fc - 1), vc, ref, ref + vc, ref + 2 * vc, ref + 3 * vc, ref + 4 * vc, ref + 5 * vc);
+		proc(file.GetFrame(fc - 1), vc, x, x + vc, x + 2 * vc, x + 3 * vc, x + 4 * vc, x + 5 * vc);
+
+		if (memcmp(ref, x, 6 * vc * sizeof(float)) != 0) {
+			printf("  %-8s does not match the scalar decoder\n", GetDecodeFrameName(kind));
+			return 1;
+		}
+
+		// decode all frames again and again until the time is up
+		vertices = 0;
+		rounds = 0;
+		t0 = PlatformGetTime();
+
+		do {
+			for (i = 0; i < fc; i++)
+				proc(file.GetFrame(i), vc, x, x + vc, x + 2 * vc, x + 3 * vc, x + 4 * vc, x + 5 * vc);
+
+			vertices += (long long)vc * fc;
+			rounds++;
+			t = PlatformGetTime() - t0;
+
+		} while (t < seconds);
+
+		printf("  %-8s %10.1f million vertices/second (%d rounds)\n", GetDecodeFrameName(kind), vertices / t / 1e6, rounds);
+	}
+
+	// two poses to blend
+	clip.first = 0;
+	clip.count = fc;
+	clip.fps = MD2_FPS;
+
+	a = new float[file.GetPoseSize()];
+	b = new float[file.GetPoseSize()];
+
+	file.Evaluate(&clip, 0.0, a);
+	file.Evaluate(&clip, 1.0, b);
+
+	printf("blend\n");
+
+	for (kind = DECODE_SCALAR; kind < DECODE_COUNT; kind++) {
+
+		lerp1 = GetLerpFrameProc(kind);
+		lerp2 = GetLerpNormalsProc(kind);
+
+		if (lerp1 == NULL || lerp2 == NULL) {
+			printf("  %-8s not supported\n", GetDecodeFrameName(kind));
+			continue;
+		}
+
+		vertices = 0;
+		rounds = 0;
+		t0 = PlatformGetTime();
+
+		do {
+			for (i = 0; i < fc; i++) {
+				lerp1(a, b, (float)i / fc, 3 * vc, x);
+				lerp2(a + 3 * vc, b + 3 * vc, (float)i / fc, vc, x + 3 * vc);
+			}
+
+			vertices += (long long)vc * fc;
+			rounds++;
+			t = PlatformGetTime() - t0;
+
+		} while (t < seconds);
+
+		printf("  %-8s %10.1f million vertices/second (%d rounds)\n", GetDecodeFrameName(kind), vertices / t / 1e6, rounds);
+	}
+
+	printf("bounds\n");
+
+	for (kind = DECODE_SCALAR; kind < DECODE_COUNT; kind++) {
+
+		minmax = GetMinMaxProc(kind);
+
+		if (minmax == NULL) {
+			printf("  %-8s not supported\n", GetDecodeFrameName(kind));
+			continue;
+		}
+
+		vertices = 0;
+		rounds = 0;
+		t0 = PlatformGetTime();
+
+		do {
+			for (i = 0; i < fc; i++) {
+				minmax(a, vc, &min, &max);
+				minmax(a + vc, vc, &min, &max);
+				minmax(a + 2 * vc, vc, &min, &max);
+			}
+
+			vertices += (long long)vc * fc;
+			rounds++;
+			t = PlatformGetTime() - t0;
+
+		} while (t < seconds);
+
+		printf("  %-8s %10.1f million vertices/second (%d rounds)\n", GetDecodeFrameName(kind), vertices / t / 1e6, rounds);
+	}
+
+	// faces that face a point light, for every pose of the model
+	front = new unsigned char[file.GetFaceCount()];
+	front_ref = new unsigned char[file.GetFaceCount()];
+	edges = new unsigned short[6 * file.GetFaceCount()];
+
+	printf("facing\n");
+
+	for (kind = DECODE_SCALAR; kind < DECODE_COUNT; kind++) {
+
+		facing = GetFaceFacingProc(kind);
+
+		if (facing == NULL) {
+			printf("  %-8s not supported\n", GetDecodeFrameName(kind));
+			continue;
+		}
+
+		// check against the scalar version, the silhouette needs the same faces
+		GetFaceFacingProc(DECODE_SCALAR)(a, a + vc, a + 2 * vc, file.GetCorners(), file.GetFaceCount(), light, front_ref);
+		facing(a, a + vc, a + 2 * vc, file.GetCorners(), file.GetFaceCount(), light, front);
+
+		if (memcmp(front_ref, front, file.GetFaceCount()) != 0) {
+			printf("  %-8s does not match the scalar version\n", GetDecodeFrameName(kind));
+			return 1;
+		}
+
+		faces = 0;
+		rounds = 0;
+		t0 = PlatformGetTime();
+
+		do {
+			for (i = 0; i < fc; i++) {
+				light[0] = (float)i;
+				facing(a, a + vc, a + 2 * vc, file.GetCorners(), file.GetFaceCount(), light, front);
+			}
+
+			faces += (long long)file.GetFaceCount() * fc;
+			rounds++;
+			t = PlatformGetTime() - t0;
+
+		} while (t < seconds);
+
+		printf("  %-8s %10.1f million faces/second (%d rounds)\n", GetDecodeFrameName(kind), faces / t / 1e6, rounds);
+	}
+
+	// the whole silhouette with the fastest code
+	faces = 0;
+	rounds = 0;
+	t0 = PlatformGetTime();
+
+	do {
+		for (i = 0; i < fc; i++) {
+			light[0] = (float)i;
+			file.GetSilhouette(a, light, front, edges);
+		}
+
+		faces += (long long)file.GetFaceCount() * fc;
+		rounds++;
+		t = PlatformGetTime() - t0;
+
+	} while (t < seconds);
+
+	printf("silhouette\n");
+	printf("  %-8s %10.1f million faces/second, %d edges (%d rounds)\n", GetDecodeFrameName(GetDecodeFrameKind()), faces / t / 1e6,
+		file.GetSilhouette(a, light, front, edges), rounds);
+
+	delete[] x;
+	delete[] ref;
+	delete[] front;
+	delete[] front_ref;
+	delete[] edges;
+	delete[] a;
+	delete[] b;
+
+	return 0;
+}
@@ -0,0 +1,141 @@
+//
+//   This program measures the whole frame of the viewer with no window:
+//   the terrain, the axes and an md2 model playing its animation, drawn
+//   at 1280 x 720 through a render that only counts what it is given.
+//   The model is drawn with the strips and fans, then as a list of
+//   triangles with its level of detail, then again with the draws not
+//   sorted by the render queue of the scene. Then the same frame is drawn
+//   into an image by the software render, with every instruction set on
+//   all processors, and with the fastest one on one thread when there is
+//   more than one processor.
+//
+//   md2framebench file.md2 [seconds]
+//
+
+#include "platform.h"
+#include "camera.h"
+#include "scene.h"
+#include "recordrender.h"
+#include "softrender.h"
+#include "md2decode.h"
+#include "texturecache.h"
+
+// draw frames 1/60 second apart until the time is up, after one frame
+// for what the scene makes when it is first drawn
+// return the frames drawn per second
+double Run(CScene* scene, CCamera* camera, CRender* render, double seconds)
+{
+	double t0, dt;
+	int frames;
+
+	scene->Draw(render, camera);
+
+	frames = 0;
+	t0 = PlatformGetTime();
+
+	do {
+		scene->Update(1.0 / 60.0);
+		scene->Draw(render, camera);
+
+		frames++;
+		dt = PlatformGetTime() - t0;
+
+	} while (dt < seconds);
+
+	return frames / dt;
+}
+
+// print what one frame sends to the graphics library, and the state
+// changes the queue of the scene took out
+void RunRecord(const char* name, CScene* scene, CCamera* camera, CRecordRender* render, double seconds)
+{
+	const RENDER_STATS_STRUCT* stats;
+	const QUEUE_STATS_STRUCT* queue;
+	double fps;
+	int frames;
+
+	render->ResetStats();
+	scene->GetQueue()->ResetStats();
+
+	fps = Run(scene, camera, render, seconds);
+	stats = render->GetStats();
+	queue = scene->GetQueue()->GetStats();
+	frames = stats->frames;
+
+	printf("  %-11s: %10.1f frames/second, per frame %d draw calls, %lld vertices, %lld bytes, %d state changes, %d avoided\n",
+		name, fps, stats->draw_calls / frames, stats->vertices / frames, stats->bytes / frames, stats->state_changes / frames,
+		(queue->state_calls - queue->state_changes) / frames);
+}
+
+int main(int argc, char* argv[])
+{
+	CTextureCache cache;
+	CRecordRender render;
+	CSoftRender soft;
+	CScene scene;
+	CCamera camera;
+	wchar_t filename[MAX_PATH];
+	char name[32];
+	double seconds;
+	int kind, threads;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: md2framebench file.md2 [seconds]\n");
+		return 1;
+	}
+
+	seconds = (argc > 2 ? atof(argv[2]) : 1.0);
+
+	PlatformUtf8ToWide(argv[1], filename, MAX_PATH);
+
+	scene.Create(&cache);
+
+	if (!scene.Open(filename)) {
+		fprintf(stderr, "%s: cannot open file: not md2 file.\n", argv[1]);
+		return 1;
+	}
+
+	printf("%s: %d faces, %d frames, skin %s\n", argv[1], scene.GetFile()->GetFaceCount(), scene.GetFile()->GetFrameCount(),
+		scene.IsSkinLoaded() ? "read" : "not read");
+
+	scene.LookAtModel(&camera, 0.0);
+	scene.SetViewport(1280, 720);
+	scene.TogglePlay();
+
+	scene.SetStrips(true);
+	RunRecord("strips", &scene, &camera, &render, seconds);
+
+	scene.SetStrips(false);
+	RunRecord("triangles", &scene, &camera, &render, seconds);
+
+	// the draws in the order the scene makes them
+	scene.SetSorted(false);
+	RunRecord("in order", &scene, &camera, &render, seconds);
+	scene.SetSorted(true);
+
+	// the textures of the cache belong to one render, read the skins
+	// again for the software render
+	cache.Clear(&render);
+	scene.Open(filename);
+	scene.SetStrips(true);
+
+	soft.Create(0);
+	threads = soft.GetThreadCount();
+
+	for (kind = DECODE_SCALAR; kind < DECODE_COUNT; kind++) {
+		if (!soft.SetKind(kind)) continue;
+		sprintf(name, "soft %s", GetDecodeFrameName(kind));
+		printf("  %-11s: %10.1f frames/second, %d thread%s\n", name, Run(&scene, &camera, &soft, seconds), threads, (threads == 1 ? "" : "s"));
+	}
+
+	// on one processor the fastest one was just drawn on one thread
+	if (threads > 1) {
+		soft.Create(1);
+		sprintf(name, "soft %s", GetDecodeFrameName(soft.GetKind()));
+		printf("  %-11s: %10.1f frames/second, 1 thread\n", name, Run(&scene, &camera, &soft, seconds));
+	}
+
+	cache.Clear(&soft);
+
+	return 0;
+}
@@ -0,0 +1,83 @@
+// 
+//   This program will load an md2 file and print what is inside it.
+//   It does not need a window, so it runs on any machine.
+// 
+//   md2info file.md2 [file.md2 ...]
+//
+
+#include "platform.h"
+#include "md2file.h"
+
+bool PrintInfo(const char* name);
+
+int main(int argc, char* argv[])
+{
+	int i, result;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: md2info file.md2 [file.md2 ...]\n");
+		return 1;
+	}
+
+	result = 0;
+
+	for (i = 1; i < argc; i++)
+		if (!PrintInfo(argv[i])) result = 1;
+
+	return result;
+}
+
+// open the file and print the header, the names of the skins
+// and the bounding box and sphere of every frame
+bool PrintInfo(const char* name)
+{
+	CMd2File file;
+	wchar_t filename[MAX_PATH];
+	char texture[100];
+	int i, borders;
+
+	PlatformUtf8ToWide(name, filename, MAX_PATH);
+
+	if (!file.Open(filename)) {
+		fprintf(stderr, "%s: cannot open file: not md2 file.\n", name);
+		return false;
+	}
+
+	// edges with no face across
+	borders = 0;
+	for (i = 0; i < 3 * file.GetFaceCount(); i++)
+		if (file.GetAdjacency()[i] == -1) borders++;
+
+	printf("%s\n", name);
+	printf("  faces    : %d\n", file.GetFaceCount());
+	printf("  vertices : %d (%d in the welded mesh)\n", file.GetVertexCount(), file.GetMeshVertexCount());
+	printf("  commands : %d runs, %d vertices\n", file.GetCommandCount(), file.GetCommandVertexCount());
+	printf("  borders  : %d edges\n", borders);
+	if (file.GetKeyCount() < file.GetFrameCount())
+		printf("  frames   : %d (%d stored)\n", file.GetFrameCount(), file.GetKeyCount());
+	else
+		printf("  frames   : %d\n", file.GetFrameCount());
+	printf("  skins    : %d\n", file.GetSkinCount());
+
+	for (i = 0; i < file.GetSkinCount(); i++) {
+		file.GetSkinName(i, texture, 100);
+		printf("  skin %3d : %s\n", i, texture);
+	}
+
+	printf("  clips    : %d\n", file.GetClipCount());
+
+	for (i = 0; i < file.GetClipCount(); i++) {
+		const CLIP_STRUCT* clip = file.GetClip(i);
+		printf("  clip %-16s frames %3d - %3d\n", clip->name, clip->first, clip->first + clip->count - 1);
+	}
+
+	for (i = 0; i < file.GetFrameCount(); i++) {
+
+		const BOUNDS_STRUCT* b = file.GetFrameBounds(i);
+
+		printf("  frame %3d: (%8.3f %8.3f %8.3f) - (%8.3f %8.3f %8.3f) radius %8.3f\n", i,
+			b->min[0], b->min[1], b->min[2], b->max[0], b->max[1], b->max[2], b->radius);
+	}
+
+	return true;
+}
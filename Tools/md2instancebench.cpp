@@ -0,0 +1,86 @@
+// 
+//   This program measures how many copies of an md2 model can be
+//   animated per millisecond, with 1, 2, 4, ... threads.
+//   Every copy plays a random clip at a random time.
+// 
+//   md2instancebench file.md2 [instances] [threads] [seconds]
+//
+
+#include "platform.h"
+#include "md2file.h"
+#include "threadpool.h"
+
+int main(int argc, char* argv[])
+{
+	CMd2File file;
+	CThreadPool pool;
+	wchar_t filename[MAX_PATH];
+	INSTANCE_STRUCT* instances;
+	float* poses;
+	double seconds, t0, t, base;
+	long long done;
+	int i, count, threads, max_threads, rounds;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: md2instancebench file.md2 [instances] [threads] [seconds]\n");
+		return 1;
+	}
+
+	count = (argc > 2 ? atoi(argv[2]) : 1000);
+	max_threads = (argc > 3 ? atoi(argv[3]) : (int)std::thread::hardware_concurrency());
+	seconds = (argc > 4 ? atof(argv[4]) : 1.0);
+
+	if (count < 1) count = 1;
+	if (max_threads < 1) max_threads = 1;
+
+	PlatformUtf8ToWide(argv[1], filename, MAX_PATH);
+
+	if (!file.Open(filename) || file.GetClipCount() == 0) {
+		fprintf(stderr, "%s: cannot open file: not md2 file.\n", argv[1]);
+		return 1;
+	}
+
+	// random clips at random times, the same for every run
+	srand(1);
+
+	instances = new INSTANCE_STRUCT[count];
+
+	for (i = 0; i < count; i++) {
+		instances[i].clip = file.GetClip(rand() % file.GetClipCount());
+		instances[i].time = (double)rand() / RAND_MAX * 10.0;
+	}
+
+	poses = new float[(size_t)count * file.GetPoseSize()];
+
+	printf("%s: %d instances of %d vertices\n", argv[1], count, file.GetVertexCount());
+
+	base = 0.0;
+
+	for (threads = 1; threads <= max_threads; threads *= 2) {
+
+		pool.Create(threads);
+
+		done = 0;
+		rounds = 0;
+		t0 = PlatformGetTime();
+
+		do {
+			file.Evaluate(instances, count, poses, &pool);
+
+			done += count;
+			rounds++;
+			t = PlatformGetTime() - t0;
+
+		} while (t < seconds);
+
+		t = done / (t * 1000.0);
+		if (threads == 1) base = t;
+
+		printf("  %2d threads %10.1f instances/ms  x%.2f (%d rounds)\n", threads, t, t / base, rounds);
+	}
+
+	delete[] instances;
+	delete[] poses;
+
+	return 0;
+}
@@ -0,0 +1,72 @@
+// 
+//   This program builds the levels of detail of an md2 model and prints
+//   the faces of every level, the mean and the largest distance of the
+//   vertices it moved, and from how far away a level is used when the mean
+//   may cover a number of pixels of a 1280 x 720 window with the 45 degree
+//   field of view of the viewer. The viewer draws nothing farther than
+//   1000.
+// 
+//   md2lod [-p pixels] file.md2 [levels]
+//
+//   -p   pixels the mean error of a level may cover, 1 if not given as in
+//        the viewer
+//
+
+#include "platform.h"
+#include "md2file.h"
+#include "md2lod.h"
+
+int main(int argc, char* argv[])
+{
+	CMd2File file;
+	CMd2Lod lod;
+	wchar_t filename[MAX_PATH];
+	double t0, t;
+	float projection, pixels;
+	int i, levels;
+
+	pixels = 1.0f;
+	i = 1;
+
+	if (argc > 2 && strcmp(argv[1], "-p") == 0) {
+		pixels = (float)atof(argv[2]);
+		i = 3;
+	}
+
+	if (i >= argc || pixels <= 0.0f) {
+		fprintf(stderr, "usage: md2lod [-p pixels] file.md2 [levels]\n");
+		return 1;
+	}
+
+	argv += i - 1;
+	argc -= i - 1;
+
+	levels = (argc > 2 ? atoi(argv[2]) : MD2_LOD_MAX_LEVELS);
+
+	PlatformUtf8ToWide(argv[1], filename, MAX_PATH);
+
+	if (!file.Open(filename)) {
+		fprintf(stderr, "%s: cannot open file: not md2 file.\n", argv[1]);
+		return 1;
+	}
+
+	t0 = PlatformGetTime();
+
+	if (!lod.Create(&file, levels)) {
+		fprintf(stderr, "%s: cannot build levels of detail.\n", argv[1]);
+		return 1;
+	}
+
+	t = PlatformGetTime() - t0;
+
+	projection = (float)(720.0 / (2.0 * tan(22.5 * M_PI / 180.0)));
+
+	printf("%s: %d vertices, %d frames, %.3f seconds, %g pixels\n", argv[1], file.GetVertexCount(), file.GetFrameCount(), t, pixels);
+
+	for (i = 0; i < lod.GetLevelCount(); i++) {
+		printf("  level %d: %5d faces  mean %8.3f  max %8.3f  from %8.1f\n", i, lod.GetIndexCount(i) / 3,
+			lod.GetMeanError(i), lod.GetError(i), lod.GetMeanError(i) * projection / pixels);
+	}
+
+	return 0;
+}
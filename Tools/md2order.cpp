@@ -0,0 +1,102 @@
+// 
+//   This program prints how well the welded mesh of md2 files uses the
+//   post-transform vertex cache, in the order of the file, after
+//   OptimizeVertexCache and after OptimizeOverdraw, for first in first
+//   out caches of 16 and 32 vertices.
+// 
+//   md2order file.md2 [file.md2 ...]
+//
+//   acmr - vertices transformed per triangle, lower is better
+//   atvr - vertices transformed per vertex, 1 is best
+//
+
+#include "platform.h"
+#include "md2file.h"
+#include "md2order.h"
+
+bool PrintOrder(const char* name);
+void PrintStats(const char* name, const unsigned short* indices, int count, int vertex_count, double t);
+
+int main(int argc, char* argv[])
+{
+	int i, result;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: md2order file.md2 [file.md2 ...]\n");
+		return 1;
+	}
+
+	result = 0;
+
+	for (i = 1; i < argc; i++)
+		if (!PrintOrder(argv[i])) result = 1;
+
+	return result;
+}
+
+// open the file and print the cache use of every order
+bool PrintOrder(const char* name)
+{
+	CMd2File file;
+	wchar_t filename[MAX_PATH];
+	unsigned short* indices;
+	float* positions;
+	double t0, t;
+	int n, vc;
+
+	PlatformUtf8ToWide(name, filename, MAX_PATH);
+
+	if (!file.Open(filename)) {
+		fprintf(stderr, "%s: cannot open file: not md2 file.\n", name);
+		return false;
+	}
+
+	n = file.GetMeshIndexCount();
+	vc = file.GetMeshVertexCount();
+
+	indices = new unsigned short[n];
+	positions = new float[3 * vc];
+
+	memcpy(indices, file.GetMeshIndices(), n * sizeof(unsigned short));
+
+	file.SetFrame(0);
+	file.GetMeshVertices(positions);
+
+	printf("%s: %d faces, %d mesh vertices\n", name, n / 3, vc);
+	printf("                 fifo 16         fifo 32\n");
+	printf("                 acmr   atvr     acmr   atvr\n");
+
+	PrintStats("file", indices, n, vc, -1.0);
+
+	t0 = PlatformGetTime();
+	OptimizeVertexCache(indices, n, vc);
+	t = PlatformGetTime() - t0;
+
+	PrintStats("vertex cache", indices, n, vc, t);
+
+	t0 = PlatformGetTime();
+	OptimizeOverdraw(indices, n, positions, vc, OVERDRAW_THRESHOLD);
+	t = PlatformGetTime() - t0;
+
+	PrintStats("overdraw", indices, n, vc, t);
+
+	delete[] indices;
+	delete[] positions;
+
+	return true;
+}
+
+// print one line of the table, with the time the order took
+void PrintStats(const char* name, const unsigned short* indices, int count, int vertex_count, double t)
+{
+	float acmr16, atvr16, acmr32, atvr32;
+
+	GetVertexCacheStats(indices, count, vertex_count, 16, &acmr16, &atvr16);
+	GetVertexCacheStats(indices, count, vertex_count, 32, &acmr32, &atvr32);
+
+	printf("  %-12s  %6.3f %6.3f   %6.3f %6.3f", name, acmr16, atvr16, acmr32, atvr32);
+
+	if (t >= 0.0) printf("   %8.3f ms", 1000.0 * t);
+
+	printf("\n");
+}
@@ -0,0 +1,118 @@
+// 
+//   This program compresses the frames of an md2 model into a mean shape
+//   and a few basis shapes, then prints how many basis shapes were needed,
+//   the largest error, the memory used against the frames in the file and
+//   the decoded frames, and how fast frames are rebuilt with every
+//   instruction set the cpu has. It fails when the tolerance is not met or
+//   the result is not smaller than the frames in the file.
+// 
+//   md2pca file.md2 [tolerance] [max components] [seconds]
+//
+//   tolerance is the largest distance a vertex may move, 1 if not given,
+//   a few steps of the bytes of an md2 frame. max components is 64 if not
+//   given.
+//
+
+#include "platform.h"
+#include "md2file.h"
+#include "md2pca.h"
+#include "md2decode.h"
+
+int main(int argc, char* argv[])
+{
+	CMd2File file;
+	CMd2Pca pca;
+	wchar_t filename[MAX_PATH];
+	RECONSTRUCTPROC proc;
+	float* mean, * c, * out;
+	short* basis;
+	float tolerance;
+	double seconds, t0, t;
+	long long vertices, raw, decoded;
+	int i, kind, vc, fc, n, k, max_components, rounds;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: md2pca file.md2 [tolerance] [max components] [seconds]\n");
+		return 1;
+	}
+
+	tolerance = (argc > 2 ? (float)atof(argv[2]) : 1.0f);
+	max_components = (argc > 3 ? atoi(argv[3]) : MD2_PCA_MAX_COMPONENTS);
+	seconds = (argc > 4 ? atof(argv[4]) : 1.0);
+
+	PlatformUtf8ToWide(argv[1], filename, MAX_PATH);
+
+	if (!file.Open(filename)) {
+		fprintf(stderr, "%s: cannot open file: not md2 file.\n", argv[1]);
+		return 1;
+	}
+
+	t0 = PlatformGetTime();
+
+	if (!pca.Create(&file, tolerance, max_components)) {
+		fprintf(stderr, "%s: cannot compress within %g with %d components into less than the frames in the file.\n", argv[1], tolerance, max_components);
+		return 1;
+	}
+
+	t = PlatformGetTime() - t0;
+
+	vc = file.GetVertexCount();
+	fc = file.GetFrameCount();
+	n = 3 * vc;
+	k = pca.GetComponentCount();
+
+	// a header and 4 bytes a vertex in the file, 6 floats a vertex decoded
+	raw = ((long long)offsetof(FRAME_STRUCT, data) + 4LL * vc) * fc;
+	decoded = 24LL * vc * fc;
+
+	printf("%s: %d vertices, %d frames\n", argv[1], vc, fc);
+	printf("  components : %d (%.1f ms)\n", k, t * 1000.0);
+	printf("  error      : %.4f (tolerance %.4f)\n", pca.GetError(), tolerance);
+	printf("  size       : %lld bytes, %.1f%% of the frames in the file, %.1f%% of the decoded frames\n",
+		pca.GetSize(), 100.0 * pca.GetSize() / raw, 100.0 * pca.GetSize() / decoded);
+
+	// any data will do to measure the speed
+	mean = new float[n];
+	basis = new short[(size_t)(k + 1) * n];
+	c = new float[k + 1];
+	out = new float[n];
+
+	for (i = 0; i < n; i++) mean[i] = (float)i;
+	for (i = 0; i < (k + 1) * n; i++) basis[i] = (short)(i % 7 - 3);
+	for (i = 0; i <= k; i++) c[i] = 1.0f / (i + 1);
+
+	printf("rebuild\n");
+
+	for (kind = DECODE_SCALAR; kind < DECODE_COUNT; kind++) {
+
+		proc = GetReconstructProc(kind);
+
+		if (proc == NULL) {
+			printf("  %-8s not supported\n", GetDecodeFrameName(kind));
+			continue;
+		}
+
+		vertices = 0;
+		rounds = 0;
+		t0 = PlatformGetTime();
+
+		do {
+			for (i = 0; i < fc; i++)
+				proc(mean, basis, c, k, n, out);
+
+			vertices += (long long)vc * fc;
+			rounds++;
+			t = PlatformGetTime() - t0;
+
+		} while (t < seconds);
+
+		printf("  %-8s %10.1f million vertices/second (%d rounds)\n", GetDecodeFrameName(kind), vertices / t / 1e6, rounds);
+	}
+
+	delete[] mean;
+	delete[] basis;
+	delete[] c;
+	delete[] out;
+
+	return 0;
+}
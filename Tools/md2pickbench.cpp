@@ -0,0 +1,234 @@
+//
+//   This program measures how fast the faces of an md2 model are picked
+//   with rays, with the bounding volume hierarchy refitted to every frame.
+//   The rays start around the model and go through random points of its
+//   box. The first rays of every frame are checked against testing every
+//   face.
+//
+//   md2pickbench file.md2 [rays per frame] [seconds]
+//
+
+#include "platform.h"
+#include "md2file.h"
+#include "md2bvh.h"
+
+// the nearest face a ray hits, found by testing every face
+// return the distance along the ray, or max_t if no face is hit
+float CastEveryFace(CMd2File* file, const float* pose, const float* origin, const float* direction, float max_t)
+{
+	const int* corners = file->GetCorners();
+	const float* x, * y, * z;
+	double e1[3], e2[3], p[3], q[3], s[3], det, u, v, t, best;
+	int i, a, b, c, fc, vc;
+
+	fc = file->GetFaceCount();
+	vc = file->GetVertexCount();
+	x = pose;
+	y = x + vc;
+	z = y + vc;
+	best = max_t;
+
+	for (i = 0; i < fc; i++) {
+
+		a = corners[i];
+		b = corners[fc + i];
+		c = corners[2 * fc + i];
+
+		e1[0] = x[b] - x[a];  e1[1] = y[b] - y[a];  e1[2] = z[b] - z[a];
+		e2[0] = x[c] - x[a];  e2[1] = y[c] - y[a];  e2[2] = z[c] - z[a];
+
+		p[0] = direction[1] * e2[2] - direction[2] * e2[1];
+		p[1] = direction[2] * e2[0] - direction[0] * e2[2];
+		p[2] = direction[0] * e2[1] - direction[1] * e2[0];
+
+		det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+		if (det == 0.0) continue;
+
+		s[0] = origin[0] - x[a];
+		s[1] = origin[1] - y[a];
+		s[2] = origin[2] - z[a];
+
+		u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) / det;
+		if (u < 0.0 || u > 1.0) continue;
+
+		q[0] = s[1] * e1[2] - s[2] * e1[1];
+		q[1] = s[2] * e1[0] - s[0] * e1[2];
+		q[2] = s[0] * e1[1] - s[1] * e1[0];
+
+		v = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) / det;
+		if (v < 0.0 || u + v > 1.0) continue;
+
+		t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) / det;
+		if (t >= 0.0 && t < best) best = t;
+	}
+
+	return (float)best;
+}
+
+// a random number from 0 to 1
+float Random()
+{
+	return (float)rand() / RAND_MAX;
+}
+
+int main(int argc, char* argv[])
+{
+	CMd2File file;
+	CMd2Bvh bvh;
+	CLIP_STRUCT clip;
+	HIT_STRUCT hit;
+	wchar_t filename[MAX_PATH];
+	BOUNDS_STRUCT b;
+	float* poses, * rays;
+	float a, e, t, len;
+	double seconds, t0, dt;
+	long long cast, hits;
+	int i, j, k, f, fc, size, count, rounds, wrong;
+
+	if (argc < 2) {
+		fprintf(stderr, "usage: md2pickbench file.md2 [rays per frame] [seconds]\n");
+		return 1;
+	}
+
+	count = (argc > 2 ? atoi(argv[2]) : 1000);
+	seconds = (argc > 3 ? atof(argv[3]) : 1.0);
+
+	if (count < 1) count = 1;
+
+	PlatformUtf8ToWide(argv[1], filename, MAX_PATH);
+
+	if (!file.Open(filename)) {
+		fprintf(stderr, "%s: cannot open file: not md2 file.\n", argv[1]);
+		return 1;
+	}
+
+	t0 = PlatformGetTime();
+
+	if (!bvh.Create(&file)) {
+		fprintf(stderr, "%s: no faces.\n", argv[1]);
+		return 1;
+	}
+
+	dt = PlatformGetTime() - t0;
+
+	fc = file.GetFrameCount();
+	size = file.GetPoseSize();
+
+	printf("%s: %d faces, %d frames\n", argv[1], file.GetFaceCount(), fc);
+	printf("  build    : %d nodes in %.3f ms\n", bvh.GetNodeCount(), dt * 1000.0);
+
+	// every frame as a pose
+	clip.first = 0;
+	clip.count = fc;
+	clip.fps = MD2_FPS;
+
+	poses = new float[(size_t)size * fc];
+
+	for (f = 0; f < fc; f++) file.Evaluate(&clip, f / MD2_FPS, &poses[(size_t)size * f]);
+
+	// origin and direction of every ray of every frame, the same for every run
+	srand(1);
+	rays = new float[(size_t)6 * count * fc];
+
+	for (f = 0; f < fc; f++) {
+
+		file.GetBounds(&clip, f / MD2_FPS, &b);
+
+		for (i = 0; i < count; i++) {
+
+			float* r = &rays[6 * ((size_t)count * f + i)];
+
+			// from a point on a sphere twice as large as the model
+			a = 2.0f * (float)M_PI * Random();
+			e = 2.0f * Random() - 1.0f;
+			len = sqrtf(1.0f - e * e);
+
+			r[0] = b.center[0] + 2.0f * b.radius * len * cosf(a);
+			r[1] = b.center[1] + 2.0f * b.radius * e;
+			r[2] = b.center[2] + 2.0f * b.radius * len * sinf(a);
+
+			for (k = 0; k < 3; k++) r[3 + k] = b.min[k] + (b.max[k] - b.min[k]) * Random() - r[k];
+		}
+	}
+
+	// check the first rays of every frame
+	wrong = 0;
+
+	for (f = 0; f < fc; f++) {
+
+		bvh.Refit(&poses[(size_t)size * f]);
+
+		for (i = 0; i < count && i < 100; i++) {
+
+			const float* r = &rays[6 * ((size_t)count * f + i)];
+
+			t = CastEveryFace(&file, &poses[(size_t)size * f], r, r + 3, 2.0f);
+			bvh.Intersect(r, r + 3, 2.0f, &hit);
+
+			if (fabsf(t - hit.t) > 1e-4f * (t + 1.0f)) wrong++;
+		}
+	}
+
+	if (wrong > 0) {
+		printf("  %d rays do not match testing every face\n", wrong);
+		return 1;
+	}
+
+	// refit to every frame again and again until the time is up
+	rounds = 0;
+	t0 = PlatformGetTime();
+
+	do {
+		for (f = 0; f < fc; f++) bvh.Refit(&poses[(size_t)size * f]);
+
+		rounds++;
+		dt = PlatformGetTime() - t0;
+
+	} while (dt < seconds);
+
+	printf("  refit    : %10.1f frames/millisecond (%d rounds)\n", (double)rounds * fc / dt / 1000.0, rounds);
+
+	// refit and cast the rays of every frame
+	cast = 0;
+	hits = 0;
+	rounds = 0;
+	t0 = PlatformGetTime();
+
+	do {
+		for (f = 0; f < fc; f++) {
+
+			bvh.Refit(&poses[(size_t)size * f]);
+
+			for (i = 0, j = 6 * count * f; i < count; i++, j += 6)
+				if (bvh.Intersect(&rays[j], &rays[j + 3], 2.0f, &hit)) hits++;
+		}
+
+		cast += (long long)count * fc;
+		rounds++;
+		dt = PlatformGetTime() - t0;
+
+	} while (dt < seconds);
+
+	printf("  pick     : %10.3f million rays/second, %.1f%% hit (%d rounds)\n", cast / dt / 1e6, 100.0 * hits / cast, rounds);
+
+	// testing every face, for comparison
+	cast = 0;
+	t0 = PlatformGetTime();
+
+	do {
+		for (f = 0; f < fc; f++)
+			for (i = 0, j = 6 * count * f; i < count; i++, j += 6)
+				CastEveryFace(&file, &poses[(size_t)size * f], &rays[j], &rays[j + 3], 2.0f);
+
+		cast += (long long)count * fc;
+		dt = PlatformGetTime() - t0;
+
+	} while (dt < seconds);
+
+	printf("  all faces: %10.3f million rays/second\n", cast / dt / 1e6);
+
+	delete[] poses;
+	delete[] rays;
+
+	return 0;
+}
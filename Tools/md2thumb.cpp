@@ -0,0 +1,184 @@
+//
+//   This program draws pictures of md2 files with no window, for the
+//   previews of a library of models. Every model is drawn with its skin
+//   from a number of angles around it by the software render, and each
+//   picture is written into a png file named after the model:
+//   name_0.png, name_1.png and so on. The files are drawn at the same time
+//   on a few threads, each one with its own scene and render.
+//
+//   md2thumb [-n angles] [-s size] [-f frame] [-j threads] [-o folder] file.md2 [file.md2 ...]
+//
+//   -n   pictures of a model, the angles are spread around it, 8 if not given
+//   -s   width and height of the pictures in pixels, 256 if not given
+//   -f   frame of the animation, 0 if not given
+//   -j   threads, one for each processor if not given
+//   -o   folder the png files are written into, the folder of each model
+//        if not given
+//
+
+#include "platform.h"
+#include "camera.h"
+#include "scene.h"
+#include "softrender.h"
+#include "pngfile.h"
+#include "texturecache.h"
+#include "threadpool.h"
+
+// data structure for the files and what to draw of them
+typedef struct
+{
+	char** names;
+	int angles, size, frame;
+	const char* folder;
+
+	std::atomic<int> models;    // files drawn and written
+	std::atomic<int> images;
+}THUMB_STRUCT;
+
+bool Thumb(THUMB_STRUCT* job, const char* name);
+void ThumbBlock(void* param, int first, int last);
+
+int main(int argc, char* argv[])
+{
+	THUMB_STRUCT job;
+	CThreadPool pool;
+	double t0, dt;
+	int i, threads, count;
+
+	job.angles = 8;
+	job.size = 256;
+	job.frame = 0;
+	job.folder = NULL;
+	job.models = 0;
+	job.images = 0;
+	threads = 0;
+
+	for (i = 1; i + 1 < argc && argv[i][0] == '-'; i++) {
+		if (strcmp(argv[i], "-n") == 0) job.angles = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-s") == 0) job.size = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-f") == 0) job.frame = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-j") == 0) threads = atoi(argv[++i]);
+		else if (strcmp(argv[i], "-o") == 0) job.folder = argv[++i];
+		else break;
+	}
+
+	if (i == argc || argv[i][0] == '-' || job.angles < 1 || job.size < 1 || job.frame < 0 || threads < 0) {
+		fprintf(stderr, "usage: md2thumb [-n angles] [-s size] [-f frame] [-j threads] [-o folder] file.md2 [file.md2 ...]\n");
+		return 1;
+	}
+
+	job.names = argv + i;
+	count = argc - i;
+
+	if (!pool.Create(threads)) {
+		fprintf(stderr, "cannot start threads.\n");
+		return 1;
+	}
+
+	// one file at a time to each thread, the files are not the same size
+	t0 = PlatformGetTime();
+	pool.ParallelFor(count, 1, ThumbBlock, &job);
+	dt = PlatformGetTime() - t0;
+
+	printf("%d of %d models, %d images in %.2f seconds on %d threads, %.1f models/second\n",
+		(int)job.models, count, (int)job.images, dt, pool.GetThreadCount(), job.models / (dt > 0.0 ? dt : 1.0));
+
+	return (job.models == count ? 0 : 1);
+}
+
+// draw the files first to last - 1
+void ThumbBlock(void* param, int first, int last)
+{
+	THUMB_STRUCT* job = (THUMB_STRUCT*)param;
+	int i;
+
+	for (i = first; i < last; i++)
+		if (Thumb(job, job->names[i])) job->models++;
+}
+
+// draw one file from every angle and write the png files
+bool Thumb(THUMB_STRUCT* job, const char* name)
+{
+	CTextureCache cache;
+	CSoftRender render;
+	CScene scene;
+	CCamera camera;
+	CPngFile png;
+	wchar_t filename[MAX_PATH], out[MAX_PATH];
+	char base[MAX_PATH], path[MAX_PATH];
+	const char* p;
+	char* q;
+	int i, n;
+	bool result;
+
+	PlatformUtf8ToWide(name, filename, MAX_PATH);
+
+	// the threads of the pool are drawing the other files already
+	render.Create(1);
+	scene.Create(&cache);
+	scene.SetGround(false);
+
+	if (!scene.Open(filename)) {
+		fprintf(stderr, "%s: cannot open file: not md2 file.\n", name);
+		return false;
+	}
+
+	if (!scene.IsSkinLoaded())
+		fprintf(stderr, "%s: skin not read, drawn in white.\n", name);
+
+	if (job->frame >= scene.GetFile()->GetFrameCount()) {
+		fprintf(stderr, "%s: no frame %d.\n", name, job->frame);
+		return false;
+	}
+
+	// name of the model with no folder and no extension
+	p = name;
+	for (i = 0; name[i] != '\0'; i++)
+		if (name[i] == '/' || name[i] == '\\') p = name + i + 1;
+
+	strcpy_s(base, MAX_PATH, p);
+	q = strrchr(base, '.');
+	if (q != NULL) *q = '\0';
+
+	scene.SetFrame(job->frame);
+	scene.SetViewport(job->size, job->size);
+
+	png.width = job->size;
+	png.height = job->size;
+	png.color_type = PNG_COLOR_TYPE_RGB_ALPHA;
+	png.buffer = new png_byte[job->size * job->size * 4];
+
+	result = true;
+
+	for (i = 0; i < job->angles; i++) {
+		scene.LookAtModel(&camera, 360.0 * i / job->angles);
+		scene.Draw(&render, &camera);
+
+		memcpy(png.buffer, render.GetPixels(), job->size * job->size * 4);
+
+		if (job->folder != NULL)
+			n = snprintf(path, MAX_PATH, "%s/%s_%d.png", job->folder, base, i);
+		else
+			n = snprintf(path, MAX_PATH, "%.*s%s_%d.png", (int)(p - name), name, base, i);
+
+		if (n < 0 || n >= MAX_PATH) {
+			fprintf(stderr, "%s: name too long.\n", name);
+			result = false;
+			break;
+		}
+
+		PlatformUtf8ToWide(path, out, MAX_PATH);
+
+		if (!png.Save(out)) {
+			fprintf(stderr, "%s: cannot write file.\n", path);
+			result = false;
+			break;
+		}
+
+		job->images++;
+	}
+
+	cache.Clear(&render);
+
+	return result;
+}